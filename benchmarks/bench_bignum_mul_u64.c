@@ -10,20 +10,32 @@
  *   больших числах многократно, чтобы perf успел
  *   собрать достаточное число сэмплов.
  *
- *   Для чистоты измерений все случайные данные (числа и сдвиги)
- *   генерируются заранее и помещаются в массив. Основной цикл,
- *   который профилируется, выполняет только копирование структуры
- *   и вызов целевой функции, исключая медленный вызов rand().
+ *   Для чистоты измерений все случайные данные (числа и множители)
+ *   генерируются заранее и помещаются в массив. Режимы:
+ *   - `--throughput` (по умолчанию): независимые вызовы над заранее
+ *     выделенными массивами res и a, без копирования структур;
+ *   - `--latency`: зависимая цепочка x = x * b "на месте".
+ *
+ *   Вокруг измеряемого цикла читаются аппаратные счетчики (такты,
+ *   инструкции, промахи переходов и кэша) через perf_event_open; в конце
+ *   печатаются IPC и инструкции на слово. Без счетчиков — такты TSC.
  *
  * @history
  *   - rev 1.0 (12.08.2025): Первоначальная версия.
  *   - rev 1.1 (13.08.2025): Реализована предварительная генерация данных.
  *   - rev 1.2 (13.08.2025): Добавлены локальные определения констант
  *                           BIGNUM_CAPACITY и BIGNUM_BITS для компиляции.
+ *   - rev 1.3 (14.10.2026): Локальное определение BIGNUM_CAPACITY удалено:
+ *                           емкость задается при сборке.
+ *   - rev 1.4 (14.10.2026): Множители — полные 64-битные слова вместо
+ *                           сдвигов rand() % MAX_SHIFT (< 2^11).
+ *   - rev 1.5 (14.10.2026): Копирование bignum_t из цикла убрано; режимы
+ *                           --throughput (по умолчанию) и --latency.
+ *   - rev 1.6 (14.10.2026): Отчет по аппаратным счетчикам (perf_event_open).
  *
  * # Сборка
  *  gcc -g -O2 -I include -no-pie -fno-omit-frame-pointer \
- *    benchmarks/bench_bignum_mul_u64.c build/bignum_mul_u64.o \
+ *    benchmarks/bench_bignum_mul_u64.c benchmarks/bench_bignum_mul_u64_counters.c build/bignum_mul_u64.o \
  *    -o bin/bench_bignum_mul_u64
  *
  * # Запуск perf с записью стека через frame-pointer
@@ -40,21 +52,22 @@
 #include <string.h>
 #include <bignum.h>
 #include "bignum_mul_u64.h"
+#include "bench_bignum_mul_u64_counters.h"
 
-// --- Локальные определения для компиляции ---
-// Эти константы должны быть синхронизированы с ассемблерным кодом.
-#define BIGNUM_CAPACITY 32
-#define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+// BIGNUM_CAPACITY берется из bignum.h (или из -DBIGNUM_CAPACITY при сборке
+// с CAPACITY=N) и должна совпадать с емкостью, с которой собран объектник.
+#ifndef BIGNUM_BITS
+#  define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+#endif
 
 // Увеличиваем количество итераций для более надежных измерений
-#define ITERATIONS (100000000u * 20)
+#ifndef ITERATIONS
+#  define ITERATIONS (100000000u * 20)
+#endif
 
 // Количество предварительно сгенерированных наборов данных
 #define PREGEN_DATA_COUNT 8192
 
-// Максимальный сдвиг
-#define MAX_SHIFT (BIGNUM_BITS - 1)
-
 /** Заполняет bignum случайными словами и устанавливает len. */
 static void init_random_bignum(bignum_t *num) {
     int used = (rand() % BIGNUM_CAPACITY) + 1;
@@ -67,53 +80,95 @@ static void init_random_bignum(bignum_t *num) {
     }
 }
 
-int main(void) {
+int main(int argc, char **argv) {
+    int latency = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--latency") == 0) {
+            latency = 1;
+        } else if (strcmp(argv[i], "--throughput") == 0) {
+            latency = 0;
+        } else {
+            fprintf(stderr, "Usage: %s [--throughput | --latency]\n", argv[0]);
+            return 1;
+        }
+    }
+
     // --- Фаза 1: Предварительная генерация данных ---
     printf("Pregenerating %u data sets...\n", PREGEN_DATA_COUNT);
 
-    
     bignum_t* a = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    bignum_t* res = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
     uint64_t* b = malloc(sizeof(uint64_t) * PREGEN_DATA_COUNT);
 
-    if (!a || !b ) {
+    if (!a || !res || !b) {
         perror("Failed to allocate memory for test data");
+        free(a);
+        free(res);
+        free(b);
         return 1;
     }
-    
-    
+
     srand((unsigned)time(NULL));
     for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
         init_random_bignum(&a[i]);
-        b[i] = (uint64_t)(rand() % MAX_SHIFT);
+        b[i] = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
     }
+    memset(res, 0, sizeof(bignum_t) * PREGEN_DATA_COUNT);
 
     // --- Фаза 2: "Горячий" цикл для профилирования ---
-    printf("Starting benchmark with %u iterations...\n", ITERATIONS);
-
-    for (uint32_t i = 0; i < ITERATIONS; ++i) {
-        // Используем предварительно сгенерированные данные, циклически обращаясь к ним
-        unsigned data_idx = i % PREGEN_DATA_COUNT;
-        
-        // Копируем исходное число, чтобы не портить эталон
-        bignum_t res_dst = {0};
-        bignum_t a_dst = a[data_idx];
-        uint64_t b_dst = b[data_idx];
-
-        // Вызываем целевую функцию
-        bignum_mul_u64(&res_dst, &a_dst, b_dst);
-        
-        // Эта проверка не дает компилятору выбросить вызов функции
-        if (a_dst.len == 0xDEADBEEF) {
-            // Никогда не выполнится
-            printf("Error marker hit.\n");
-            return 1;
+    printf("Starting %s benchmark with %u iterations...\n", latency ? "latency" : "throughput", ITERATIONS);
+
+    bench_counters_t counters;
+    bench_counts_t counts;
+    bench_counters_open(&counters);
+
+    volatile int sink = 0;
+    bench_counters_start(&counters);
+    if (latency) {
+        // Зависимая цепочка x = x * b "на месте". Длина возвращается к
+        // исходной, единица в младшем слове не дает x обнулиться; раз в
+        // PREGEN_DATA_COUNT вызовов x берется из следующего числа пула
+        bignum_t x;
+        size_t len = 0;
+        for (uint32_t i = 0; i < ITERATIONS; ++i) {
+            unsigned data_idx = i % PREGEN_DATA_COUNT;
+            if (data_idx == 0) {
+                x = a[(i / PREGEN_DATA_COUNT) % PREGEN_DATA_COUNT];
+                len = x.len;
+            }
+            sink += bignum_mul_u64(&x, &x, b[data_idx]);
+            x.len = len;
+            x.words[0] |= 1;
+        }
+    } else {
+        // Независимые вызовы по заранее выделенным массивам, без копирования
+        for (uint32_t i = 0; i < ITERATIONS; ++i) {
+            unsigned data_idx = i % PREGEN_DATA_COUNT;
+            sink += bignum_mul_u64(&res[data_idx], &a[data_idx], b[data_idx]);
+        }
+    }
+    bench_counters_stop(&counters, &counts);
+    bench_counters_close(&counters);
+    (void)sink;
+
+    // Слова множимого по всем вызовам; считаются вне измеряемого цикла
+    double limbs = 0;
+    for (uint32_t i = 0; i < ITERATIONS; i += PREGEN_DATA_COUNT) {
+        uint32_t calls = ITERATIONS - i < PREGEN_DATA_COUNT ? ITERATIONS - i : PREGEN_DATA_COUNT;
+        if (latency) {
+            limbs += (double)a[(i / PREGEN_DATA_COUNT) % PREGEN_DATA_COUNT].len * calls;
+        } else {
+            for (uint32_t k = 0; k < calls; ++k) limbs += (double)a[k].len;
         }
     }
 
     printf("Benchmark finished.\n");
+    bench_counters_report(stdout, latency ? "bignum_mul_u64 latency" : "bignum_mul_u64 throughput", &counts,
+                          (double)ITERATIONS, limbs);
 
     // --- Фаза 3: Очистка ---
     free(a);
+    free(res);
     free(b);
 
     return 0;
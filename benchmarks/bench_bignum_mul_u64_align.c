@@ -0,0 +1,157 @@
+/**
+ * @file    bench_bignum_mul_u64_align.c
+ * @brief   Микробенчмарк bignum_mul_u64 на массиве bignum_t и на слотах bignum_pool_t.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для числа записей от L1 до памяти и нескольких длин измеряет время
+ *   вызова res[i] = a[i] * b по всем i, в наносекундах на вызов (лучший из
+ *   PASSES проходов), в трех раскладках:
+ *     - `array`  — массив bignum_t из malloc, как в остальных бенчмарках:
+ *                  шаг sizeof(bignum_t), числа начинаются с разных смещений
+ *                  в строке кэша;
+ *     - `pool`   — слоты bignum_pool_t, выровненные на 64 байта;
+ *     - `padded` — то же с BIGNUM_POOL_PADDED (шаг кратен 128).
+ *   Множитель — полное слово (проход умножения) или 1 (путь копирования).
+ *   Строк кэша на число: столько занимает одна запись в каждой раскладке.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 -I include -no-pie \
+ *    benchmarks/bench_bignum_mul_u64_align.c build/bignum_mul_u64.o \
+ *    -o bin/bench_bignum_mul_u64_align
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+
+// Проходов по массиву на одну точку; берется лучший
+#ifndef PASSES
+#  define PASSES 7u
+#endif
+// Вызовов на точку (не меньше одного прохода)
+#ifndef CALLS
+#  define CALLS 4000000u
+#endif
+
+#define LAYOUT_COUNT 3
+#define LINE 64
+
+static const size_t records[] = {64, 2048, 65536};
+// BIGNUM_CAPACITY - 1: слово переноса занимает последнее слово res
+static const size_t lengths[] = {4, 16, BIGNUM_CAPACITY - 1};
+static const char *const layout_names[LAYOUT_COUNT] = {"array", "pool", "padded"};
+
+#define RECORD_COUNT (sizeof(records) / sizeof(records[0]))
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t rand64(void) {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+/** Строк кэша, которые задевают слова [0, len) и поле len числа x. */
+static double lines_touched(bignum_t *const *x, size_t n, size_t len) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uintptr_t p = (uintptr_t)x[i];
+        uintptr_t words_end = p + len * sizeof(uint64_t) - 1;
+        uintptr_t len_at = (uintptr_t)&x[i]->len;
+        total += words_end / LINE - p / LINE + 1;
+        if (len_at / LINE != words_end / LINE) total += 1;
+    }
+    return (double)total / (double)n;
+}
+
+/** Время вызова в нс: проходы по записям в порядке индекса. */
+static double run(bignum_t *const *res, bignum_t *const *a, size_t n, uint64_t b) {
+    size_t passes = CALLS / n > 0 ? CALLS / n : 1;
+    double best = 1e30;
+    volatile int sink = 0;
+    for (unsigned p = 0; p < PASSES; ++p) {
+        double t0 = now_ns();
+        for (size_t r = 0; r < passes; ++r) {
+            for (size_t i = 0; i < n; ++i) sink += bignum_mul_u64(res[i], a[i], b);
+        }
+        double t = (now_ns() - t0) / (double)(passes * n);
+        if (t < best) best = t;
+    }
+    (void)sink;
+    return best;
+}
+
+int main(void) {
+    srand(12345);
+    printf("%-7s | %5s | %-6s | %10s | %10s | %10s\n", "records", "limbs", "layout", "lines/num", "mul ns", "copy ns");
+
+    for (size_t r = 0; r < RECORD_COUNT; ++r) {
+        size_t n = records[r];
+        bignum_t *array_a = malloc(sizeof(bignum_t) * n);
+        bignum_t *array_res = malloc(sizeof(bignum_t) * n);
+        bignum_t **ptr_a = malloc(sizeof(bignum_t *) * n * LAYOUT_COUNT);
+        bignum_t **ptr_res = malloc(sizeof(bignum_t *) * n * LAYOUT_COUNT);
+        bignum_pool_t pools[LAYOUT_COUNT - 1][2];   // [раскладка][a, res]
+        if (array_a == NULL || array_res == NULL || ptr_a == NULL || ptr_res == NULL) return 1;
+        memset(array_a, 0, sizeof(bignum_t) * n);
+        memset(array_res, 0, sizeof(bignum_t) * n);
+        for (size_t l = 1; l < LAYOUT_COUNT; ++l) {
+            for (size_t k = 0; k < 2; ++k) {
+                if (bignum_pool_init(&pools[l - 1][k], n, l == 2 ? BIGNUM_POOL_PADDED : 0) != BIGNUM_MUL_U64_SUCCESS) {
+                    return 1;
+                }
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            ptr_a[i] = &array_a[i];
+            ptr_res[i] = &array_res[i];
+            for (size_t l = 1; l < LAYOUT_COUNT; ++l) {
+                // Множимые и результаты — в своих пулах, как два массива
+                ptr_a[l * n + i] = bignum_pool_alloc(&pools[l - 1][0]);
+                ptr_res[l * n + i] = bignum_pool_alloc(&pools[l - 1][1]);
+            }
+        }
+
+        for (size_t q = 0; q < LENGTH_COUNT; ++q) {
+            size_t len = lengths[q];
+            if (len == 0 || len >= BIGNUM_CAPACITY || (q > 0 && len <= lengths[q - 1])) continue;
+            for (size_t l = 0; l < LAYOUT_COUNT; ++l) {
+                bignum_t **a = ptr_a + l * n, **res = ptr_res + l * n;
+                for (size_t i = 0; i < n; ++i) {
+                    for (size_t k = 0; k < len; ++k) a[i]->words[k] = rand64();
+                    a[i]->words[len - 1] |= 1;
+                    a[i]->len = len;
+                }
+                double mul = run(res, a, n, 0x9E3779B97F4A7C15ULL >> 1);
+                double copy = run(res, a, n, 1);
+                printf("%-7zu | %5zu | %-6s | %10.2f | %10.2f | %10.2f\n", n, len, layout_names[l],
+                       lines_touched(a, n, len), mul, copy);
+            }
+        }
+
+        for (size_t l = 1; l < LAYOUT_COUNT; ++l) {
+            bignum_pool_destroy(&pools[l - 1][0]);
+            bignum_pool_destroy(&pools[l - 1][1]);
+        }
+        free(ptr_a);
+        free(ptr_res);
+        free(array_a);
+        free(array_res);
+    }
+    return 0;
+}
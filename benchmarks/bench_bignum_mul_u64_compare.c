@@ -0,0 +1,477 @@
+/**
+ * @file    bench_bignum_mul_u64_compare.c
+ * @brief   Сравнение двух наборов замеров развертки (make bench-compare).
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Читает два файла хранилища, записанных `bench_bignum_mul_u64_sweep
+ *   --record` (make bench-record): строка на случай (режим, ядро, длина,
+ *   класс множителя) и прогон. Прогон — отдельный процесс, поэтому медианы
+ *   разных прогонов — повторы, и разброс между ними включает раскладку
+ *   памяти и посторонние нагрузки. Сравниваются такты ядра на слово
+ *   (`core_cycles_per_limb`, не зависят от частоты); `--metric=tsc` — такты
+ *   TSC (`cycles_per_limb`).
+ *
+ *   Случай: изменение — отношение геометрических средних NEW / BASE по
+ *   прогонам, интервал — t-интервал разности средних логарифмов. Без
+ *   `--paired` прогоны BASE и NEW независимы (интервал Уэлча со степенями
+ *   свободы Уэлча — Саттертуэйта). С `--paired` прогон r в обоих файлах
+ *   снят подряд (make bench-compare чередует запуски BASE и NEW), и
+ *   интервал строится по разностям внутри пар: медленные периоды машины
+ *   задевают обе половины пары и сокращаются.
+ *
+ *   Случаев сотни, и при 95% на каждый одинаковые сборки давали бы ложные
+ *   замедления в процентах случаев: уровень поправлен по Бонферрони на
+ *   число случаев, так что 95% (`--confidence=C`) — вероятность не
+ *   пометить зря ни одного случая.
+ *
+ *   Пара режим/ядро: в каждом прогоне — среднее логарифмов по всем ее
+ *   случаям (геометрическое среднее), и тот же тест по этим средним с
+ *   поправкой на число пар. Усреднение по длинам и множителям убирает
+ *   большую часть шума, поэтому здесь видно общее изменение, которое по
+ *   отдельным случаям не различить.
+ *
+ *   Помечается замедление, если интервал целиком выше нуля, а оценка
+ *   больше порога (`--threshold=P`, в процентах); ускорение — симметрично.
+ *   Печатаются помеченные случаи (`--all` — все), затем итог по парам.
+ *
+ *   Код возврата: 0 — замедлений нет, 1 — есть, 2 — ошибка входных данных
+ *   (нет файла, меньше двух прогонов, разные емкости). Разные модели
+ *   процессора — предупреждение: такты с разных машин не сравнимы.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 benchmarks/bench_bignum_mul_u64_compare.c -lm \
+ *    -o bin/bench_bignum_mul_u64_compare
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef DEFAULT_THRESHOLD
+#  define DEFAULT_THRESHOLD 2.0
+#endif
+#ifndef DEFAULT_CONFIDENCE
+#  define DEFAULT_CONFIDENCE 95.0
+#endif
+// Прогонов в файле не больше
+#define MAX_RUNS 64
+#define MAX_GROUPS 32
+
+/** Один случай развертки: логарифм тактов на слово по номерам прогонов. */
+typedef struct {
+    char mode[16];
+    char kernel[32];
+    char multiplier[16];
+    size_t len;
+    unsigned n;
+    double v[MAX_RUNS];
+    unsigned char have[MAX_RUNS];
+} bench_case_t;
+
+typedef struct {
+    const char *path;
+    char cpu[128];
+    int capacity;
+    unsigned runs;          // Наибольший номер прогона
+    bench_case_t *cases;
+    size_t count;
+    size_t cap;
+} bench_set_t;
+
+static bench_case_t *find_case(bench_set_t *set, const char *mode, const char *kernel, size_t len,
+                               const char *multiplier) {
+    for (size_t i = 0; i < set->count; ++i) {
+        bench_case_t *c = &set->cases[i];
+        if (c->len == len && strcmp(c->mode, mode) == 0 && strcmp(c->kernel, kernel) == 0 &&
+            strcmp(c->multiplier, multiplier) == 0) {
+            return c;
+        }
+    }
+    return NULL;
+}
+
+static bench_case_t *add_case(bench_set_t *set) {
+    if (set->count == set->cap) {
+        size_t cap = set->cap ? set->cap * 2 : 256;
+        bench_case_t *p = realloc(set->cases, cap * sizeof(*p));
+        if (p == NULL) return NULL;
+        set->cases = p;
+        set->cap = cap;
+    }
+    bench_case_t *c = &set->cases[set->count++];
+    memset(c, 0, sizeof(*c));
+    return c;
+}
+
+/** Значение заголовка `# key: value` или NULL. */
+static const char *header_value(const char *line, const char *key) {
+    size_t n = strlen(key);
+    if (strncmp(line, "# ", 2) != 0 || strncmp(line + 2, key, n) != 0 || strncmp(line + 2 + n, ": ", 2) != 0) {
+        return NULL;
+    }
+    return line + n + 4;
+}
+
+/** Читает файл; tsc — сравнивать такты TSC, а не такты ядра. */
+static int load_set(bench_set_t *set, const char *path, int tsc) {
+    memset(set, 0, sizeof(*set));
+    set->path = path;
+    set->capacity = -1;
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    char line[256];
+    int status = 0;
+    while (status == 0 && fgets(line, sizeof(line), f) != NULL) {
+        const char *v;
+        if (line[0] == '#') {
+            // Заголовок повторяется в каждом прогоне; берется первый
+            if (set->cpu[0] == '\0' && (v = header_value(line, "cpu")) != NULL) {
+                size_t n = strcspn(v, "\n");
+                if (n >= sizeof(set->cpu)) n = sizeof(set->cpu) - 1;
+                memcpy(set->cpu, v, n);
+                set->cpu[n] = '\0';
+            } else if (set->capacity < 0 && (v = header_value(line, "capacity")) != NULL) {
+                set->capacity = atoi(v);
+            }
+            continue;
+        }
+        unsigned run;
+        char mode[16], kernel[32], multiplier[16];
+        size_t len;
+        double median, per_limb, ops, core;
+        if (sscanf(line, "%u,%15[^,],%31[^,],%zu,%15[^,],%lf,%lf,%lf,%lf", &run, mode, kernel, &len, multiplier,
+                   &median, &per_limb, &ops, &core) != 9) {
+            continue;   // Строка названий столбцов
+        }
+        if (run == 0 || run > MAX_RUNS) {
+            fprintf(stderr, "%s: run %u out of range 1..%d\n", path, run, MAX_RUNS);
+            status = -1;
+            break;
+        }
+        double x = tsc ? per_limb : core;
+        if (x <= 0) continue;   // Пустой замер: накладные расходы больше замера
+        bench_case_t *c = find_case(set, mode, kernel, len, multiplier);
+        if (c == NULL) {
+            if ((c = add_case(set)) == NULL) {
+                status = -1;
+                break;
+            }
+            snprintf(c->mode, sizeof(c->mode), "%s", mode);
+            snprintf(c->kernel, sizeof(c->kernel), "%s", kernel);
+            snprintf(c->multiplier, sizeof(c->multiplier), "%s", multiplier);
+            c->len = len;
+        }
+        if (!c->have[run - 1]) {
+            c->have[run - 1] = 1;
+            c->n += 1;
+        }
+        c->v[run - 1] = log(x);
+        if (run > set->runs) set->runs = run;
+    }
+    fclose(f);
+    return status;
+}
+
+/** Среднее и выборочная дисперсия значений прогонов, отмеченных в have. */
+typedef struct {
+    unsigned n;
+    double mean;
+    double var;
+} bench_sample_t;
+
+static bench_sample_t sample_of(const double *v, const unsigned char *have) {
+    bench_sample_t s = {0, 0.0, 0.0};
+    for (unsigned r = 0; r < MAX_RUNS; ++r) {
+        if (!have[r]) continue;
+        s.n += 1;
+        s.mean += v[r];
+    }
+    if (s.n == 0) return s;
+    s.mean /= s.n;
+    for (unsigned r = 0; r < MAX_RUNS; ++r) {
+        if (have[r]) s.var += (v[r] - s.mean) * (v[r] - s.mean);
+    }
+    s.var = s.n > 1 ? s.var / (s.n - 1) : 0.0;
+    return s;
+}
+
+/** Непрерывная дробь регуляризованной неполной бета-функции (Lentz). */
+static double beta_cf(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+    if (fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m <= 300; ++m) {
+        double aa = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+        d = 1.0 + aa * d;
+        c = 1.0 + aa / c;
+        if (fabs(d) < tiny) d = tiny;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+        d = 1.0 + aa * d;
+        c = 1.0 + aa / c;
+        if (fabs(d) < tiny) d = tiny;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        double del = d * c;
+        h *= del;
+        if (fabs(del - 1.0) < 1e-12) break;
+    }
+    return h;
+}
+
+/** Регуляризованная неполная бета-функция I_x(a, b). */
+static double beta_inc(double a, double b, double x) {
+    if (x <= 0) return 0.0;
+    if (x >= 1) return 1.0;
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) return front * beta_cf(a, b, x) / a;
+    return 1.0 - front * beta_cf(b, a, 1.0 - x) / b;
+}
+
+/** P(|T| > t) для t-распределения с df степенями свободы. */
+static double t_two_tail(double t, double df) {
+    return beta_inc(df / 2.0, 0.5, df / (df + t * t));
+}
+
+/** Квантиль t-распределения: P(|T| > q) = alpha (бисекция). */
+static double t_quantile(double alpha, double df) {
+    double lo = 0.0, hi = 1e6;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        if (t_two_tail(mid, df) > alpha) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+/** Изменение NEW относительно BASE и интервал, в процентах. */
+typedef struct {
+    double delta;
+    double lo;
+    double hi;
+} bench_delta_t;
+
+/**
+ * Разность средних логарифмов NEW - BASE и ее интервал на уровне
+ * 1 - alpha: по разностям пар (paired) или по Уэлчу. -1 — меньше двух
+ * наблюдений.
+ */
+static int log_delta(const double *b, const unsigned char *hb, const double *n, const unsigned char *hn, int paired,
+                     double alpha, bench_delta_t *out) {
+    double diff, se, df;
+    if (paired) {
+        double d[MAX_RUNS];
+        unsigned char both[MAX_RUNS];
+        for (unsigned r = 0; r < MAX_RUNS; ++r) {
+            both[r] = hb[r] && hn[r];
+            d[r] = both[r] ? n[r] - b[r] : 0.0;
+        }
+        bench_sample_t s = sample_of(d, both);
+        if (s.n < 2) return -1;
+        diff = s.mean;
+        se = sqrt(s.var / s.n);
+        df = s.n - 1;
+    } else {
+        bench_sample_t sb = sample_of(b, hb), sn = sample_of(n, hn);
+        if (sb.n < 2 || sn.n < 2) return -1;
+        double qb = sb.var / sb.n, qn = sn.var / sn.n;
+        diff = sn.mean - sb.mean;
+        se = sqrt(qb + qn);
+        df = qb + qn > 0 ? (qb + qn) * (qb + qn) / (qb * qb / (sb.n - 1) + qn * qn / (sn.n - 1)) : 1.0;
+    }
+    double half = se > 0 ? t_quantile(alpha, df) * se : 0.0;
+    out->delta = 100.0 * (exp(diff) - 1.0);
+    out->lo = 100.0 * (exp(diff - half) - 1.0);
+    out->hi = 100.0 * (exp(diff + half) - 1.0);
+    return 0;
+}
+
+/** Пометка по изменению и интервалу. */
+static const char *verdict(const bench_delta_t *d, double threshold) {
+    if (d->lo > 0 && d->delta > threshold) return "SLOWER";
+    if (d->hi < 0 && -d->delta > threshold) return "faster";
+    return "";
+}
+
+/** Пара режим/ядро: сумма логарифмов ее случаев по прогонам. */
+typedef struct {
+    char mode[16];
+    char kernel[32];
+    unsigned cases;
+    unsigned slower;
+    unsigned faster;
+    double log_base[MAX_RUNS];
+    double log_new[MAX_RUNS];
+} bench_group_t;
+
+static bench_group_t *find_group(bench_group_t *groups, size_t *count, const bench_case_t *c) {
+    for (size_t k = 0; k < *count; ++k) {
+        if (strcmp(groups[k].mode, c->mode) == 0 && strcmp(groups[k].kernel, c->kernel) == 0) return &groups[k];
+    }
+    if (*count == MAX_GROUPS) return NULL;
+    bench_group_t *g = &groups[(*count)++];
+    memset(g, 0, sizeof(*g));
+    snprintf(g->mode, sizeof(g->mode), "%s", c->mode);
+    snprintf(g->kernel, sizeof(g->kernel), "%s", c->kernel);
+    return g;
+}
+
+/** Прогоны случая совпадают с прогонами файла (для среднего по паре). */
+static int complete(const bench_case_t *c, const bench_set_t *set) {
+    return c->n == set->runs;
+}
+
+static double flag_double(int argc, char **argv, const char *name, double def) {
+    size_t n = strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], name, n) == 0 && argv[i][n] == '=') return atof(argv[i] + n + 1);
+    }
+    return def;
+}
+
+static int has_flag(int argc, char **argv, const char *flag) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], flag) == 0) return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *paths[2] = {NULL, NULL};
+    int np = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--", 2) == 0) continue;
+        if (np < 2) paths[np] = argv[i];
+        ++np;
+    }
+    double threshold = flag_double(argc, argv, "--threshold", DEFAULT_THRESHOLD);
+    double confidence = flag_double(argc, argv, "--confidence", DEFAULT_CONFIDENCE);
+    if (np != 2 || confidence <= 0 || confidence >= 100) {
+        fprintf(stderr,
+                "Usage: %s [--paired] [--metric=tsc] [--threshold=PERCENT] [--confidence=PERCENT] [--all] "
+                "BASE.csv NEW.csv\n",
+                argv[0]);
+        return 2;
+    }
+    int all = has_flag(argc, argv, "--all");
+    int paired = has_flag(argc, argv, "--paired");
+    int tsc = has_flag(argc, argv, "--metric=tsc");
+
+    bench_set_t base = {0}, cur = {0};
+    int status = 2;
+    if (load_set(&base, paths[0], tsc) != 0 || load_set(&cur, paths[1], tsc) != 0) goto out;
+    if (base.capacity != cur.capacity) {
+        fprintf(stderr, "Capacity differs: BASE %d, NEW %d\n", base.capacity, cur.capacity);
+        goto out;
+    }
+    if (strcmp(base.cpu, cur.cpu) != 0) {
+        fprintf(stderr, "Warning: different CPUs, cycles are not comparable\n  BASE: %s\n  NEW:  %s\n", base.cpu,
+                cur.cpu);
+    }
+
+    // Случаи, общие для обоих файлов
+    size_t common = 0, missing = 0;
+    for (size_t i = 0; i < base.count; ++i) {
+        const bench_case_t *b = &base.cases[i];
+        if (find_case(&cur, b->mode, b->kernel, b->len, b->multiplier) == NULL) {
+            ++missing;
+        } else {
+            ++common;
+        }
+    }
+    if (common == 0) {
+        fprintf(stderr, "No common cases in %s and %s\n", base.path, cur.path);
+        goto out;
+    }
+
+    double alpha = 1.0 - confidence / 100.0;
+    printf("BASE: %s (%u runs)\nNEW:  %s (%u runs)\nCPU:  %s\n", base.path, base.runs, cur.path, cur.runs, cur.cpu);
+    printf("%s cycles per limb, geometric mean over runs. Delta = NEW / BASE - 1 with a %s t-interval,\n"
+           "%.0f%% familywise (Bonferroni over %zu cases); flagged if it excludes 0 and |delta| > %.1f%%.\n\n",
+           tsc ? "TSC" : "Core", paired ? "paired" : "Welch", confidence, common, threshold);
+    printf("%-10s | %-14s | %4s | %-5s | %9s | %9s | %24s |\n", "mode", "kernel", "len", "b", "base", "new",
+           "delta % [CI]");
+
+    bench_group_t groups[MAX_GROUPS];
+    size_t ngroups = 0;
+    unsigned regressions = 0;
+    for (size_t i = 0; i < base.count; ++i) {
+        const bench_case_t *b = &base.cases[i];
+        const bench_case_t *c = find_case(&cur, b->mode, b->kernel, b->len, b->multiplier);
+        if (c == NULL) continue;
+        bench_delta_t d;
+        if (log_delta(b->v, b->have, c->v, c->have, paired, alpha / common, &d) != 0) {
+            fprintf(stderr, "Need at least 2 %sruns per case (BENCH_RUNS)\n", paired ? "paired " : "");
+            goto out;
+        }
+        const char *flag = verdict(&d, threshold);
+        regressions += flag[0] == 'S';
+
+        bench_group_t *g = find_group(groups, &ngroups, b);
+        if (g != NULL && complete(b, &base) && complete(c, &cur)) {
+            g->cases += 1;
+            g->slower += flag[0] == 'S';
+            g->faster += flag[0] == 'f';
+            for (unsigned r = 0; r < base.runs; ++r) g->log_base[r] += b->v[r];
+            for (unsigned r = 0; r < cur.runs; ++r) g->log_new[r] += c->v[r];
+        }
+        if (all || flag[0] != '\0') {
+            unsigned char hb[MAX_RUNS], hc[MAX_RUNS];
+            memcpy(hb, b->have, sizeof(hb));
+            memcpy(hc, c->have, sizeof(hc));
+            printf("%-10s | %-14s | %4zu | %-5s | %9.3f | %9.3f | %+7.2f [%+6.1f, %+6.1f] | %s\n", b->mode,
+                   b->kernel, b->len, b->multiplier, exp(sample_of(b->v, hb).mean), exp(sample_of(c->v, hc).mean),
+                   d.delta, d.lo, d.hi, flag);
+        }
+    }
+
+    // По парам: среднее логарифмов в каждом прогоне — одно наблюдение
+    printf("\nPer mode/kernel: geometric mean over all lengths and multipliers, one value per run,\n"
+           "%.0f%% familywise (Bonferroni over %zu pairs).\n\n", confidence, ngroups);
+    printf("%-10s | %-14s | %5s | %24s | %6s | %6s |\n", "mode", "kernel", "cases", "geomean delta % [CI]", "slower",
+           "faster");
+    unsigned group_regressions = 0;
+    for (size_t k = 0; k < ngroups; ++k) {
+        bench_group_t *g = &groups[k];
+        if (g->cases == 0) continue;
+        unsigned char hb[MAX_RUNS], hc[MAX_RUNS];
+        for (unsigned r = 0; r < MAX_RUNS; ++r) {
+            hb[r] = r < base.runs;
+            hc[r] = r < cur.runs;
+            g->log_base[r] /= g->cases;
+            g->log_new[r] /= g->cases;
+        }
+        bench_delta_t d;
+        if (log_delta(g->log_base, hb, g->log_new, hc, paired, alpha / ngroups, &d) != 0) continue;
+        const char *flag = verdict(&d, threshold);
+        group_regressions += flag[0] == 'S';
+        printf("%-10s | %-14s | %5u | %+7.2f [%+6.1f, %+6.1f] | %6u | %6u | %s\n", g->mode, g->kernel, g->cases,
+               d.delta, d.lo, d.hi, g->slower, g->faster, flag);
+    }
+    if (missing != 0) printf("\n%zu BASE cases have no NEW counterpart\n", missing);
+    printf("\n%zu cases compared: %u case and %u mode/kernel regressions above %.1f%%\n", common, regressions,
+           group_regressions, threshold);
+    status = regressions != 0 || group_regressions != 0 ? 1 : 0;
+
+out:
+    free(base.cases);
+    free(cur.cases);
+    return status;
+}
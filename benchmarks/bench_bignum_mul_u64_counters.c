@@ -0,0 +1,131 @@
+/**
+ * @file    bench_bignum_mul_u64_counters.c
+ * @brief   Аппаратные счетчики через perf_event_open с запасной меткой времени.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *   - rev 1.1 (14.10.2026): Метки времени через bench_tsc_begin/bench_tsc_end.
+ */
+
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "bench_bignum_mul_u64_counters.h"
+
+static const uint64_t counter_config[BENCH_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+
+static int open_counter(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group_fd == -1;          // Группой управляет лидер
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+void bench_counters_open(bench_counters_t *c) {
+    c->members = 0;
+    c->tsc_start = 0;
+    for (int i = 0; i < BENCH_COUNTER_COUNT; ++i) {
+        c->fd[i] = -1;
+        c->slot[i] = -1;
+    }
+    // Лидер — такты; без него группы нет
+    int leader = open_counter(counter_config[BENCH_COUNTER_CYCLES], -1);
+    if (leader < 0) return;
+    c->fd[BENCH_COUNTER_CYCLES] = leader;
+    c->slot[BENCH_COUNTER_CYCLES] = c->members++;
+    for (int i = BENCH_COUNTER_CYCLES + 1; i < BENCH_COUNTER_COUNT; ++i) {
+        int fd = open_counter(counter_config[i], leader);
+        if (fd >= 0) {
+            c->fd[i] = fd;
+            c->slot[i] = c->members++;
+        }
+    }
+}
+
+void bench_counters_close(bench_counters_t *c) {
+    for (int i = 0; i < BENCH_COUNTER_COUNT; ++i) {
+        if (c->fd[i] >= 0) close(c->fd[i]);
+        c->fd[i] = -1;
+    }
+    c->members = 0;
+}
+
+void bench_counters_start(bench_counters_t *c) {
+    int leader = c->fd[BENCH_COUNTER_CYCLES];
+    if (leader >= 0) {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    c->tsc_start = bench_tsc_begin();
+}
+
+void bench_counters_stop(bench_counters_t *c, bench_counts_t *out) {
+    uint64_t tsc_end = bench_tsc_end();
+    int leader = c->fd[BENCH_COUNTER_CYCLES];
+    if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    memset(out, 0, sizeof(*out));
+    out->tsc = tsc_end - c->tsc_start;
+    if (leader < 0) return;
+
+    // Формат чтения группы: nr, time_enabled, time_running, values[nr]
+    uint64_t buf[3 + BENCH_COUNTER_COUNT];
+    ssize_t got = read(leader, buf, sizeof(buf));
+    if (got < (ssize_t)(3 * sizeof(uint64_t)) || buf[0] != (uint64_t)c->members || buf[2] == 0) return;
+    // Группа делила PMU с другими: значения приводятся ко всему участку
+    double scale = buf[2] < buf[1] ? (double)buf[1] / (double)buf[2] : 1.0;
+    out->hw = 1;
+    for (int i = 0; i < BENCH_COUNTER_COUNT; ++i) {
+        if (c->slot[i] < 0) continue;
+        out->valid[i] = 1;
+        out->value[i] = (uint64_t)((double)buf[3 + c->slot[i]] * scale);
+    }
+}
+
+void bench_counters_report(FILE *f, const char *label, const bench_counts_t *counts, double calls, double limbs) {
+    if (!counts->hw) {
+        fprintf(f, "%s: %.2f " BENCH_TSC_UNIT "/call, %.3f " BENCH_TSC_UNIT "/limb (hardware counters unavailable)\n", label,
+                counts->tsc / calls, counts->tsc / limbs);
+        return;
+    }
+    const uint64_t *v = counts->value;
+    const int *ok = counts->valid;
+    fprintf(f, "%s: %.2f cycles/call, %.3f cycles/limb", label, v[BENCH_COUNTER_CYCLES] / calls,
+            v[BENCH_COUNTER_CYCLES] / limbs);
+    if (ok[BENCH_COUNTER_INSTRUCTIONS]) {
+        fprintf(f, ", IPC %.2f, %.2f instructions/limb",
+                (double)v[BENCH_COUNTER_INSTRUCTIONS] / (double)v[BENCH_COUNTER_CYCLES],
+                v[BENCH_COUNTER_INSTRUCTIONS] / limbs);
+    } else {
+        fprintf(f, ", IPC n/a");
+    }
+    if (ok[BENCH_COUNTER_BRANCH_MISSES]) {
+        fprintf(f, ", %.4f branch-misses/call", v[BENCH_COUNTER_BRANCH_MISSES] / calls);
+    } else {
+        fprintf(f, ", branch-misses n/a");
+    }
+    if (ok[BENCH_COUNTER_CACHE_MISSES]) {
+        fprintf(f, ", %.4f cache-misses/call", v[BENCH_COUNTER_CACHE_MISSES] / calls);
+    } else {
+        fprintf(f, ", cache-misses n/a");
+    }
+    fprintf(f, " (%.2f " BENCH_TSC_UNIT "/call)\n", counts->tsc / calls);
+}
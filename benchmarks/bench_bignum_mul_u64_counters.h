@@ -0,0 +1,105 @@
+/**
+ * @file    bench_bignum_mul_u64_counters.h
+ * @brief   Аппаратные счетчики вокруг измеряемого участка бенчмарка.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Группа `perf_event_open` на вызывающем потоке: такты, инструкции,
+ *   промахи предсказания переходов и промахи кэша, только режим
+ *   пользователя (достаточно kernel.perf_event_paranoid <= 2, root не
+ *   нужен). Если счетчики недоступны (контейнер, ВМ без PMU), участок
+ *   измеряется по `rdtsc`, а в отчете остаются только такты TSC.
+ *   Отдельный счетчик, который не открылся, отчет помечает как n/a.
+ *
+ *   `bench_tsc_begin`/`bench_tsc_end` — метки времени коротких участков:
+ *   TSC на x86-64 (`lfence; rdtsc` / `rdtscp; lfence`), на AArch64 —
+ *   виртуальный счетчик таймера `CNTVCT_EL0` между `isb`. У AArch64 это не
+ *   такты ядра: частота таймера (CNTFRQ_EL0) обычно 25 МГц–1 ГГц.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *   - rev 1.1 (14.10.2026): Метки времени для AArch64.
+ */
+
+#ifndef BENCH_BIGNUM_MUL_U64_COUNTERS_H
+#define BENCH_BIGNUM_MUL_U64_COUNTERS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#if defined(__x86_64__)
+#  include <x86intrin.h>
+#endif
+
+#if defined(__aarch64__)
+#  define BENCH_TSC_UNIT "timer ticks"
+#else
+#  define BENCH_TSC_UNIT "TSC cycles"
+#endif
+
+/** Метка времени начала участка: предыдущие инструкции уже завершены. */
+static inline uint64_t bench_tsc_begin(void) {
+#if defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+    return t;
+#else
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#endif
+}
+
+/** Метка времени конца участка: последующие инструкции еще не начаты. */
+static inline uint64_t bench_tsc_end(void) {
+#if defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+    return t;
+#else
+    unsigned aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#endif
+}
+
+typedef enum {
+    BENCH_COUNTER_CYCLES,
+    BENCH_COUNTER_INSTRUCTIONS,
+    BENCH_COUNTER_BRANCH_MISSES,
+    BENCH_COUNTER_CACHE_MISSES,
+    BENCH_COUNTER_COUNT
+} bench_counter_t;
+
+typedef struct {
+    int fd[BENCH_COUNTER_COUNT];     // -1 — счетчик не открыт
+    int slot[BENCH_COUNTER_COUNT];   // Позиция значения в чтении группы
+    int members;                     // Открыто счетчиков в группе
+    uint64_t tsc_start;
+} bench_counters_t;
+
+typedef struct {
+    int hw;                                  // Аппаратные значения есть
+    int valid[BENCH_COUNTER_COUNT];
+    uint64_t value[BENCH_COUNTER_COUNT];
+    uint64_t tsc;                            // Метки времени участка (всегда)
+} bench_counts_t;
+
+/** Открывает группу; без счетчиков остается замер по rdtsc. */
+void bench_counters_open(bench_counters_t *c);
+void bench_counters_close(bench_counters_t *c);
+
+/** Начало и конец измеряемого участка. */
+void bench_counters_start(bench_counters_t *c);
+void bench_counters_stop(bench_counters_t *c, bench_counts_t *out);
+
+/**
+ * Печатает итоги участка: такты на вызов, IPC, инструкции на слово,
+ * промахи на вызов (или только такты TSC на вызов без счетчиков).
+ */
+void bench_counters_report(FILE *f, const char *label, const bench_counts_t *counts, double calls, double limbs);
+
+#endif // BENCH_BIGNUM_MUL_U64_COUNTERS_H
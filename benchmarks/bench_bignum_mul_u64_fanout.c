@@ -0,0 +1,99 @@
+/**
+ * @file    bench_bignum_mul_u64_fanout.c
+ * @brief   Микробенчмарк bignum_mul_u64_fanout против k вызовов bignum_mul_u64.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для набора длин `a` и чисел множителей k измеряет время одного вызова
+ *   bignum_mul_u64_fanout и k вызовов bignum_mul_u64 с тем же `a`, в
+ *   наносекундах на все k произведений.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 -I include -no-pie \
+ *    benchmarks/bench_bignum_mul_u64_fanout.c build/bignum_mul_u64.o \
+ *    -o bin/bench_bignum_mul_u64_fanout
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+
+// Повторов на одну пару (длина, k)
+#ifndef ITERATIONS
+#  define ITERATIONS 500000u
+#endif
+
+#define MAX_OUTPUTS 16
+
+static const size_t lengths[] = {1, 4, 8, 16, 32, BIGNUM_CAPACITY};
+static const size_t outputs[] = {4, 8, 16};
+
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+#define OUTPUT_COUNT (sizeof(outputs) / sizeof(outputs[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t rand64(void) {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+int main(void) {
+    static bignum_t out[MAX_OUTPUTS];
+    bignum_t *res[MAX_OUTPUTS];
+    uint64_t b[MAX_OUTPUTS];
+    srand(12345);
+    for (size_t j = 0; j < MAX_OUTPUTS; ++j) {
+        res[j] = &out[j];
+        b[j] = rand64();
+    }
+
+    printf("%-6s | %3s | %14s | %14s | %7s\n", "limbs", "k", "fanout ns", "k x mul_u64 ns", "speedup");
+    size_t last = 0;
+    for (size_t l = 0; l < LENGTH_COUNT; ++l) {
+        size_t n = lengths[l];
+        if (n > BIGNUM_CAPACITY || n <= last) continue;
+        last = n;
+
+        bignum_t a;
+        memset(&a, 0, sizeof(a));
+        for (size_t i = 0; i < n; ++i) a.words[i] = rand64();
+        a.words[n - 1] |= 1;
+        a.len = n;
+
+        for (size_t o = 0; o < OUTPUT_COUNT; ++o) {
+            size_t k = outputs[o];
+            volatile int sink = 0;
+            double t0 = now_ns();
+            for (unsigned r = 0; r < ITERATIONS; ++r) {
+                b[0] = r | 1;
+                sink += bignum_mul_u64_fanout(res, &a, b, k);
+            }
+            double fanout = (now_ns() - t0) / ITERATIONS;
+
+            t0 = now_ns();
+            for (unsigned r = 0; r < ITERATIONS; ++r) {
+                b[0] = r | 1;
+                for (size_t j = 0; j < k; ++j) sink += bignum_mul_u64(res[j], &a, b[j]);
+            }
+            double single = (now_ns() - t0) / ITERATIONS;
+            printf("%-6zu | %3zu | %14.2f | %14.2f | %6.2fx\n", n, k, fanout, single, single / fanout);
+            (void)sink;
+        }
+    }
+    return 0;
+}
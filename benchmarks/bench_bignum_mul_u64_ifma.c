@@ -0,0 +1,105 @@
+/**
+ * @file    bench_bignum_mul_u64_ifma.c
+ * @brief   Сравнение пакетного движка AVX-512 IFMA со скалярным циклом.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для каждой длины из набора измеряет среднее время на элемент
+ *   bignum_mul_u64_batch_generic и bignum_mul_u64_batch_ifma на пакете
+ *   чисел одинаковой длины (векторный путь) и выводит ускорение. По этой
+ *   таблице решается, собирать ли библиотеку с IFMA=1 для конкретного
+ *   процессора. Без AVX-512 IFMA бенчмарк завершается с сообщением.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 -I include -no-pie \
+ *    benchmarks/bench_bignum_mul_u64_ifma.c build/bignum_mul_u64.o \
+ *    -o bin/bench_bignum_mul_u64_ifma
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+
+#ifndef ROUNDS
+#  define ROUNDS 2000u
+#endif
+
+// Элементов в пакете (кратно 8, чтобы весь пакет шел векторным путем)
+#define BATCH_N 1024
+
+static const size_t lengths[] = {1, 2, 4, 8, 16, 32, 64};
+
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+
+typedef bignum_mul_u64_status_t (*batch_fn_t)(bignum_t *, const bignum_t *, const uint64_t *,
+                                              size_t, bignum_mul_u64_status_t *);
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/** Среднее время (нс) на элемент пакета. */
+static double run_case(batch_fn_t fn, bignum_t *res, const bignum_t *a, const uint64_t *b) {
+    volatile int sink = 0;
+    double t0 = now_ns();
+    for (unsigned r = 0; r < ROUNDS; ++r) {
+        sink += fn(res, a, b, BATCH_N, NULL);
+    }
+    double t1 = now_ns();
+    (void)sink;
+    return (t1 - t0) / ((double)ROUNDS * BATCH_N);
+}
+
+int main(void) {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512ifma")) {
+        printf("AVX-512 IFMA not supported, nothing to compare\n");
+        return 0;
+    }
+
+    bignum_t *a = malloc(sizeof(bignum_t) * BATCH_N);
+    bignum_t *res = malloc(sizeof(bignum_t) * BATCH_N);
+    uint64_t *b = malloc(sizeof(uint64_t) * BATCH_N);
+    if (!a || !res || !b) {
+        perror("Failed to allocate memory for test data");
+        free(a);
+        free(res);
+        free(b);
+        return 1;
+    }
+
+    srand(12345);
+    printf("%-6s | %-12s | %-12s | %s\n", "len", "generic", "ifma", "speedup");
+    for (size_t l = 0; l < LENGTH_COUNT; ++l) {
+        // Длины, не помещающиеся в емкость этой сборки, пропускаются
+        if (lengths[l] > BIGNUM_CAPACITY) continue;
+        for (size_t i = 0; i < BATCH_N; ++i) {
+            a[i].len = lengths[l];
+            for (size_t j = 0; j < lengths[l]; ++j) {
+                a[i].words[j] = ((uint64_t)rand() << 32) | (uint64_t)rand();
+            }
+            a[i].words[lengths[l] - 1] >>= 1; // без переполнения на полной длине
+            b[i] = ((uint64_t)rand() << 32) | (uint64_t)rand() | 2;
+        }
+        double ns_gen = run_case(bignum_mul_u64_batch_generic, res, a, b);
+        double ns_ifma = run_case(bignum_mul_u64_batch_ifma, res, a, b);
+        printf("%-6zu | %7.2f ns   | %7.2f ns   | x%.2f\n", lengths[l], ns_gen, ns_ifma, ns_gen / ns_ifma);
+    }
+
+    free(a);
+    free(res);
+    free(b);
+    return 0;
+}
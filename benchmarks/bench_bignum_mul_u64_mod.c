@@ -0,0 +1,132 @@
+/**
+ * @file    bench_bignum_mul_u64_mod.c
+ * @brief   Микробенчмарк умножения по модулю bignum_mul_u64_mod.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для набора длин модуля измеряет время цепочки x = x * b mod m:
+ *     - bignum_mul_u64_mod (один совмещенный проход);
+ *     - bignum_mul_u64_n без приведения — нижняя граница стоимости прохода;
+ *     - GMP mpn_mul_1 и приведение делением mpn_tdiv_qr, если сборка с
+ *       HAVE_GMP (обычный путь "умножение, затем деление").
+ *   Перед замером результат bignum_mul_u64_mod сверяется с GMP.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 -I include -no-pie [-DHAVE_GMP] \
+ *    benchmarks/bench_bignum_mul_u64_mod.c build/bignum_mul_u64.o \
+ *    -o bin/bench_bignum_mul_u64_mod [-lgmp]
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+#ifdef HAVE_GMP
+#include <gmp.h>
+#endif
+
+// Умножений на одну длину
+#ifndef ITERATIONS
+#  define ITERATIONS 2000000u
+#endif
+
+static const size_t lengths[] = {1, 2, 4, 8, 16, 32, BIGNUM_CAPACITY};
+
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t rand64(void) {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+int main(void) {
+    static uint64_t multipliers[1024];
+    srand(12345);
+    for (size_t i = 0; i < 1024; ++i) multipliers[i] = rand64();
+
+    printf("%-6s | %18s | %18s", "limbs", "mul_u64_mod ns", "mul_u64_n only ns");
+#ifdef HAVE_GMP
+    printf(" | %18s | %7s", "mpn mul+tdiv ns", "speedup");
+#endif
+    printf("\n");
+
+    size_t last = 0;
+    for (size_t l = 0; l < LENGTH_COUNT; ++l) {
+        size_t n = lengths[l];
+        if (n > BIGNUM_CAPACITY || n <= last) continue;
+        last = n;
+
+        bignum_t m, x;
+        memset(&m, 0, sizeof(m));
+        for (size_t i = 0; i < n; ++i) m.words[i] = rand64();
+        m.words[n - 1] |= 1;
+        m.len = n;
+        bignum_mul_u64_mod_ctx_t ctx;
+        if (bignum_mul_u64_mod_init(&ctx, &m) != BIGNUM_MUL_U64_SUCCESS) return 1;
+
+        memset(&x, 0, sizeof(x));
+        x.words[0] = 1;
+        x.len = 1;
+        volatile int sink = 0;
+        double t0 = now_ns();
+        for (unsigned r = 0; r < ITERATIONS; ++r) sink += bignum_mul_u64_mod(&x, &x, multipliers[r & 1023], &ctx);
+        double fused = (now_ns() - t0) / ITERATIONS;
+
+        // Тот же проход без приведения: n слов, перенос отбрасывается
+        uint64_t plain[BIGNUM_CAPACITY];
+        for (size_t i = 0; i < n; ++i) plain[i] = rand64();
+        t0 = now_ns();
+        for (unsigned r = 0; r < ITERATIONS; ++r) sink += (int)bignum_mul_u64_n(plain, plain, n, multipliers[r & 1023]);
+        double mul = (now_ns() - t0) / ITERATIONS;
+        printf("%-6zu | %18.2f | %18.2f", n, fused, mul);
+
+#ifdef HAVE_GMP
+        // Сверка с GMP на тех же множителях, затем замер mpn_mul_1 + mpn_tdiv_qr
+        mp_limb_t gm[BIGNUM_CAPACITY], gx[BIGNUM_CAPACITY + 1], gq[2], gr[BIGNUM_CAPACITY];
+        for (size_t i = 0; i < n; ++i) gm[i] = m.words[i];
+        memset(gx, 0, sizeof(gx));
+        gx[0] = 1;
+        memset(&x, 0, sizeof(x));
+        x.words[0] = 1;
+        x.len = 1;
+        for (unsigned r = 0; r < 4096; ++r) {
+            gx[n] = mpn_mul_1(gx, gx, (mp_size_t)n, multipliers[r & 1023]);
+            mpn_tdiv_qr(gq, gr, 0, gx, (mp_size_t)n + 1, gm, (mp_size_t)n);
+            memcpy(gx, gr, n * sizeof(mp_limb_t));
+            bignum_mul_u64_mod(&x, &x, multipliers[r & 1023], &ctx);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if ((i < x.len ? x.words[i] : 0) != gx[i]) {
+                fprintf(stderr, "Mismatch with GMP at %zu limbs\n", n);
+                return 1;
+            }
+        }
+        t0 = now_ns();
+        for (unsigned r = 0; r < ITERATIONS; ++r) {
+            gx[n] = mpn_mul_1(gx, gx, (mp_size_t)n, multipliers[r & 1023]);
+            mpn_tdiv_qr(gq, gr, 0, gx, (mp_size_t)n + 1, gm, (mp_size_t)n);
+            memcpy(gx, gr, n * sizeof(mp_limb_t));
+        }
+        double gmp = (now_ns() - t0) / ITERATIONS;
+        printf(" | %18.2f | %6.1fx", gmp, gmp / fused);
+#endif
+        printf("\n");
+        (void)sink;
+    }
+    return 0;
+}
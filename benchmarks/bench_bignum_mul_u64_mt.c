@@ -1,24 +1,57 @@
 /**
  * @file    bench_bignum_mul_u64_mt.c
- * @brief   Многопоточный микробенчмарк для профилирования bignum_mul_u64.
+ * @brief   Многопоточный микробенчмарк: масштабирование bignum_mul_u64 по потокам.
  * @author  git@bayborodov.com
  * @version 1.0.0
  * @date    27.11.2025
  *
  * @details
- *   Для чистоты измерений все случайные данные генерируются заранее
- *   в основном потоке и передаются в рабочие потоки. Каждый поток
- *   выполняет свой набор вызовов bignum_mul_u64, используя
- *   общий пул предварительно сгенерированных данных.
+ *   Число потоков проходит от 1 до числа процессоров, доступных процессу
+ *   (маска affinity, например из `taskset`), или до THREAD_COUNT, если он
+ *   задан. Поток t закрепляется за t-м процессором маски, сам выделяет
+ *   выровненный по строке кэша пул чисел и результатов и сам заполняет его
+ *   (первое касание — память его NUMA-узла), после чего ждет на общем
+ *   барьере. Между потоками нет общих данных, так что падение ops/s на
+ *   поток показывает ограничение в самом пути вызова (или в ядре/памяти),
+ *   а не конкуренцию за строки кэша.
+ *
+ *   Для каждого числа потоков печатаются суммарные ops/s (все вызовы за
+ *   общее время от первого старта до последнего финиша), минимум /
+ *   среднее / максимум ops/s на поток и эффективность масштабирования
+ *   относительно одного потока, а при доступных аппаратных счетчиках
+ *   (perf_event_open, на поток) — IPC по всем потокам.
+ *
+ *   Вторая часть измеряет масштабирование bignum_mul_u64_n_parallel на
+ *   одном операнде из SPAN_WORDS слов: от 1 потока до числа процессоров.
+ *   Прогрев каждой конфигурации выполняется тем же разбиением, так что
+ *   страницы dst размещаются первым касанием рядом со своим потоком.
+ *   Рядом — тот же операнд через bignum_mul_u64_n_parallel_pool на пуле
+ *   из стольких же рабочих: разница — цена создания потоков на вызов.
+ *   Запуск с аргументом `span` выполняет только эту часть.
+ *
+ *   Третья часть — пул bignum_mul_u64_submit: POOL_BURSTS пачек случайной
+ *   длины (1..POOL_MAX_BURST, неравномерно) отправляются окнами по
+ *   POOL_WINDOW и ждутся через bignum_mul_u64_wait; рабочих от 1 до числа
+ *   процессоров. База — те же пачки через bignum_mul_u64_batch в одном
+ *   потоке. Запуск с аргументом `pool` выполняет только эту часть.
  *
  * @history
  *   - rev 1.0 (12.08.2025): Первоначальная версия.
  *   - rev 1.1 (13.08.2025): Реализована предварительная генерация данных
  *                           в main для исключения rand() из потоков.
+ *   - rev 1.2 (14.10.2026): Локальное определение BIGNUM_CAPACITY удалено:
+ *                           емкость задается при сборке.
+ *   - rev 1.3 (14.10.2026): Замер масштабирования bignum_mul_u64_n_parallel.
+ *   - rev 1.4 (14.10.2026): Замер масштабирования вместо конкуренции:
+ *                           частные NUMA-локальные пулы, affinity, барьер
+ *                           старта, ops/s, развертка числа потоков.
+ *   - rev 1.5 (14.10.2026): В замере span — bignum_mul_u64_n_parallel_pool.
+ *   - rev 1.5 (14.10.2026): IPC по аппаратным счетчикам потоков.
+ *   - rev 1.6 (14.10.2026): Замер пула с кражей работы (режим `pool`).
  *
  * # Сборка
  * gcc -g -O2 -I include -no-pie -fno-omit-frame-pointer -pthread \
- *   benchmarks/bench_bignum_mul_u64_mt.c build/bignum_mul_u64.o \
+ *   benchmarks/bench_bignum_mul_u64_mt.c benchmarks/bench_bignum_mul_u64_counters.c build/bignum_mul_u64.o \
  *   -o bin/bench_bignum_mul_u64_mt
  *
  * # Запуск perf
@@ -26,128 +59,412 @@
  *   bin/bench_bignum_mul_u64_mt
  */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <time.h>
 #include <pthread.h>
+#include <sched.h>
 #include <string.h>
+#include <unistd.h>
 #include <bignum.h>
 #include "bignum_mul_u64.h"
-
-// --- Локальные определения для компиляции ---
-#define BIGNUM_CAPACITY 32
-#define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+#include "bench_bignum_mul_u64_counters.h"
 
 #ifndef ITER_PER_THREAD
-#  define ITER_PER_THREAD (20000000u * 20)
+#  define ITER_PER_THREAD 20000000u
 #endif
 
-#ifndef THREAD_COUNT
-#  define THREAD_COUNT 4
+// 64 МиБ на массив: заметно больше LLC
+#ifndef SPAN_WORDS
+#  define SPAN_WORDS ((size_t)1 << 23)
 #endif
 
-#define PREGEN_DATA_COUNT 8192
-#define MAX_SHIFT (BIGNUM_BITS - 1)
+#ifndef SPAN_REPS
+#  define SPAN_REPS 5
+#endif
+
+#ifndef POOL_BURSTS
+#  define POOL_BURSTS 4096
+#endif
+#define POOL_MAX_BURST 4096
+#define POOL_WINDOW    16              // Пачек в полете одновременно
+#define POOL_OPERANDS  ((size_t)1 << 16)
+
+// Пул на поток: 512 чисел по 264 байта (при емкости 32) держатся в L2
+#define PREGEN_DATA_COUNT 512
+#define CACHE_LINE 64
 
 // Структура для передачи данных в поток
 typedef struct {
     unsigned thread_id;
-    unsigned iters;
-    const bignum_t* res; // Указатель на общий пул результирующих чисел
-    const bignum_t* a; // Указатель на общий пул исходных чисел
-    const uint64_t* b;    // Указатель на общий пул множителей
-    unsigned data_count;     // Размер пула
+    int cpu;                     // Процессор для закрепления, -1 — без закрепления
+    pthread_barrier_t *start;    // Общий барьер старта
+    double start_ns;             // Начало и конец цикла вызовов
+    double end_ns;
+    bench_counts_t counts;       // Счетчики потока на цикле вызовов
+    int failed;
 } thread_arg_t;
 
-/** Инициализация случайного bignum_t */
-static void init_random_bignum(bignum_t *num) {
-    int used = (rand() % BIGNUM_CAPACITY) + 1;
-    num->len = used;
-    for (int i = 0; i < used; ++i) {
-        num->words[i] = ((uint64_t)rand() << 32) | rand();
+/** Процессоры из маски affinity процесса; возвращает их число. */
+static unsigned allowed_cpus(int *cpus, unsigned max) {
+    cpu_set_t set;
+    unsigned n = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE && n < max; ++c) {
+            if (CPU_ISSET(c, &set)) cpus[n++] = c;
+        }
     }
-    for (int i = used; i < BIGNUM_CAPACITY; ++i) {
-        num->words[i] = 0;
+    if (n == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long c = 0; c < online && n < max; ++c) cpus[n++] = -1;
     }
+    return n > 0 ? n : 1;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t next_rand(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
 }
 
 /** Функция, исполняемая каждым потоком */
 static void* thread_func(void *arg) {
-    const thread_arg_t *t = arg;
+    thread_arg_t *t = arg;
 
-    for (unsigned i = 0; i < t->iters; ++i) {
-        // Используем общий пул данных, циклически
-        // Смещаем индекс на thread_id, чтобы потоки реже работали с одними и теми же данными
-        unsigned data_idx = (i + t->thread_id) % t->data_count;
+    if (t->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(t->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
 
-        bignum_t res_dst = {0};
-        bignum_t a_dst = t->a[data_idx];
-        uint64_t b_dst = t->b[data_idx];
+    // Частные данные потока: выделяются и заполняются уже на его процессоре
+    size_t pool_size = sizeof(bignum_t) * PREGEN_DATA_COUNT;
+    pool_size = (pool_size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    bignum_t *a = aligned_alloc(CACHE_LINE, pool_size);
+    bignum_t *res = aligned_alloc(CACHE_LINE, pool_size);
+    uint64_t *b = aligned_alloc(CACHE_LINE, PREGEN_DATA_COUNT * sizeof(uint64_t));
+    t->failed = !a || !res || !b;
+    if (!t->failed) {
+        uint64_t state = 0x9E3779B97F4A7C15ULL * (t->thread_id + 1);
+        memset(a, 0, pool_size);
+        memset(res, 0, pool_size);
+        for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
+            size_t used = next_rand(&state) % BIGNUM_CAPACITY + 1;
+            for (size_t k = 0; k < used; ++k) a[i].words[k] = next_rand(&state);
+            a[i].words[used - 1] |= 1;
+            a[i].len = used;
+            b[i] = next_rand(&state);
+        }
+    }
 
-        bignum_mul_u64(&res_dst, &a_dst, b_dst);
+    // Счетчики perf_event_open считают только этот поток
+    bench_counters_t counters;
+    bench_counters_open(&counters);
 
-        if (a_dst.len == 0xDEADBEEF) {
-            return (void*)1;
+    pthread_barrier_wait(t->start);
+    if (!t->failed) {
+        volatile int sink = 0;
+        bench_counters_start(&counters);
+        t->start_ns = now_ns();
+        for (unsigned i = 0; i < ITER_PER_THREAD; ++i) {
+            unsigned data_idx = i % PREGEN_DATA_COUNT;
+            sink += bignum_mul_u64(&res[data_idx], &a[data_idx], b[data_idx]);
         }
+        t->end_ns = now_ns();
+        bench_counters_stop(&counters, &t->counts);
+        (void)sink;
     }
+    bench_counters_close(&counters);
+
+    free(a);
+    free(res);
+    free(b);
     return NULL;
 }
 
-int main(void) {
-    // --- Фаза 1: Предварительная генерация данных в основном потоке ---
-    printf("Pregenerating %u data sets for %u threads...\n", PREGEN_DATA_COUNT, THREAD_COUNT);
-    bignum_t* res = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
-    bignum_t* a = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
-    uint64_t* b = malloc(sizeof(uint64_t) * PREGEN_DATA_COUNT);
+/** Один прогон на threads потоках: 0 — успех. */
+static int run_threads(unsigned threads, const int *cpus, thread_arg_t *args, pthread_t *tids) {
+    pthread_barrier_t start;
+    if (pthread_barrier_init(&start, NULL, threads) != 0) {
+        perror("pthread_barrier_init");
+        return 1;
+    }
+    // Вызывающий поток не закрепляется: новые потоки наследуют его маску
+    for (unsigned i = 0; i < threads; ++i) {
+        args[i].thread_id = i;
+        args[i].cpu = cpus[i];
+        args[i].start = &start;
+        args[i].start_ns = 0;
+        args[i].end_ns = 0;
+        memset(&args[i].counts, 0, sizeof(args[i].counts));
+        args[i].failed = 0;
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        if (pthread_create(&tids[i], NULL, thread_func, &args[i]) != 0) {
+            perror("pthread_create");
+            // Без недостающих потоков барьер не откроется: завершаемся
+            exit(1);
+        }
+    }
+    int failed = 0;
+    for (unsigned i = 0; i < threads; ++i) {
+        pthread_join(tids[i], NULL);
+        failed |= args[i].failed;
+    }
+    pthread_barrier_destroy(&start);
+    return failed;
+}
 
-    if (!a || !b || !res) {
-        perror("Failed to allocate memory for test data");
+/** Развертка числа потоков 1..max_threads для bignum_mul_u64. */
+static int bench_call_scaling(const int *cpus, unsigned max_threads) {
+    thread_arg_t *args = calloc(max_threads, sizeof(*args));
+    pthread_t *tids = calloc(max_threads, sizeof(*tids));
+    if (!args || !tids) {
+        perror("Failed to allocate thread state");
+        free(args);
+        free(tids);
         return 1;
     }
 
-    memset(&res, 0, sizeof(res));
-    srand((unsigned)time(NULL));
-    for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
-        init_random_bignum(&a[i]);
-        b[i] = (uint64_t)(rand() % MAX_SHIFT);
+    printf("Call scaling: bignum_mul_u64, %u calls per thread, 1..%u threads\n", ITER_PER_THREAD, max_threads);
+    printf("%8s %14s %14s %14s %14s %10s %8s\n", "threads", "total_Mops/s", "min_Mops/s", "mean_Mops/s",
+           "max_Mops/s", "efficiency", "IPC");
+    double base = 0;
+    int status = 0;
+    for (unsigned threads = 1; threads <= max_threads && status == 0; ++threads) {
+        if (run_threads(threads, cpus, args, tids) != 0) {
+            fprintf(stderr, "Failed to allocate per-thread data\n");
+            status = 1;
+            break;
+        }
+        // Суммарные ops/s — по общему времени от первого старта до последнего
+        // финиша: сумма ops/s потоков завышала бы итог при вытеснении
+        double first = args[0].start_ns, last = args[0].end_ns, sum = 0, min = 0, max = 0;
+        double cycles = 0, instructions = 0;
+        int have_ipc = 1;
+        for (unsigned i = 0; i < threads; ++i) {
+            const bench_counts_t *c = &args[i].counts;
+            have_ipc &= c->hw && c->valid[BENCH_COUNTER_INSTRUCTIONS];
+            cycles += (double)c->value[BENCH_COUNTER_CYCLES];
+            instructions += (double)c->value[BENCH_COUNTER_INSTRUCTIONS];
+            double mops = ITER_PER_THREAD / (args[i].end_ns - args[i].start_ns) * 1e3;
+            sum += mops;
+            if (i == 0 || mops < min) min = mops;
+            if (i == 0 || mops > max) max = mops;
+            if (args[i].start_ns < first) first = args[i].start_ns;
+            if (args[i].end_ns > last) last = args[i].end_ns;
+        }
+        double total = (double)ITER_PER_THREAD * threads / (last - first) * 1e3;
+        if (threads == 1) base = total;
+        printf("%8u %14.2f %14.2f %14.2f %14.2f %9.1f%%", threads, total, min, sum / threads, max,
+               100.0 * total / (base * threads));
+        if (have_ipc && cycles > 0) {
+            printf(" %8.2f\n", instructions / cycles);
+        } else {
+            printf(" %8s\n", "n/a");
+        }
     }
 
-    // --- Фаза 2: Запуск потоков и профилирование ---
-    printf("Starting benchmark with %u threads, %u iterations each...\n", THREAD_COUNT, ITER_PER_THREAD);
-    pthread_t threads[THREAD_COUNT];
-    thread_arg_t args[THREAD_COUNT];
+    free(args);
+    free(tids);
+    return status;
+}
 
-    for (unsigned i = 0; i < THREAD_COUNT; ++i) {
-        args[i].thread_id = i;
-        args[i].iters     = ITER_PER_THREAD;
-        args[i].res = res;
-        args[i].a   = a;
-        args[i].b   = b;
-        args[i].data_count = PREGEN_DATA_COUNT;
-        if (pthread_create(&threads[i], NULL, thread_func, &args[i]) != 0) {
-            perror("pthread_create");
-            free(res);
-            free(a);
-            free(b);
-            return 1;
+/**
+ * Масштабирование bignum_mul_u64_n_parallel по числу потоков: лучшее из
+ * SPAN_REPS время, пропускная способность (чтение src + запись dst) и
+ * ускорение относительно одного потока, а при доступных аппаратных счетчиках
+ *   (perf_event_open, на поток) — IPC по всем потокам. Для пула из того же
+ * числа рабочих — лучшее время bignum_mul_u64_n_parallel_pool.
+ */
+static int bench_span_scaling(unsigned max_threads) {
+    uint64_t *src = malloc(SPAN_WORDS * sizeof(uint64_t));
+    uint64_t *dst = malloc(SPAN_WORDS * sizeof(uint64_t));
+    if (!src || !dst) {
+        perror("Failed to allocate span buffers");
+        free(src);
+        free(dst);
+        return 1;
+    }
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < SPAN_WORDS; ++i) {
+        src[i] = next_rand(&state);
+    }
+
+    printf("Span scaling: bignum_mul_u64_n_parallel, %zu words (%zu MiB), 1..%u threads\n",
+           (size_t)SPAN_WORDS, (size_t)SPAN_WORDS * sizeof(uint64_t) >> 20, max_threads);
+    printf("%8s %12s %10s %8s %12s %10s\n", "threads", "time_ms", "GB/s", "speedup", "pool_ms",
+           "pool_GB/s");
+    volatile uint64_t sink = 0;
+    double base_ns = 0;
+    for (unsigned threads = 1; threads <= max_threads; ++threads) {
+        sink += bignum_mul_u64_n_parallel(dst, src, SPAN_WORDS, 0x9E3779B97F4A7C15ULL, threads);
+        double best = 0;
+        for (unsigned r = 0; r < SPAN_REPS; ++r) {
+            double t0 = now_ns();
+            sink += bignum_mul_u64_n_parallel(dst, src, SPAN_WORDS, 0x9E3779B97F4A7C15ULL, threads);
+            double dt = now_ns() - t0;
+            if (r == 0 || dt < best) best = dt;
+        }
+
+        bignum_mul_u64_pool_t *pool = bignum_mul_u64_pool_create(threads);
+        double pool_best = 0;
+        if (pool != NULL) {
+            sink += bignum_mul_u64_n_parallel_pool(pool, dst, src, SPAN_WORDS, 0x9E3779B97F4A7C15ULL);
+            for (unsigned r = 0; r < SPAN_REPS; ++r) {
+                double t0 = now_ns();
+                sink += bignum_mul_u64_n_parallel_pool(pool, dst, src, SPAN_WORDS, 0x9E3779B97F4A7C15ULL);
+                double dt = now_ns() - t0;
+                if (r == 0 || dt < pool_best) pool_best = dt;
+            }
+            bignum_mul_u64_pool_destroy(pool);
+        }
+
+        if (threads == 1) base_ns = best;
+        double bytes = 2.0 * SPAN_WORDS * sizeof(uint64_t);
+        printf("%8u %12.3f %10.2f %8.2f", threads, best / 1e6, bytes / best, base_ns / best);
+        if (pool_best > 0) {
+            printf(" %12.3f %10.2f\n", pool_best / 1e6, bytes / pool_best);
+        } else {
+            printf(" %12s %10s\n", "n/a", "n/a");
+        }
+    }
+    (void)sink;
+    free(src);
+    free(dst);
+    return 0;
+}
+
+/** Пачка i: операнды из общего кольца, результаты — в слоте окна. */
+static void pool_burst(unsigned i, size_t *from, bignum_t **dst, bignum_t *res) {
+    *from = (size_t)i * 7919 % (POOL_OPERANDS - POOL_MAX_BURST);
+    *dst = res + (size_t)(i % POOL_WINDOW) * POOL_MAX_BURST;
+}
+
+/**
+ * Пул bignum_mul_u64_submit по числу рабочих. Длины пачек — квадрат
+ * равномерной величины (много мелких, редкие крупные), как у неравномерных
+ * всплесков запросов. Множимые читаются из кольца POOL_OPERANDS чисел,
+ * результаты пачек в полете пишутся в разные слоты.
+ */
+static int bench_pool_scaling(unsigned max_threads) {
+    size_t *len = malloc(POOL_BURSTS * sizeof(size_t));
+    bignum_t *a = aligned_alloc(CACHE_LINE, POOL_OPERANDS * sizeof(bignum_t));
+    bignum_t *res = aligned_alloc(CACHE_LINE, (size_t)POOL_WINDOW * POOL_MAX_BURST * sizeof(bignum_t));
+    uint64_t *b = malloc(POOL_OPERANDS * sizeof(uint64_t));
+    bignum_mul_u64_job_t **jobs = calloc(POOL_WINDOW, sizeof(*jobs));
+    if (!len || !a || !res || !b || !jobs) {
+        perror("Failed to allocate pool operands");
+        free(len);
+        free(a);
+        free(res);
+        free(b);
+        free(jobs);
+        return 1;
+    }
+    uint64_t state = 0xD1B54A32D192ED03ULL;
+    size_t total = 0;
+    for (unsigned i = 0; i < POOL_BURSTS; ++i) {
+        uint64_t r = next_rand(&state) % 64;
+        len[i] = 1 + r * r * (POOL_MAX_BURST - 1) / (63 * 63);
+        total += len[i];
+    }
+    memset(a, 0, POOL_OPERANDS * sizeof(bignum_t));
+    memset(res, 0, (size_t)POOL_WINDOW * POOL_MAX_BURST * sizeof(bignum_t));
+    for (size_t i = 0; i < POOL_OPERANDS; ++i) {
+        size_t used = next_rand(&state) % BIGNUM_CAPACITY + 1;
+        for (size_t k = 0; k < used; ++k) a[i].words[k] = next_rand(&state);
+        a[i].words[used - 1] |= 1;
+        a[i].len = used;
+        b[i] = next_rand(&state);
+    }
+
+    printf("Pool scaling: bignum_mul_u64_submit, %u bursts, %zu numbers, window %u, 1..%u workers\n",
+           POOL_BURSTS, total, POOL_WINDOW, max_threads);
+    printf("%8s %12s %14s %8s\n", "workers", "time_ms", "Mops/s", "speedup");
+    // База однопоточная; первый проход — прогрев
+    double base = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        double t0 = now_ns();
+        for (unsigned i = 0; i < POOL_BURSTS; ++i) {
+            size_t from;
+            bignum_t *dst;
+            pool_burst(i, &from, &dst, res);
+            bignum_mul_u64_batch(dst, a + from, b + from, len[i], NULL);
         }
+        base = now_ns() - t0;
     }
+    printf("%8s %12.3f %14.2f %8.2f\n", "inline", base / 1e6, total / base * 1e3, 1.0);
 
-    for (unsigned i = 0; i < THREAD_COUNT; ++i) {
-        void *res;
-        pthread_join(threads[i], &res);
-        if (res != NULL) {
-            fprintf(stderr, "Error in thread %u\n", i);
+    int status = 0;
+    for (unsigned workers = 1; workers <= max_threads && status == 0; ++workers) {
+        bignum_mul_u64_pool_t *pool = bignum_mul_u64_pool_create(workers);
+        if (!pool) {
+            fprintf(stderr, "bignum_mul_u64_pool_create(%u) failed\n", workers);
+            status = 1;
+            break;
         }
+        double t0 = now_ns();
+        for (unsigned i = 0; i < POOL_BURSTS && status == 0; ++i) {
+            bignum_mul_u64_job_t **slot = &jobs[i % POOL_WINDOW];
+            if (*slot) bignum_mul_u64_wait(pool, *slot);
+            *slot = NULL;
+            size_t from;
+            bignum_t *dst;
+            pool_burst(i, &from, &dst, res);
+            if (bignum_mul_u64_submit(pool, dst, a + from, b + from, len[i], NULL, NULL, NULL, slot) !=
+                BIGNUM_MUL_U64_SUCCESS) {
+                status = 1;
+            }
+        }
+        for (unsigned i = 0; i < POOL_WINDOW; ++i) {
+            if (jobs[i]) bignum_mul_u64_wait(pool, jobs[i]);
+            jobs[i] = NULL;
+        }
+        double dt = now_ns() - t0;
+        bignum_mul_u64_pool_destroy(pool);
+        printf("%8u %12.3f %14.2f %8.2f\n", workers, dt / 1e6, total / dt * 1e3, base / dt);
     }
-    
-    printf("Benchmark finished.\n");
 
-    // --- Фаза 3: Очистка ---
-    free(res);
+    free(len);
     free(a);
+    free(res);
     free(b);
+    free(jobs);
+    return status;
+}
 
-    return 0;
+int main(int argc, char **argv) {
+    static int cpus[CPU_SETSIZE];
+    unsigned max_threads = allowed_cpus(cpus, CPU_SETSIZE);
+#ifdef THREAD_COUNT
+    if (max_threads > THREAD_COUNT) max_threads = THREAD_COUNT;
+#endif
+
+    if (argc > 1 && strcmp(argv[1], "span") == 0) {
+        return bench_span_scaling(max_threads);
+    }
+    if (argc > 1 && strcmp(argv[1], "pool") == 0) {
+        return bench_pool_scaling(max_threads);
+    }
+
+    // --- Фаза 1: Масштабирование независимых вызовов ---
+    if (bench_call_scaling(cpus, max_threads) != 0) return 1;
+
+    // --- Фаза 2: Масштабирование на одном большом операнде ---
+    if (bench_span_scaling(max_threads) != 0) return 1;
+
+    // --- Фаза 3: Пул с кражей работы на неравномерных пачках ---
+    return bench_pool_scaling(max_threads);
 }
@@ -0,0 +1,156 @@
+/**
+ * @file    bench_bignum_mul_u64_radix.c
+ * @brief   Микробенчмарк разбора строк: bignum_from_decimal / bignum_from_radix.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для набора длин десятичной строки (до наибольшей, помещающейся в
+ *   BIGNUM_CAPACITY слов) измеряет время вызова и время на цифру:
+ *     - bignum_from_decimal (группы по 19 цифр, один проход на группу);
+ *     - разбор по одной цифре через текущий API: bignum_mul_u64 на 10 и
+ *       отдельное сложение цифры с распространением переноса;
+ *     - bignum_from_radix с основанием 16 на записи того же числа;
+ *     - GMP mpz_set_str, если сборка с HAVE_GMP (mpz_init2 заранее, так
+ *       что выделение памяти не измеряется).
+ *   Перед замером результаты сверяются между собой.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 -I include -no-pie [-DHAVE_GMP] \
+ *    benchmarks/bench_bignum_mul_u64_radix.c build/bignum_mul_u64.o \
+ *    -o bin/bench_bignum_mul_u64_radix [-lgmp]
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+#ifdef HAVE_GMP
+#include <gmp.h>
+#endif
+
+// Цифр, разбираемых на одну длину (время замера не зависит от длины)
+#ifndef DIGITS_PER_CASE
+#  define DIGITS_PER_CASE 20000000u
+#endif
+
+// Наибольшая десятичная длина, которая всегда помещается: 19 цифр на слово
+#define MAX_DECIMAL (19 * BIGNUM_CAPACITY)
+
+static const size_t lengths[] = {8, 19, 20, 40, 100, 300, MAX_DECIMAL};
+
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/** Разбор по одной цифре: res = res * 10, затем res += цифра. */
+static bignum_mul_u64_status_t per_digit(bignum_t *res, const char *s, size_t n) {
+    res->words[0] = 0;
+    res->len = 1;
+    for (size_t i = 0; i < n; ++i) {
+        bignum_mul_u64_status_t st = bignum_mul_u64(res, res, 10);
+        if (st != BIGNUM_MUL_U64_SUCCESS) return st;
+        uint64_t carry = (uint64_t)(s[i] - '0');
+        for (size_t k = 0; carry != 0 && k < res->len; ++k) {
+            res->words[k] += carry;
+            carry = res->words[k] < carry;
+        }
+        if (carry != 0) {
+            if (res->len == BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+            res->words[res->len++] = carry;
+        }
+    }
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+/** Шестнадцатеричная запись res в out; возвращает длину. */
+static size_t to_hex(const bignum_t *res, char *out) {
+    size_t n = 0;
+    for (size_t i = res->len; i-- > 0;) {
+        n += (size_t)sprintf(out + n, n == 0 ? "%llx" : "%016llx", (unsigned long long)res->words[i]);
+    }
+    return n;
+}
+
+static int same(const bignum_t *x, const bignum_t *y) {
+    return x->len == y->len && memcmp(x->words, y->words, x->len * sizeof(uint64_t)) == 0;
+}
+
+int main(void) {
+    static char dec[MAX_DECIMAL + 1];
+    static char hex[16 * BIGNUM_CAPACITY + 1];
+    bignum_t ref, res;
+    srand(12345);
+#ifdef HAVE_GMP
+    mpz_t z;
+    mpz_init2(z, 64 * BIGNUM_CAPACITY + 64);
+#endif
+
+    printf("%-7s | %22s | %22s | %22s", "digits", "from_decimal ns (/dig)", "per-digit ns (/dig)",
+           "from_radix(16) ns(/dig)");
+#ifdef HAVE_GMP
+    printf(" | %22s", "mpz_set_str ns (/dig)");
+#endif
+    printf(" | %7s\n", "speedup");
+
+    for (size_t l = 0; l < LENGTH_COUNT; ++l) {
+        size_t n = lengths[l];
+        if (n > MAX_DECIMAL) continue;
+        for (size_t i = 0; i < n; ++i) dec[i] = (char)('0' + rand() % 10);
+        dec[0] = (char)('1' + rand() % 9);
+        dec[n] = '\0';
+
+        // Сверка перед замером
+        if (bignum_from_decimal(&ref, dec, n) != BIGNUM_MUL_U64_SUCCESS ||
+            per_digit(&res, dec, n) != BIGNUM_MUL_U64_SUCCESS || !same(&ref, &res)) {
+            fprintf(stderr, "Mismatch with the per-digit parse at %zu digits\n", n);
+            return 1;
+        }
+        size_t hn = to_hex(&ref, hex);
+        if (bignum_from_radix(&res, hex, hn, 16) != BIGNUM_MUL_U64_SUCCESS || !same(&ref, &res)) {
+            fprintf(stderr, "Mismatch with the hex parse at %zu digits\n", n);
+            return 1;
+        }
+
+        unsigned reps = DIGITS_PER_CASE / (unsigned)n;
+        volatile int sink = 0;
+        double t0 = now_ns();
+        for (unsigned r = 0; r < reps; ++r) sink += bignum_from_decimal(&res, dec, n);
+        double fast = (now_ns() - t0) / reps;
+        // Посимвольный разбор квадратичен: на длинных строках повторов меньше
+        unsigned slow_reps = reps / 8 + 1;
+        t0 = now_ns();
+        for (unsigned r = 0; r < slow_reps; ++r) sink += per_digit(&res, dec, n);
+        double slow = (now_ns() - t0) / slow_reps;
+        t0 = now_ns();
+        for (unsigned r = 0; r < reps; ++r) sink += bignum_from_radix(&res, hex, hn, 16);
+        double radix16 = (now_ns() - t0) / reps;
+        printf("%-7zu | %12.1f (%7.3f) | %12.1f (%7.3f) | %12.1f (%7.3f)", n, fast, fast / n, slow, slow / n,
+               radix16, radix16 / hn);
+#ifdef HAVE_GMP
+        t0 = now_ns();
+        for (unsigned r = 0; r < reps; ++r) sink += mpz_set_str(z, dec, 10);
+        double gmp = (now_ns() - t0) / reps;
+        printf(" | %12.1f (%7.3f)", gmp, gmp / n);
+#endif
+        printf(" | %6.1fx\n", slow / fast);
+        (void)sink;
+    }
+#ifdef HAVE_GMP
+    mpz_clear(z);
+#endif
+    return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file    bench_bignum_mul_u64_ref.c
+ * @brief   Альтернативные реализации для сравнения с bignum_mul_u64.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Переносимый цикл на `unsigned __int128` и обертка над GMP `mpn_mul_1`
+ *   (при сборке с -DHAVE_GMP) с той же семантикой, что у bignum_mul_u64
+ *   на нормализованных входах: проверка указателей и длины, перенос в
+ *   слово len, переполнение емкости. Единица трансляции всегда
+ *   собирается с `-O3 -march=native` независимо от CONFIG, чтобы
+ *   сравнение шло с лучшим, что дает компилятор.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+#include "bench_bignum_mul_u64_ref.h"
+
+#ifdef HAVE_GMP
+#  include <gmp.h>
+#endif
+
+__extension__ typedef unsigned __int128 ref_u128_t;
+
+/** Длина и перенос — общий для обеих реализаций хвост. */
+static bignum_mul_u64_status_t ref_finish(bignum_t *res, size_t len, uint64_t carry) {
+    if (carry != 0) {
+        if (len >= BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        res->words[len++] = carry;
+    }
+    res->len = len;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+bignum_mul_u64_status_t bench_ref_mul_u64_int128(bignum_t *res, const bignum_t *a, uint64_t b) {
+    if (res == NULL || a == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    size_t len = a->len;
+    if (len > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < len; ++i) {
+        ref_u128_t p = (ref_u128_t)a->words[i] * b + carry;
+        res->words[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    return ref_finish(res, len, carry);
+}
+
+#ifdef HAVE_GMP
+bignum_mul_u64_status_t bench_ref_mul_u64_gmp(bignum_t *res, const bignum_t *a, uint64_t b) {
+    if (res == NULL || a == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    size_t len = a->len;
+    if (len > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    if (len == 0) return ref_finish(res, 0, 0);
+    uint64_t carry = mpn_mul_1((mp_limb_t *)res->words, (const mp_limb_t *)a->words, (mp_size_t)len, b);
+    return ref_finish(res, len, carry);
+}
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file    bench_bignum_mul_u64_ref.h
+ * @brief   Альтернативные реализации bignum_mul_u64 для бенчмарков сравнения.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ */
+
+#ifndef BENCH_BIGNUM_MUL_U64_REF_H
+#define BENCH_BIGNUM_MUL_U64_REF_H
+
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+
+/** Цикл на `unsigned __int128`, собранный с -O3 -march=native. */
+bignum_mul_u64_status_t bench_ref_mul_u64_int128(bignum_t *res, const bignum_t *a, uint64_t b);
+
+#ifdef HAVE_GMP
+/** GMP `mpn_mul_1` с переносом в слово len. */
+bignum_mul_u64_status_t bench_ref_mul_u64_gmp(bignum_t *res, const bignum_t *a, uint64_t b);
+#endif
+
+#endif // BENCH_BIGNUM_MUL_U64_REF_H
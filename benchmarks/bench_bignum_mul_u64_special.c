@@ -0,0 +1,135 @@
+/**
+ * @file    bench_bignum_mul_u64_special.c
+ * @brief   Микробенчмарк быстрых путей bignum_mul_u64 по классам множителя.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для каждой длины множимого из набора и каждого класса множителя
+ *   (1 "на месте", 1 с копированием, степень двойки, 10, < 2^32, полный
+ *   64-битный) измеряет среднее время вызова bignum_mul_u64 и выводит
+ *   таблицу с ускорением относительно полного 64-битного множителя,
+ *   который всегда идет через основной цикл умножения.
+ *
+ *   Данные генерируются заранее; в измеряемом цикле нет копирования
+ *   структур, только вызовы целевой функции.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *
+ * # Сборка
+ *  gcc -O2 -I include -no-pie \
+ *    benchmarks/bench_bignum_mul_u64_special.c build/bignum_mul_u64.o \
+ *    -o bin/bench_bignum_mul_u64_special
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+
+#ifndef ITERATIONS
+#  define ITERATIONS 2000000u
+#endif
+
+// Количество предварительно сгенерированных чисел на одну длину
+#define PREGEN_DATA_COUNT 64
+
+typedef struct {
+    const char *name;
+    uint64_t b;
+    int in_place;
+} multiplier_class_t;
+
+static const multiplier_class_t classes[] = {
+    {"b=1 in-place", 1, 1},
+    {"b=1",          1, 0},
+    {"b=2^k",        1ULL << 29, 0},
+    {"b=10",         10, 0},
+    {"b<2^32",       0xDEADBEEFULL, 0},
+    {"b full",       0xF1E2D3C4B5A69788ULL, 0},
+};
+
+#define CLASS_COUNT (sizeof(classes) / sizeof(classes[0]))
+
+static const size_t lengths[] = {1, 2, 4, 8, 16, BIGNUM_CAPACITY - 1};
+
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/** Заполняет bignum случайными словами заданной длины. */
+static void init_random_bignum(bignum_t *num, size_t len) {
+    memset(num, 0, sizeof(*num));
+    num->len = len;
+    for (size_t i = 0; i < len; ++i) {
+        num->words[i] = ((uint64_t)rand() << 32) | (uint64_t)rand();
+    }
+    num->words[len - 1] |= 1;
+}
+
+/** Среднее время вызова (нс) для одного класса множителя и длины. */
+static double run_case(bignum_t *res, bignum_t *a, const multiplier_class_t *c) {
+    volatile int sink = 0;
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        unsigned idx = i % PREGEN_DATA_COUNT;
+        bignum_t *dst = c->in_place ? &a[idx] : &res[idx];
+        sink += bignum_mul_u64(dst, &a[idx], c->b);
+    }
+    double t1 = now_ns();
+    (void)sink;
+    return (t1 - t0) / ITERATIONS;
+}
+
+int main(void) {
+    bignum_t* a = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    bignum_t* res = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
+
+    if (!a || !res) {
+        perror("Failed to allocate memory for test data");
+        free(a);
+        free(res);
+        return 1;
+    }
+
+    srand(12345);
+    printf("%-6s", "len");
+    for (size_t c = 0; c < CLASS_COUNT; ++c) {
+        printf(" | %-20s", classes[c].name);
+    }
+    printf("\n");
+
+    for (size_t l = 0; l < LENGTH_COUNT; ++l) {
+        double ns[CLASS_COUNT];
+        // Длины, не помещающиеся в емкость этой сборки, пропускаются
+        if (lengths[l] == 0 || lengths[l] > BIGNUM_CAPACITY) continue;
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            // Для каждого класса — свежие данные, чтобы "на месте" не копило множитель
+            for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
+                init_random_bignum(&a[i], lengths[l]);
+            }
+            memset(res, 0, sizeof(bignum_t) * PREGEN_DATA_COUNT);
+            ns[c] = run_case(res, a, &classes[c]);
+        }
+        printf("%-6zu", lengths[l]);
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            printf(" | %7.2f ns (x%5.2f)", ns[c], ns[CLASS_COUNT - 1] / ns[c]);
+        }
+        printf("\n");
+    }
+
+    free(a);
+    free(res);
+    return 0;
+}
@@ -0,0 +1,502 @@
+/**
+ * @file    bench_bignum_mul_u64_sweep.c
+ * @brief   Развертка по длине: такты на вызов и на слово для ядер bignum_mul_u64.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Для каждого ядра, каждой длины 1..BIGNUM_CAPACITY и каждого класса
+ *   множителя (малый < 2^16, полный 64-битный, степень двойки) снимает
+ *   SAMPLES замеров. Замер — CALLS_PER_SAMPLE вызовов на разных заранее
+ *   сгенерированных числах между `lfence; rdtsc` и `rdtscp; lfence`;
+ *   из него вычитается медиана пустого замера.
+ *
+ *   Два режима:
+ *   - `--throughput` (по умолчанию): вызовы независимы, res и a — заранее
+ *     выделенные массивы, копирования в цикле нет;
+ *   - `--latency`: зависимая цепочка x = x * b "на месте". После каждого
+ *     вызова длина возвращается к len (старшее слово отбрасывается), а в
+ *     младшее слово ставится единица, чтобы при степенях двойки x не
+ *     обнулялся; обе записи не лежат на критическом пути цепочки переноса.
+ *
+ *   Результат — CSV в stdout: медиана и 99-й перцентиль тактов на вызов и
+ *   на слово множимого. Такты — такты TSC (опорная частота), а не ядра:
+ *   для сравнения вариантов ядер частоту лучше зафиксировать. На AArch64
+ *   это тики CNTVCT_EL0 (bench_tsc_begin); при частоте таймера в десятки
+ *   МГц CALLS_PER_SAMPLE стоит увеличить (`-DCALLS_PER_SAMPLE=256`).
+ *
+ *   Аргументы — флаги режимов (можно оба) и имена ядер для замера
+ *   (по умолчанию все доступные): bignum_mul_u64, generic, mulx, unchecked.
+ *
+ *   `--compare` вместо CSV прогоняет на тех же входах bignum_mul_u64, цикл
+ *   на `unsigned __int128` (-O3 -march=native) и GMP `mpn_mul_1` (при
+ *   сборке с -DHAVE_GMP), проверяет совпадение результатов и печатает по
+ *   каждому классу множителя таблицу ускорения по длинам.
+ *
+ *   `--record` печатает те же медианы в формате хранилища базовых замеров
+ *   (make bench-record / bench-compare): строка `run,mode,kernel,len,
+ *   multiplier,median_cycles,cycles_per_limb,ops_per_s,core_cycles_per_limb`
+ *   на случай, в заголовке `#` — модель процессора, частота меток времени
+ *   и емкость. Номер прогона задает `--run=N`; прогоны — отдельные запуски
+ *   процесса, чтобы разброс между ними включал раскладку памяти и
+ *   состояние частоты. ops/s — частота меток (калибровка по
+ *   CLOCK_MONOTONIC), деленная на медиану меток на вызов.
+ *   core_cycles_per_limb — медиана на слово, пересчитанная в такты ядра:
+ *   до и после случая цепочка зависимых `add reg, reg` дает тактов ядра на
+ *   метку (среднее двух замеров); по этому столбцу сравнивает
+ *   bench_bignum_mul_u64_compare. `--cpu-key` печатает модель процессора в
+ *   виде имени каталога хранилища.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *   - rev 1.1 (14.10.2026): Режимы --latency и --throughput.
+ *   - rev 1.2 (14.10.2026): Сравнение с __int128 и GMP (--compare).
+ *   - rev 1.3 (14.10.2026): Сборка на AArch64: ядро mulx только на x86-64.
+ *   - rev 1.4 (14.10.2026): Формат хранилища замеров (--record, --run, --cpu-key).
+ *
+ * # Сборка
+ *  gcc -O3 -march=native -I include -c benchmarks/bench_bignum_mul_u64_ref.c \
+ *    -DHAVE_GMP -o build/bench_bignum_mul_u64_ref.o
+ *  gcc -O2 -I include -DHAVE_GMP -no-pie \
+ *    benchmarks/bench_bignum_mul_u64_sweep.c build/bench_bignum_mul_u64_ref.o \
+ *    build/bignum_mul_u64.o -lgmp -o bin/bench_bignum_mul_u64_sweep
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <bignum.h>
+#include "bignum_mul_u64.h"
+#include "bench_bignum_mul_u64_counters.h"
+#include "bench_bignum_mul_u64_ref.h"
+
+#ifndef SAMPLES
+#  define SAMPLES 2001u
+#endif
+
+#ifndef CALLS_PER_SAMPLE
+#  define CALLS_PER_SAMPLE 8u
+#endif
+
+// Количество предварительно сгенерированных чисел на одну длину
+#define PREGEN_DATA_COUNT 64
+
+typedef bignum_mul_u64_status_t (*mul_fn_t)(bignum_t *, const bignum_t *, uint64_t);
+
+typedef struct {
+    const char *name;
+    mul_fn_t fn;
+    int needs_mulx;
+} kernel_t;
+
+static const kernel_t kernels[] = {
+    {"bignum_mul_u64", bignum_mul_u64,           0},
+    {"generic",        bignum_mul_u64_generic,   0},
+#if defined(__x86_64__)
+    {"mulx",           bignum_mul_u64_mulx,      1},
+#endif
+    {"unchecked",      bignum_mul_u64_unchecked, 0},
+};
+
+#define KERNEL_COUNT (sizeof(kernels) / sizeof(kernels[0]))
+
+static const char *const class_names[] = {"small", "full", "pow2"};
+
+#define CLASS_COUNT (sizeof(class_names) / sizeof(class_names[0]))
+
+static uint64_t rand_u64(void) {
+    return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+/** Множитель класса c; 0 и 1 исключены, их обслуживают быстрые пути. */
+static uint64_t make_multiplier(size_t c) {
+    switch (c) {
+    case 0:  return 2 + (rand_u64() & 0xFFFD);
+    case 1:  return rand_u64() | (1ULL << 63) | 1;
+    default: return 1ULL << (1 + rand_u64() % 63);
+    }
+}
+
+/** Заполняет bignum случайными словами заданной длины; старшее слово ненулевое. */
+static void init_random_bignum(bignum_t *num, size_t len) {
+    memset(num, 0, sizeof(*num));
+    num->len = len;
+    for (size_t i = 0; i < len; ++i) {
+        num->words[i] = rand_u64();
+    }
+    num->words[len - 1] |= 1;
+}
+
+static int cmp_u64(const void *x, const void *y) {
+    uint64_t a = *(const uint64_t *)x, b = *(const uint64_t *)y;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Режим --latency: перед замером x получает копию a[s] (вне замера), затем
+ * calls зависимых вызовов x = x * b.
+ */
+static void sample_latency(uint64_t *out, mul_fn_t fn, bignum_t *x, const bignum_t *a, const uint64_t *b,
+                           unsigned calls) {
+    unsigned idx = 0;
+    for (unsigned s = 0; s < SAMPLES; ++s) {
+        *x = a[s % PREGEN_DATA_COUNT];
+        size_t len = x->len;
+        uint64_t t0 = bench_tsc_begin();
+        for (unsigned k = 0; k < calls; ++k) {
+            fn(x, x, b[idx]);
+            x->len = len;
+            x->words[0] |= 1;
+            idx = (idx + 1) % PREGEN_DATA_COUNT;
+        }
+        out[s] = bench_tsc_end() - t0;
+    }
+    qsort(out, SAMPLES, sizeof(out[0]), cmp_u64);
+}
+
+/** Снимает SAMPLES замеров; calls == 0 — пустой замер (накладные расходы). */
+static void sample(uint64_t *out, mul_fn_t fn, bignum_t *res, const bignum_t *a, const uint64_t *b,
+                   unsigned calls) {
+    unsigned idx = 0;
+    // Прогрев: данные в L1, предсказатели переходов обучены
+    for (unsigned i = 0; calls != 0 && i < PREGEN_DATA_COUNT; ++i) {
+        fn(&res[i], &a[i], b[i]);
+    }
+    for (unsigned s = 0; s < SAMPLES; ++s) {
+        uint64_t t0 = bench_tsc_begin();
+        for (unsigned k = 0; k < calls; ++k) {
+            fn(&res[idx], &a[idx], b[idx]);
+            idx = (idx + 1) % PREGEN_DATA_COUNT;
+        }
+        out[s] = bench_tsc_end() - t0;
+    }
+    qsort(out, SAMPLES, sizeof(out[0]), cmp_u64);
+}
+
+static int has_flag(int argc, char **argv, const char *flag) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], flag) == 0) return 1;
+    }
+    return 0;
+}
+
+static int kernel_selected(const kernel_t *k, int argc, char **argv) {
+    int any = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--", 2) == 0) continue;
+        any = 1;
+        if (strcmp(argv[i], k->name) == 0) return 1;
+    }
+    return !any;
+}
+
+// Команд в цепочке калибровки частоты ядра: 100 * CORE_CHAIN_REPEAT
+#define CORE_CHAIN_REPEAT 100u
+
+/**
+ * Тактов ядра на метку времени сейчас: цепочка зависимых `add` (ровно такт
+ * на команду при любой частоте) в метках, лучший из пяти замеров.
+ */
+static double core_per_tick(void) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 5; ++i) {
+        uint64_t x = 0;
+        uint64_t t0 = bench_tsc_begin();
+        for (unsigned k = 0; k < CORE_CHAIN_REPEAT; ++k) {
+#if defined(__aarch64__)
+            __asm__ __volatile__(".rept 100\n\tadd %0, %0, %0\n\t.endr" : "+r"(x));
+#else
+            __asm__ __volatile__(".rept 100\n\tadd %0, %0\n\t.endr" : "+r"(x));
+#endif
+        }
+        uint64_t t = bench_tsc_end() - t0;
+        if (t < best) best = t;
+    }
+    return best > 0 ? 100.0 * CORE_CHAIN_REPEAT / (double)best : 0.0;
+}
+
+/** Буферы и поправка на пустой замер, общие для всех случаев. */
+typedef struct {
+    bignum_t *a;
+    bignum_t *res;
+    uint64_t *samples;
+    uint64_t overhead;
+    uint64_t b[PREGEN_DATA_COUNT];
+    unsigned run;        // Номер прогона для --record; 0 — CSV bench-sweep
+    double tick_hz;      // Частота меток времени (только для --record)
+} sweep_ctx_t;
+
+/** Такты на вызов: медиана и 99-й перцентиль. */
+typedef struct {
+    double median;
+    double p99;
+} sweep_result_t;
+
+/** Новые входы для длины len и класса множителя c. */
+static void prepare_case(sweep_ctx_t *ctx, size_t len, size_t c) {
+    for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
+        init_random_bignum(&ctx->a[i], len);
+        ctx->b[i] = make_multiplier(c);
+    }
+}
+
+static sweep_result_t measure(sweep_ctx_t *ctx, mul_fn_t fn, int latency) {
+    memset(ctx->res, 0, sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    if (latency) {
+        sample_latency(ctx->samples, fn, ctx->res, ctx->a, ctx->b, CALLS_PER_SAMPLE);
+    } else {
+        sample(ctx->samples, fn, ctx->res, ctx->a, ctx->b, CALLS_PER_SAMPLE);
+    }
+    uint64_t med = ctx->samples[SAMPLES / 2], p99 = ctx->samples[SAMPLES * 99 / 100];
+    sweep_result_t r;
+    r.median = med > ctx->overhead ? (double)(med - ctx->overhead) / CALLS_PER_SAMPLE : 0.0;
+    r.p99 = p99 > ctx->overhead ? (double)(p99 - ctx->overhead) / CALLS_PER_SAMPLE : 0.0;
+    return r;
+}
+
+/** Развертка одного ядра по длинам и классам множителя в режиме latency (или throughput). */
+static void sweep_kernel(sweep_ctx_t *ctx, const kernel_t *kernel, int latency) {
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t c = 0; c < CLASS_COUNT; ++c) {
+            prepare_case(ctx, len, c);
+            double scale = ctx->run != 0 ? core_per_tick() : 0.0;
+            sweep_result_t r = measure(ctx, kernel->fn, latency);
+            if (ctx->run != 0) {
+                // Частота могла измениться за замер: среднее до и после
+                scale = 0.5 * (scale + core_per_tick());
+                printf("%u,%s,%s,%zu,%s,%.2f,%.4f,%.0f,%.4f\n", ctx->run, latency ? "latency" : "throughput",
+                       kernel->name, len, class_names[c], r.median, r.median / len,
+                       r.median > 0 ? ctx->tick_hz / r.median : 0.0, r.median * scale / len);
+                continue;
+            }
+            printf("%s,%s,%zu,%s,%.2f,%.2f,%.3f,%.3f\n", latency ? "latency" : "throughput", kernel->name, len,
+                   class_names[c], r.median, r.p99, r.median / len, r.p99 / len);
+        }
+    }
+}
+
+/** Реализации для --compare; первая — bignum_mul_u64, остальные сравниваются с ней. */
+static const kernel_t rivals[] = {
+    {"bignum_mul_u64", bignum_mul_u64,           0},
+    {"int128 -O3",     bench_ref_mul_u64_int128, 0},
+#ifdef HAVE_GMP
+    {"mpn_mul_1",      bench_ref_mul_u64_gmp,    0},
+#endif
+};
+
+#define RIVAL_COUNT (sizeof(rivals) / sizeof(rivals[0]))
+
+/** Все реализации дают на входах ctx тот же результат, что bignum_mul_u64. */
+static int verify_rivals(sweep_ctx_t *ctx) {
+    for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
+        bignum_t expected, got;
+        memset(&expected, 0, sizeof(expected));
+        bignum_mul_u64_status_t st = rivals[0].fn(&expected, &ctx->a[i], ctx->b[i]);
+        for (size_t r = 1; r < RIVAL_COUNT; ++r) {
+            memset(&got, 0, sizeof(got));
+            if (rivals[r].fn(&got, &ctx->a[i], ctx->b[i]) != st ||
+                (st == BIGNUM_MUL_U64_SUCCESS &&
+                 (got.len != expected.len || memcmp(got.words, expected.words, got.len * sizeof(uint64_t)) != 0))) {
+                fprintf(stderr, "Mismatch: %s vs %s, len %zu, b = 0x%016llx\n", rivals[r].name, rivals[0].name,
+                        (size_t)ctx->a[i].len, (unsigned long long)ctx->b[i]);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Таблица по длинам для каждого класса множителя: медиана тактов на вызов
+ * каждой реализации и ускорение bignum_mul_u64 относительно остальных.
+ */
+static int compare_rivals(sweep_ctx_t *ctx, int latency) {
+#ifndef HAVE_GMP
+    fprintf(stderr, "GMP not available: comparing with the int128 loop only\n");
+#endif
+    for (size_t c = 0; c < CLASS_COUNT; ++c) {
+        printf("\n%s, b %s: median TSC cycles per call (speedup of bignum_mul_u64)\n",
+               latency ? "latency" : "throughput", class_names[c]);
+        printf("%4s", "len");
+        for (size_t r = 0; r < RIVAL_COUNT; ++r) printf(" | %14s", rivals[r].name);
+        for (size_t r = 1; r < RIVAL_COUNT; ++r) {
+            char title[32];
+            snprintf(title, sizeof(title), "x %s", rivals[r].name);
+            printf(" | %14s", title);
+        }
+        printf("\n");
+        for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+            prepare_case(ctx, len, c);
+            if (!verify_rivals(ctx)) return 1;
+            double cycles[RIVAL_COUNT];
+            for (size_t r = 0; r < RIVAL_COUNT; ++r) cycles[r] = measure(ctx, rivals[r].fn, latency).median;
+            printf("%4zu", len);
+            for (size_t r = 0; r < RIVAL_COUNT; ++r) printf(" | %14.2f", cycles[r]);
+            for (size_t r = 1; r < RIVAL_COUNT; ++r) printf(" | %14.2f", cycles[0] > 0 ? cycles[r] / cycles[0] : 0.0);
+            printf("\n");
+        }
+    }
+    return 0;
+}
+
+/** Значение флага `--name=N`; def — если флага нет. */
+static unsigned flag_value(int argc, char **argv, const char *name, unsigned def) {
+    size_t n = strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], name, n) == 0 && argv[i][n] == '=') return (unsigned)strtoul(argv[i] + n + 1, NULL, 10);
+    }
+    return def;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/** Частота меток bench_tsc_*: калибровка по CLOCK_MONOTONIC, лучшая из трех по 50 мс. */
+static double tick_hz(void) {
+    double best = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        uint64_t c0 = bench_tsc_begin();
+        double t0 = now_ns(), t1;
+        do {
+            t1 = now_ns();
+        } while (t1 - t0 < 5e7);
+        uint64_t c1 = bench_tsc_end();
+        double hz = (double)(c1 - c0) * 1e9 / (t1 - t0);
+        if (hz > best) best = hz;
+    }
+    return best;
+}
+
+/** Значение поля key из /proc/cpuinfo (первое вхождение) или пустая строка. */
+static void cpuinfo_field(const char *key, char *buf, size_t size) {
+    buf[0] = '\0';
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f == NULL) return;
+    char line[256];
+    size_t n = strlen(key);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, key, n) != 0 || (line[n] != ' ' && line[n] != '\t' && line[n] != ':')) continue;
+        const char *v = strchr(line, ':');
+        if (v == NULL) break;
+        for (++v; *v == ' ' || *v == '\t'; ++v) {
+        }
+        snprintf(buf, size, "%s", v);
+        buf[strcspn(buf, "\n")] = '\0';
+        break;
+    }
+    fclose(f);
+}
+
+/**
+ * Модель процессора: "model name" (x86-64), иначе коды производителя и
+ * модели ядра (AArch64: "CPU implementer" и "CPU part").
+ */
+static void cpu_model(char *buf, size_t size) {
+    cpuinfo_field("model name", buf, size);
+    if (buf[0] != '\0') return;
+    char impl[32], part[32];
+    cpuinfo_field("CPU implementer", impl, sizeof(impl));
+    cpuinfo_field("CPU part", part, sizeof(part));
+    if (impl[0] != '\0') {
+        snprintf(buf, size, "arm %s %s", impl, part);
+    } else {
+        snprintf(buf, size, "unknown");
+    }
+}
+
+/** Модель процессора как имя каталога: строчные буквы и цифры через '-'. */
+static void cpu_key(char *buf, size_t size) {
+    char model[128];
+    cpu_model(model, sizeof(model));
+    size_t n = 0;
+    for (const char *p = model; *p != '\0' && n + 1 < size; ++p) {
+        if (isalnum((unsigned char)*p)) {
+            buf[n++] = (char)tolower((unsigned char)*p);
+        } else if (n > 0 && buf[n - 1] != '-') {
+            buf[n++] = '-';
+        }
+    }
+    while (n > 0 && buf[n - 1] == '-') --n;
+    buf[n] = '\0';
+}
+
+int main(int argc, char **argv) {
+    if (has_flag(argc, argv, "--cpu-key")) {
+        char key[128];
+        cpu_key(key, sizeof(key));
+        printf("%s\n", key);
+        return 0;
+    }
+
+    sweep_ctx_t ctx;
+    ctx.a = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    ctx.res = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    ctx.samples = malloc(sizeof(uint64_t) * SAMPLES);
+    if (!ctx.a || !ctx.res || !ctx.samples) {
+        perror("Failed to allocate memory for test data");
+        free(ctx.a);
+        free(ctx.res);
+        free(ctx.samples);
+        return 1;
+    }
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    int have_mulx = __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
+#else
+    int have_mulx = 0;
+#endif
+
+    memset(ctx.res, 0, sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    sample(ctx.samples, bignum_mul_u64, ctx.res, ctx.a, NULL, 0);
+    ctx.overhead = ctx.samples[SAMPLES / 2];
+
+    // Без флагов режима — только throughput
+    int latency = has_flag(argc, argv, "--latency");
+    int throughput = has_flag(argc, argv, "--throughput") || !latency;
+
+    srand(12345);
+    int status = 0;
+    ctx.run = 0;
+    if (has_flag(argc, argv, "--record")) {
+        char model[128];
+        cpu_model(model, sizeof(model));
+        ctx.run = flag_value(argc, argv, "--run", 1);
+        ctx.tick_hz = tick_hz();
+        printf("# cpu: %s\n# tick_hz: %.0f\n# capacity: %d\n", model, ctx.tick_hz, BIGNUM_CAPACITY);
+        printf("run,mode,kernel,len,multiplier,median_cycles,cycles_per_limb,ops_per_s,core_cycles_per_limb\n");
+    }
+    if (has_flag(argc, argv, "--compare")) {
+        if (throughput) status |= compare_rivals(&ctx, 0);
+        if (latency && status == 0) status |= compare_rivals(&ctx, 1);
+    } else {
+        if (ctx.run == 0) {
+            printf("mode,kernel,len,multiplier,median_cycles,p99_cycles,median_cycles_per_limb,p99_cycles_per_limb\n");
+        }
+        for (int mode = 0; mode < 2; ++mode) {
+            if (mode == 0 ? !throughput : !latency) continue;
+            for (size_t k = 0; k < KERNEL_COUNT; ++k) {
+                if (!kernel_selected(&kernels[k], argc, argv)) continue;
+                if (kernels[k].needs_mulx && !have_mulx) {
+                    fprintf(stderr, "Skipping %s: BMI2/ADX not supported\n", kernels[k].name);
+                    continue;
+                }
+                sweep_kernel(&ctx, &kernels[k], mode == 1);
+            }
+        }
+    }
+
+    free(ctx.a);
+    free(ctx.res);
+    free(ctx.samples);
+    return status;
+}
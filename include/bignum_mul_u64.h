@@ -13,6 +13,41 @@
  * @history
  *   - rev. 1 (01.08.2025): Первоначальное создание.
  *   - rev. 2 (01.08.2025): Добавлена полная Doxygen-документация для функции.
+ *   - rev. 3 (14.10.2026): Добавлены ядра bignum_mul_u64_generic и
+ *                          bignum_mul_u64_mulx, выбираемые по CPUID.
+ *   - rev. 4 (14.10.2026): Добавлены пакетные функции bignum_mul_u64_batch и
+ *                          bignum_mul_u64_batch_scalar.
+ *   - rev. 5 (14.10.2026): Добавлены bignum_mul_add_u64, bignum_mul_sub_u64
+ *                          и код BIGNUM_MUL_U64_ERROR_UNDERFLOW.
+ *   - rev. 6 (14.10.2026): Добавлена bignum_mul_u64_unchecked.
+ *   - rev. 7 (14.10.2026): Добавлен пакетный движок на AVX-512 IFMA и
+ *                          скалярные bignum_mul_u64_batch*_generic.
+ *   - rev. 8 (14.10.2026): Добавлен пакет bignum_batch_t в раскладке SoA,
+ *                          его упаковка/распаковка и bignum_mul_u64_batch_soa;
+ *                          код BIGNUM_MUL_U64_ERROR_NOMEM.
+ *   - rev. 9 (14.10.2026): Точная длина результата при старших нулевых словах
+ *                          множимого; добавлена bignum_mul_u64_trim_count.
+ *   - rev. 10 (14.10.2026): Добавлены bignum_mul_u64_n* на массивах слов
+ *                          произвольной длины.
+ *   - rev. 11 (14.10.2026): Добавлена многопоточная bignum_mul_u64_n_parallel.
+ *   - rev. 12 (14.10.2026): Добавлены запросы bignum_mul_u64_carry и
+ *                          bignum_mul_u64_fits.
+ *   - rev. 13 (14.10.2026): Реализация для AArch64; ядра `mulx` и движок
+ *                          IFMA объявлены только для x86-64.
+ *   - rev. 14 (14.10.2026): Добавлен пул потоков с кражей работы и
+ *                          асинхронная отправка пакетов bignum_mul_u64_submit.
+ *   - rev. 15 (14.10.2026): Добавлены bignum_from_decimal, bignum_from_radix
+ *                          и код BIGNUM_MUL_U64_ERROR_INVALID_DIGIT.
+ *   - rev. 16 (14.10.2026): Добавлена bignum_mul_u64_chain.
+ *   - rev. 17 (14.10.2026): Добавлено умножение по модулю bignum_mul_u64_mod
+ *                          с контекстом и код BIGNUM_MUL_U64_ERROR_DOMAIN.
+ *   - rev. 18 (14.10.2026): Добавлена bignum_mul_u128 (множитель из двух слов).
+ *   - rev. 19 (14.10.2026): Добавлены bignum_mul_u64_n2* и bignum_mul_u64_fanout.
+ *   - rev. 20 (14.10.2026): Добавлены счетчики вызовов bignum_mul_u64 (сборка
+ *                          CONFIG=stats) и bignum_mul_u64_stats_snapshot.
+ *   - rev. 21 (14.10.2026): Добавлен пул bignum_pool_t с выровненными слотами.
+ *   - rev. 22 (14.10.2026): Рабочие bignum_mul_u64_n_parallel закреплены за
+ *                          процессорами; добавлена bignum_mul_u64_n_parallel_pool.
  */
 
 #ifndef BIGNUM_MUL_U64_H
@@ -38,7 +73,11 @@ extern "C" {
 typedef enum {
     BIGNUM_MUL_U64_SUCCESS         =  0, /**< Успешное выполнение. */
     BIGNUM_MUL_U64_ERROR_NULL_ARG  = -1, /**< Ошибка: один из входных указателей равен NULL. */
-    BIGNUM_MUL_U64_ERROR_OVERFLOW  = -2  /**< Ошибка: переполнение емкости. */
+    BIGNUM_MUL_U64_ERROR_OVERFLOW  = -2, /**< Ошибка: переполнение емкости. */
+    BIGNUM_MUL_U64_ERROR_UNDERFLOW = -3, /**< Ошибка: отрицательный результат вычитания (bignum_mul_sub_u64). */
+    BIGNUM_MUL_U64_ERROR_NOMEM     = -4, /**< Ошибка: не удалось выделить память (bignum_batch_init, bignum_mul_u64_submit). */
+    BIGNUM_MUL_U64_ERROR_INVALID_DIGIT = -5, /**< Ошибка: пустая строка, недопустимая цифра или основание (bignum_from_radix). */
+    BIGNUM_MUL_U64_ERROR_DOMAIN    = -6  /**< Ошибка: модуль 0 или множимое не меньше модуля (bignum_mul_u64_mod). */
     /**
      * @brief Ошибка: переполнение емкости.
      * @details Сумма длин входных чисел (a->len + b->len) превышает
@@ -54,10 +93,769 @@ typedef enum {
  * @param[in]  a   Указатель на множимое (bignum_t).
  * @param[in]  b   Множитель (uint64_t).
  *
+ * @details При первом вызове выбирает ядро по CPUID: `bignum_mul_u64_mulx`
+ *          при наличии BMI2 и ADX, иначе `bignum_mul_u64_generic`.
+ *          Последующие вызовы передают управление выбранному ядру напрямую.
+ *          Старшие нулевые слова `a` не умножаются: длина результата всегда
+ *          точная (старшее слово ненулевое, кроме результата 0 с `len = 1`),
+ *          так что в цепочке `x = x * b_i` лишние слова не накапливаются.
+ *
  * @return bignum_mul_u64_status_t (0 в случае успеха, -1 в случае переполнения).
  */
 bignum_mul_u64_status_t bignum_mul_u64(bignum_t *res, const bignum_t *a, uint64_t b);
 
+/**
+ * @brief bignum_mul_u64 с отчетом о числе пропущенных старших нулевых слов `a`.
+ *
+ * @details Результат и статус — как у bignum_mul_u64. В `*skipped`
+ *          записывается `a->len` минус значащая длина `a`; при NULL в `res`
+ *          или `a` и при некорректной длине — 0. Позволяет найти источники
+ *          ненормализованных чисел, не замедляя bignum_mul_u64.
+ *
+ * @param[out] res     Указатель на структуру для хранения результата. Может совпадать с `a`.
+ * @param[in]  a       Указатель на множимое (bignum_t).
+ * @param[in]  b       Множитель (uint64_t).
+ * @param[out] skipped Число пропущенных слов или NULL.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_trim_count(bignum_t *res, const bignum_t *a, uint64_t b,
+                                                  size_t *skipped);
+
+/**
+ * @brief Слово переноса a * b без записи результата.
+ *
+ * @details Возвращает слово, которое bignum_mul_u64 допишет над значащими
+ *          словами `a` (0, если длина результата не растет). Обычно
+ *          определяется по старшему слову `a` за O(1); цепочка по всем
+ *          словам проходится, только если перенос из младших слов может
+ *          изменить ответ.
+ *
+ * @param[in] a Множимое. NULL и некорректная длина дают 0.
+ * @param[in] b Множитель.
+ *
+ * @return Старшее слово произведения над значащими словами `a`.
+ */
+uint64_t bignum_mul_u64_carry(const bignum_t *a, uint64_t b);
+
+/**
+ * @brief Помещается ли a * b в bignum_t.
+ *
+ * @details Ненулевой результат тогда и только тогда, когда
+ *          bignum_mul_u64(res, a, b) вернет BIGNUM_MUL_U64_SUCCESS. Если
+ *          значащая длина `a` меньше BIGNUM_CAPACITY, ответ сразу "да";
+ *          иначе он дается по битовым длинам старшего слова и `b`, и только
+ *          при их сумме, равной 65, нужен перенос (bignum_mul_u64_carry).
+ *
+ * @param[in] a Множимое.
+ * @param[in] b Множитель.
+ *
+ * @return 1, если произведение помещается; 0 — переполнение, NULL или
+ *         некорректная длина.
+ */
+int bignum_mul_u64_fits(const bignum_t *a, uint64_t b);
+
+/**
+ * @brief Умножение массива слов произвольной длины: dst[0..n-1] = младшие слова src * b.
+ *
+ * @details Ограничения BIGNUM_CAPACITY нет. Внутренний цикл — тот же, что у
+ *          bignum_mul_u64; ядро выбирается по CPUID так же. Начиная с длины,
+ *          при которой результат заметно больше LLC (порог определяется по
+ *          CPUID при первом вызове), запись идет мимо кэша (`movnti`).
+ *          Нормализации нет: пишутся ровно n слов.
+ *
+ * @param[out] dst Массив из n слов результата. Может совпадать с `src`.
+ * @param[in]  src Массив из n слов множимого (младшее слово первым).
+ * @param[in]  n   Число слов; при n == 0 обращений к памяти нет.
+ * @param[in]  b   Множитель.
+ *
+ * @return Слово переноса — старшее (n+1)-е слово произведения.
+ */
+uint64_t bignum_mul_u64_n(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b);
+
+/**
+ * @brief bignum_mul_u64_n, разделенная между потоками.
+ *
+ * @details Массив режется на непрерывные куски, выровненные по страницам
+ *          `dst`; каждый кусок умножается своим потоком с нулевым входным
+ *          переносом, затем вызывающий поток последовательно добавляет
+ *          перенос каждого куска к началу следующего. Поток куска t > 0
+ *          закреплен за t-м процессором маски affinity процесса (по модулю
+ *          их числа), а разбиение зависит только от (dst, n, threads):
+ *          при повторных вызовах кусок t пишет тот же процессор, что и при
+ *          первом касании (NUMA-локальность). Кусок 0 выполняет вызывающий
+ *          поток там, где он идет; его affinity не меняется. Потоки
+ *          создаются на каждый вызов; для частых вызовов —
+ *          bignum_mul_u64_n_parallel_pool. Число потоков уменьшается так,
+ *          чтобы на каждый пришлось не меньше 64 Ки слов; при одном потоке
+ *          или если поток не создается, работа выполняется вызывающим
+ *          потоком.
+ *
+ * @param[out] dst     Массив из n слов результата. Может совпадать с `src`.
+ * @param[in]  src     Массив из n слов множимого.
+ * @param[in]  n       Число слов.
+ * @param[in]  b       Множитель.
+ * @param[in]  threads Число потоков, включая вызывающий; 0 — по числу
+ *                     процессоров в сети.
+ *
+ * @return Слово переноса, как у bignum_mul_u64_n.
+ */
+uint64_t bignum_mul_u64_n_parallel(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b,
+                                   unsigned threads);
+
+/**
+ * @brief bignum_mul_u64_n с невременной записью при любой длине.
+ * @details Для результатов, к которым не вернутся, пока они в кэше.
+ */
+uint64_t bignum_mul_u64_n_nt(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b);
+
+/**
+ * @brief Переносы двух выходов bignum_mul_u64_n2.
+ * @details Возвращается по значению: на x86-64 (System V) и AArch64 — в паре
+ *          регистров (RAX:RDX, x0:x1), без записи в память.
+ */
+typedef struct {
+    uint64_t carry[2];
+} bignum_mul_u64_carry2_t;
+
+/**
+ * @brief Два произведения за один проход: dst[g][0..n-1] = src * b[g], g = 0, 1.
+ * @details Слово src читается один раз на оба выхода, у каждого свой
+ *          перенос. На BMI2/ADX выходы идут по двум цепочкам флагов
+ *          (`adcx`/`adox`). dst[0] или dst[1] может совпадать с src.
+ *          Основа bignum_mul_u64_fanout.
+ *
+ * @return Слова переноса обоих выходов, как у bignum_mul_u64_n.
+ */
+bignum_mul_u64_carry2_t bignum_mul_u64_n2(uint64_t *const dst[2], const uint64_t *src, size_t n,
+                                          const uint64_t b[2]);
+
+/**
+ * @brief Ядра bignum_mul_u64_n2 на `mul` (AArch64: `mul`/`umulh`) и на `mulx`/`adcx`/`adox`.
+ * @warning bignum_mul_u64_n2_mulx есть только на x86-64 и требует BMI2 и ADX.
+ */
+bignum_mul_u64_carry2_t bignum_mul_u64_n2_generic(uint64_t *const dst[2], const uint64_t *src, size_t n,
+                                                  const uint64_t b[2]);
+#if defined(__x86_64__)
+bignum_mul_u64_carry2_t bignum_mul_u64_n2_mulx(uint64_t *const dst[2], const uint64_t *src, size_t n,
+                                               const uint64_t b[2]);
+#endif
+
+/**
+ * @brief Ядра bignum_mul_u64_n на `mul` (AArch64: `mul`/`umulh`) и на `mulx`/`adcx`.
+ * @warning bignum_mul_u64_n_mulx есть только на x86-64 и требует BMI2 и ADX.
+ */
+uint64_t bignum_mul_u64_n_generic(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b);
+#if defined(__x86_64__)
+uint64_t bignum_mul_u64_n_mulx(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b);
+#endif
+
+/**
+ * @brief Базовое ядро bignum_mul_u64 на инструкции `mul`.
+ * @note   b == 0 и b == 1 обрабатываются без умножения во всех ядрах;
+ *         при b == 1 и res == a пишется только длина.
+ * @details Работает на любом x86-64. На AArch64 (`mul`/`umulh`) это
+ *          единственное ядро, и bignum_mul_u64 — тот же код. Семантика и
+ *          коды возврата совпадают с bignum_mul_u64.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_generic(bignum_t *res, const bignum_t *a, uint64_t b);
+
+#if defined(__x86_64__)
+/**
+ * @brief Ядро bignum_mul_u64 на инструкциях BMI2/ADX (`mulx`, `adcx`).
+ * @details Семантика и коды возврата совпадают с bignum_mul_u64.
+ * @warning Требует поддержки BMI2 и ADX процессором. Без нее вызов
+ *          приводит к исключению #UD (SIGILL).
+ */
+bignum_mul_u64_status_t bignum_mul_u64_mulx(bignum_t *res, const bignum_t *a, uint64_t b);
+#endif
+
+/**
+ * @brief bignum_mul_u64 без проверок аргументов для заранее проверенных операндов.
+ *
+ * @details Тот же ABI и та же диспетчеризация по CPUID, что у bignum_mul_u64,
+ *          но без проверок NULL и `a->len` и без быстрых путей b == 0 и
+ *          b == 1: ветвления есть только в управлении циклом и обработке
+ *          итогового переноса. bignum_mul_u64 после проверок выполняет это
+ *          же тело.
+ *
+ * @pre `res` и `a` не NULL.
+ * @pre 1 <= a->len <= BIGNUM_CAPACITY.
+ * @note При b == 0 результат — a->len нулевых слов (длина не нормализуется
+ *       к 1, в отличие от bignum_mul_u64). Старшие нулевые слова `a` не
+ *       отбрасываются: длина результата не меньше a->len.
+ *
+ * @param[out] res Указатель на структуру для хранения результата. Может совпадать с `a`.
+ * @param[in]  a   Указатель на множимое (bignum_t).
+ * @param[in]  b   Множитель (uint64_t).
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS или BIGNUM_MUL_U64_ERROR_OVERFLOW, если
+ *         при a->len == BIGNUM_CAPACITY остался перенос (`res->len` при этом
+ *         не меняется). При нарушении предусловий поведение не определено.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_unchecked(bignum_t *res, const bignum_t *a, uint64_t b);
+
+/**
+ * @brief Пакетное умножение: res[i] = a[i] * b[i] для i = 0..n-1.
+ *
+ * @details Указатели на массивы проверяются один раз на весь пакет, ядро
+ *          выбирается один раз, затем ядро вызывается для каждого элемента
+ *          подряд с программной предвыборкой следующего `bignum_t`.
+ *          Обрабатываются все n элементов, даже если часть из них
+ *          завершилась ошибкой. `res[i]` может совпадать с `a[i]`.
+ *
+ * @param[out] res        Массив из n результатов.
+ * @param[in]  a          Массив из n множимых.
+ * @param[in]  b          Массив из n множителей.
+ * @param[in]  n          Число элементов (0 допустим).
+ * @param[out] status_out Массив из n статусов по элементам или NULL.
+ *
+ * @return Статус первого неуспешного элемента, BIGNUM_MUL_U64_SUCCESS,
+ *         если все элементы успешны, или BIGNUM_MUL_U64_ERROR_NULL_ARG,
+ *         если при n > 0 `res`, `a` или `b` равен NULL.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_batch(bignum_t *res, const bignum_t *a, const uint64_t *b,
+                                             size_t n, bignum_mul_u64_status_t *status_out);
+
+/**
+ * @brief Пакетное умножение на общий множитель: res[i] = a[i] * b.
+ *
+ * @details То же, что bignum_mul_u64_batch, но с одним множителем
+ *          для всех элементов.
+ *
+ * @param[out] res        Массив из n результатов.
+ * @param[in]  a          Массив из n множимых.
+ * @param[in]  b          Общий множитель.
+ * @param[in]  n          Число элементов (0 допустим).
+ * @param[out] status_out Массив из n статусов по элементам или NULL.
+ *
+ * @return Статус первого неуспешного элемента, BIGNUM_MUL_U64_SUCCESS,
+ *         если все элементы успешны, или BIGNUM_MUL_U64_ERROR_NULL_ARG,
+ *         если при n > 0 `res` или `a` равен NULL.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_batch_scalar(bignum_t *res, const bignum_t *a, uint64_t b,
+                                                    size_t n, bignum_mul_u64_status_t *status_out);
+
+/**
+ * @brief Скалярный цикл пакетных функций (ядро bignum_mul_u64 на элемент).
+ * @details Семантика совпадает с bignum_mul_u64_batch /
+ *          bignum_mul_u64_batch_scalar. Экспортируется для сравнения с
+ *          векторным движком.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_batch_generic(bignum_t *res, const bignum_t *a, const uint64_t *b,
+                                                     size_t n, bignum_mul_u64_status_t *status_out);
+bignum_mul_u64_status_t bignum_mul_u64_batch_scalar_generic(bignum_t *res, const bignum_t *a, uint64_t b,
+                                                            size_t n, bignum_mul_u64_status_t *status_out);
+
+#if defined(__x86_64__)
+/**
+ * @brief Пакетный движок на AVX-512 IFMA (`vpmadd52luq`/`vpmadd52huq`).
+ *
+ * @details Обрабатывает по 8 элементов одновременно в транспонированной
+ *          раскладке (слово k восьми чисел — в одном zmm) с основанием 2^52.
+ *          Группы с разной длиной или с b == 0 и остаток n mod 8 идут
+ *          через скалярное ядро. Семантика, статусы и `res->len` совпадают
+ *          с bignum_mul_u64_batch_generic; `res[i]` может совпадать только
+ *          с `a[i]` (массивы не должны перекрываться со сдвигом).
+ *
+ *          Диспетчер bignum_mul_u64_batch выбирает этот движок, только
+ *          если библиотека собрана с `IFMA=1`.
+ *
+ * @warning Требует AVX-512F и AVX-512 IFMA. Без них вызов приводит к
+ *          исключению #UD (SIGILL).
+ */
+bignum_mul_u64_status_t bignum_mul_u64_batch_ifma(bignum_t *res, const bignum_t *a, const uint64_t *b,
+                                                  size_t n, bignum_mul_u64_status_t *status_out);
+bignum_mul_u64_status_t bignum_mul_u64_batch_scalar_ifma(bignum_t *res, const bignum_t *a, uint64_t b,
+                                                         size_t n, bignum_mul_u64_status_t *status_out);
+#endif
+
+/**
+ * @brief Пакет чисел в раскладке "структура массивов" (SoA, limb-major).
+ *
+ * @details Слово k числа i хранится в `words[k * stride + i]`: слово k всех
+ *          чисел образует один слой, `stride` кратен 8, поэтому каждый слой
+ *          начинается на границе 64 байт и занимает целое число строк кэша.
+ *          Память выделяет bignum_batch_init, освобождает bignum_batch_free.
+ *
+ *          Инвариант, который поддерживают все функции пакета: слова числа i
+ *          выше `len[i]` нулевые, слои с номером >= `rows` нулевые у всех
+ *          чисел, `len[i] <= rows <= BIGNUM_CAPACITY`. Поля можно читать
+ *          напрямую; при записи инвариант сохраняет вызывающий код.
+ */
+typedef struct {
+    uint64_t *words;  /**< BIGNUM_CAPACITY слоев по `stride` слов, выровнено на 64 байта. */
+    size_t   *len;    /**< Длины чисел, `count` элементов, выровнено на 64 байта. */
+    size_t    count;  /**< Число чисел в пакете. */
+    size_t    stride; /**< Шаг слоя в словах: `count`, округленное вверх до кратного 8. */
+    size_t    rows;   /**< Число слоев, которые могут быть ненулевыми. */
+} bignum_batch_t;
+
+/**
+ * @brief Выделяет обнуленный пакет на `count` чисел (все `len[i] = 0`).
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_NOMEM. При `count == 0` память не выделяется.
+ */
+bignum_mul_u64_status_t bignum_batch_init(bignum_batch_t *batch, size_t count);
+
+/**
+ * @brief Освобождает память пакета и обнуляет структуру. NULL допустим.
+ */
+void bignum_batch_free(bignum_batch_t *batch);
+
+/**
+ * @brief Упаковывает `src[0..n-1]` в пакет; числа `n..count-1` становятся нулями с `len = 0`.
+ *
+ * @details Длины читаются так же, как в bignum_mul_u64 (младшие 32 бита со
+ *          знаком). Слова `src[i]` выше длины не читаются.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW, если `n > count` или длина одного из
+ *         чисел некорректна (пакет в этом случае не меняется).
+ */
+bignum_mul_u64_status_t bignum_batch_pack(bignum_batch_t *batch, const bignum_t *src, size_t n);
+
+/**
+ * @brief Распаковывает числа `0..n-1` пакета в `dst[0..n-1]`.
+ *
+ * @details Пишутся `dst[i].len` и слова до длины; слова выше длины не трогаются.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW, если `n > count`.
+ */
+bignum_mul_u64_status_t bignum_batch_unpack(const bignum_batch_t *batch, bignum_t *dst, size_t n);
+
+/**
+ * @brief Пакетное умножение в раскладке SoA: res[i] = a[i] * b[i].
+ *
+ * @details Проходит слои 0..`a->rows`-1 для всех чисел сразу: соседние
+ *          умножения относятся к разным числам и не связаны переносом, а
+ *          чтение и запись идут подряд по слою. Поэлементная семантика и
+ *          статусы совпадают с bignum_mul_u64: 0 и `b[i] == 0` дают 0 с
+ *          `len = 1`. Отличие одно: при переполнении в числе остаются
+ *          младшие BIGNUM_CAPACITY слов произведения с `len =
+ *          BIGNUM_CAPACITY` (иначе нарушился бы инвариант пакета).
+ *          `res` может совпадать с `a`.
+ *
+ * @param[out] res        Пакет результата с тем же `count`, что и `a`.
+ * @param[in]  a          Пакет множимых.
+ * @param[in]  b          Массив из `count` множителей.
+ * @param[out] status_out Массив из `count` статусов или NULL.
+ *
+ * @return Первый неуспешный статус элемента, BIGNUM_MUL_U64_SUCCESS,
+ *         BIGNUM_MUL_U64_ERROR_NULL_ARG или BIGNUM_MUL_U64_ERROR_OVERFLOW,
+ *         если `count` пакетов различается или `a` нарушает инвариант
+ *         (тогда `res` не меняется).
+ */
+bignum_mul_u64_status_t bignum_mul_u64_batch_soa(bignum_batch_t *res, const bignum_batch_t *a,
+                                                 const uint64_t *b, bignum_mul_u64_status_t *status_out);
+
+/** @brief Слоты пула дополняются до кратного 128 байтам (пары строк кэша). */
+#define BIGNUM_POOL_PADDED 1u
+
+/**
+ * @brief Пул bignum_t с выровненными по строке кэша слотами.
+ *
+ * @details Слоты нарезаются из блоков памяти (арены), выровненных на 64
+ *          байта; шаг слота — sizeof(bignum_t), округленный вверх до
+ *          кратного 64, так что каждое число начинается с новой строки и
+ *          соседние числа не делят строк. С флагом BIGNUM_POOL_PADDED шаг
+ *          кратен 128, а блоки и слоты выровнены на 128: пространственная
+ *          предвыборка, которая тянет строки парами, тоже не задевает
+ *          соседний слот. Освобожденные слоты
+ *          идут в список свободных; когда свободных нет, выделяется новый
+ *          блок. Пул не потокобезопасен: по пулу на поток.
+ */
+typedef struct {
+    void          *chunks;     /**< Список блоков арены. */
+    void          *free;       /**< Список освобожденных слотов. */
+    unsigned char *next;       /**< Первый ни разу не выданный слот текущего блока. */
+    unsigned char *end;        /**< Конец текущего блока. */
+    size_t         stride;     /**< Шаг слота в байтах, кратен 64. */
+    size_t         per_chunk;  /**< Слотов в блоке. */
+} bignum_pool_t;
+
+/**
+ * @brief Создает пул; первый блок — на `count` слотов (0 — на одну страницу).
+ * @param[in] flags 0 или BIGNUM_POOL_PADDED.
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_NOMEM.
+ */
+bignum_mul_u64_status_t bignum_pool_init(bignum_pool_t *pool, size_t count, unsigned flags);
+
+/**
+ * @brief Освобождает все блоки пула и обнуляет структуру. NULL допустим.
+ * @details Слоты, не возвращенные через bignum_pool_free, тоже освобождаются.
+ */
+void bignum_pool_destroy(bignum_pool_t *pool);
+
+/**
+ * @brief Выдает слот: число 0 (`len = 0`, слова нулевые), адрес кратен 64.
+ * @return Слот или NULL (NULL в `pool` или нет памяти на новый блок).
+ */
+bignum_t *bignum_pool_alloc(bignum_pool_t *pool);
+
+/**
+ * @brief Возвращает слот в пул. NULL в `x` допустим.
+ * @pre `x` выдан bignum_pool_alloc этого же пула и еще не возвращен.
+ */
+void bignum_pool_free(bignum_pool_t *pool, bignum_t *x);
+
+/**
+ * @brief Пул рабочих потоков для асинхронных пакетов (непрозрачный тип).
+ *
+ * @details Каждый рабочий держит свой дек кусков пакета (Chase-Lev,
+ *          без блокировок); простаивающие рабочие крадут куски у занятых.
+ *          Кусок — вызов bignum_mul_u64_batch на отрезке около 32 КиБ
+ *          операндов. Функции пула можно вызывать из любых потоков.
+ */
+typedef struct bignum_mul_u64_pool bignum_mul_u64_pool_t;
+
+/** @brief Дескриптор отправленного пакета (непрозрачный тип). */
+typedef struct bignum_mul_u64_job bignum_mul_u64_job_t;
+
+/**
+ * @brief Обратный вызов завершения пакета.
+ * @details Вызывается ровно один раз в рабочем потоке, выполнившем последний
+ *          кусок (при `n == 0` — в отправляющем потоке), со статусом пакета.
+ *          Может отправлять новые пакеты; ждать пакеты в нем нельзя.
+ */
+typedef void (*bignum_mul_u64_done_fn)(void *arg, bignum_mul_u64_status_t status);
+
+/**
+ * @brief Создает пул из `nthreads` рабочих потоков (0 — все процессоры в сети).
+ * @return Пул или NULL, если не удалось выделить память или создать ни
+ *         одного потока. Если создана только часть потоков, пул работает с ними.
+ */
+bignum_mul_u64_pool_t *bignum_mul_u64_pool_create(unsigned nthreads);
+
+/**
+ * @brief Дожидается всех отправленных пакетов, останавливает потоки и
+ *        освобождает пул. NULL допустим.
+ * @pre Все дескрипторы пакетов уже переданы в bignum_mul_u64_wait или будут
+ *      переданы до разрушения пула: после него пакеты ждать нельзя.
+ */
+void bignum_mul_u64_pool_destroy(bignum_mul_u64_pool_t *pool);
+
+/**
+ * @brief Асинхронно выполняет res[i] = a[i] * b[i] для i = 0..n-1 на пуле.
+ *
+ * @details Поэлементная семантика, `status_out` и итоговый статус совпадают
+ *          с bignum_mul_u64_batch. Массивы должны оставаться доступными до
+ *          завершения пакета. Пакеты выполняются в порядке отправки лишь
+ *          приблизительно: порядок завершения не гарантирован.
+ *
+ * @param[in]  pool       Пул.
+ * @param[out] res        Массив из n результатов.
+ * @param[in]  a          Массив из n множимых.
+ * @param[in]  b          Массив из n множителей.
+ * @param[in]  n          Число элементов (0 допустим).
+ * @param[out] status_out Массив из n статусов по элементам или NULL.
+ * @param[in]  done_fn    Обратный вызов завершения или NULL.
+ * @param[in]  done_arg   Первый аргумент done_fn.
+ * @param[out] job_out    Дескриптор для bignum_mul_u64_poll/bignum_mul_u64_wait
+ *                        или NULL: тогда пакет освобождается сам после done_fn.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, если пакет принят (статус самого пакета
+ *         приходит в done_fn и bignum_mul_u64_wait),
+ *         BIGNUM_MUL_U64_ERROR_NULL_ARG, если `pool` равен NULL или при n > 0
+ *         `res`, `a` или `b` равен NULL, или BIGNUM_MUL_U64_ERROR_NOMEM. При
+ *         ошибке пакет не отправлен, done_fn не вызывается, `*job_out` = NULL.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_submit(bignum_mul_u64_pool_t *pool, bignum_t *res, const bignum_t *a,
+                                              const uint64_t *b, size_t n, bignum_mul_u64_status_t *status_out,
+                                              bignum_mul_u64_done_fn done_fn, void *done_arg,
+                                              bignum_mul_u64_job_t **job_out);
+
+/**
+ * @brief Проверяет без ожидания, завершен ли пакет.
+ * @return Ненулевое значение, если пакет завершен и done_fn уже вернулся.
+ *         Дескриптор остается действительным до bignum_mul_u64_wait.
+ */
+int bignum_mul_u64_poll(const bignum_mul_u64_job_t *job);
+
+/**
+ * @brief Ждет завершения пакета и освобождает дескриптор.
+ * @details Для каждого дескриптора вызывается ровно один раз.
+ * @return Статус пакета (как у bignum_mul_u64_batch) или
+ *         BIGNUM_MUL_U64_ERROR_NULL_ARG, если `pool` или `job` равен NULL.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_wait(bignum_mul_u64_pool_t *pool, bignum_mul_u64_job_t *job);
+
+/**
+ * @brief bignum_mul_u64_n, разделенная между рабочими пула.
+ *
+ * @details Результат и перенос — как у bignum_mul_u64_n_parallel, но куски
+ *          выполняют уже запущенные рабочие `pool`, так что вызов не
+ *          создает потоков. Кусков столько, сколько рабочих, но не меньше
+ *          16 Ки слов на кусок; границы выровнены по строкам `dst`. Куски
+ *          идут через общую очередь и кражу работы, поэтому кусок не
+ *          привязан к рабочему: первого касания по разбиению здесь нет.
+ *          Вызов синхронный: вызывающий поток ждет куски и добавляет
+ *          переносы. При пустом `pool`, одном куске или нехватке памяти
+ *          работа выполняется вызывающим потоком.
+ * @warning Нельзя вызывать из обратного вызова done_fn пула `pool`.
+ *
+ * @param[in]  pool Пул или NULL.
+ * @param[out] dst  Массив из n слов результата. Может совпадать с `src`.
+ * @param[in]  src  Массив из n слов множимого.
+ * @param[in]  n    Число слов.
+ * @param[in]  b    Множитель.
+ *
+ * @return Слово переноса, как у bignum_mul_u64_n.
+ */
+uint64_t bignum_mul_u64_n_parallel_pool(bignum_mul_u64_pool_t *pool, uint64_t *dst, const uint64_t *src,
+                                        size_t n, uint64_t b);
+
+/**
+ * @brief Умножение с накоплением: res = res + a * b.
+ *
+ * @details Аналог GMP `mpn_addmul_1`: умножение и сложение выполняются
+ *          за один проход по словам `a`, без временного bignum_t.
+ *          Длина результата — max(res->len, a->len) плюс, возможно, слово
+ *          переноса. Ядро выбирается по CPUID так же, как для bignum_mul_u64.
+ *
+ * @param[in,out] res Аккумулятор. Может совпадать с `a`.
+ * @param[in]     a   Множимое.
+ * @param[in]     b   Множитель.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW, если результат не помещается в
+ *         BIGNUM_CAPACITY слов (или длина операнда некорректна).
+ */
+bignum_mul_u64_status_t bignum_mul_add_u64(bignum_t *res, const bignum_t *a, uint64_t b);
+
+/**
+ * @brief Умножение с вычитанием: res = res - a * b.
+ *
+ * @details Аналог GMP `mpn_submul_1`. Старшие нулевые слова результата
+ *          отбрасываются из длины.
+ *
+ * @param[in,out] res Уменьшаемое. Может совпадать с `a`.
+ * @param[in]     a   Множимое.
+ * @param[in]     b   Множитель.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG,
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW при некорректной длине операнда или
+ *         BIGNUM_MUL_U64_ERROR_UNDERFLOW, если a * b > res (содержимое
+ *         `res->words` при этом не определено).
+ */
+bignum_mul_u64_status_t bignum_mul_sub_u64(bignum_t *res, const bignum_t *a, uint64_t b);
+
+/**
+ * @brief Умножение на 128-битный множитель: res = a * (b_hi * 2^64 + b_lo).
+ *
+ * @details Один проход по словам `a`: каждое слово читается один раз и
+ *          умножается на обе половины множителя, вместо двух проходов
+ *          bignum_mul_u64 и сложения. На BMI2/ADX сложения идут по двум
+ *          цепочкам переносов (`adcx`/`adox`). Результат занимает до
+ *          a->len + 2 слов, длина точная; a == 0 или b == 0 дает 0 с
+ *          `len = 1`. Ядро выбирается по CPUID так же, как для bignum_mul_u64.
+ *
+ * @param[out] res  Результат. Может совпадать с `a`.
+ * @param[in]  a    Множимое.
+ * @param[in]  b_lo Младшее слово множителя.
+ * @param[in]  b_hi Старшее слово множителя.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW, если результат не помещается в
+ *         BIGNUM_CAPACITY слов (или длина `a` некорректна); при
+ *         переполнении `res->len` не меняется, а слова `res` испорчены.
+ */
+bignum_mul_u64_status_t bignum_mul_u128(bignum_t *res, const bignum_t *a, uint64_t b_lo, uint64_t b_hi);
+
+/**
+ * @brief Ядра bignum_mul_u128 на `mul` (AArch64: `mul`/`umulh`) и на `mulx`/`adcx`/`adox`.
+ * @warning bignum_mul_u128_mulx есть только на x86-64 и требует BMI2 и ADX.
+ */
+bignum_mul_u64_status_t bignum_mul_u128_generic(bignum_t *res, const bignum_t *a, uint64_t b_lo, uint64_t b_hi);
+#if defined(__x86_64__)
+bignum_mul_u64_status_t bignum_mul_u128_mulx(bignum_t *res, const bignum_t *a, uint64_t b_lo, uint64_t b_hi);
+#endif
+
+/**
+ * @brief Произведение на цепочку множителей: res = a * b[0] * ... * b[k-1].
+ *
+ * @details Множители подряд перемножаются в слове, пока их произведение в
+ *          него помещается (по битовым длинам, `lzcnt`), и на каждую такую
+ *          группу делается один проход bignum_mul_u64 вместо прохода на
+ *          каждый множитель. Переполнение по оценке битовой длины
+ *          результата обнаруживается до первого прохода. Множитель 0 дает
+ *          0 с `len = 1`, k == 0 — копию `a`.
+ *
+ * @param[out] res Результат. Может совпадать с `a`; при ошибке не меняется.
+ * @param[in]  a   Множимое.
+ * @param[in]  b   Множители (может быть NULL при k == 0).
+ * @param[in]  k   Число множителей.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW, если произведение не помещается в
+ *         BIGNUM_CAPACITY слов (или длина `a` некорректна).
+ */
+bignum_mul_u64_status_t bignum_mul_u64_chain(bignum_t *res, const bignum_t *a, const uint64_t *b, size_t k);
+
+/**
+ * @brief Одно множимое на несколько множителей: res[j] = a * b[j] для j = 0..k-1.
+ *
+ * @details `a` проверяется и сокращается до значащей длины один раз.
+ *          Выходы обрабатываются парами (bignum_mul_u64_n2): слово `a`
+ *          читается один раз на пару, у каждого выхода своя цепочка
+ *          переносов, и цепочки пары идут параллельно. Нечетный последний
+ *          выход — проход bignum_mul_u64_n. Длины результатов точные, как у
+ *          bignum_mul_u64; b[j] == 0 или a == 0 дает 0 с `len = 1`.
+ *
+ * @param[out] res Результаты; попарно различны, любой может совпадать с `a`.
+ * @param[in]  a   Множимое.
+ * @param[in]  b   Множители.
+ * @param[in]  k   Число множителей (res и b могут быть NULL при k == 0).
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG (NULL среди
+ *         аргументов или в res[0..k-1]; ничего не записано) или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW: длина `a` некорректна (ничего не
+ *         записано) либо какое-то произведение не помещается в
+ *         BIGNUM_CAPACITY слов — у такого выхода `len` не меняется, а
+ *         слова испорчены; остальные выходы записаны.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_fanout(bignum_t *res[], const bignum_t *a, const uint64_t *b, size_t k);
+
+/**
+ * @brief Контекст умножения по фиксированному модулю m.
+ *
+ * @details Заполняется bignum_mul_u64_mod_init и далее только читается, так
+ *          что один контекст можно использовать из нескольких потоков.
+ *          Хранит копию модуля, нормализующий сдвиг и обратную величину
+ *          двух старших слов нормализованного модуля (константу Барретта
+ *          для деления 3 слов на 2).
+ */
+typedef struct {
+    uint64_t m[BIGNUM_CAPACITY]; /**< Слова модуля (значащие). */
+    size_t   len;                /**< Значащая длина модуля. */
+    unsigned shift;              /**< Сдвиг, после которого старший бит модуля — единица. */
+    uint64_t d1;                 /**< Старшее слово m << shift. */
+    uint64_t d0;                 /**< Следующее слово m << shift (0 при len == 1). */
+    uint64_t dinv;               /**< floor((2^192 - 1) / (d1:d0)) - 2^64. */
+} bignum_mul_u64_mod_ctx_t;
+
+/**
+ * @brief Готовит контекст умножения по модулю m.
+ *
+ * @param[out] ctx Контекст.
+ * @param[in]  m   Модуль; старшие нулевые слова допустимы.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG,
+ *         BIGNUM_MUL_U64_ERROR_DOMAIN при m == 0 или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW при некорректной длине.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_mod_init(bignum_mul_u64_mod_ctx_t *ctx, const bignum_t *m);
+
+/**
+ * @brief Умножение по модулю: res = (a * b) mod m.
+ *
+ * @details При a < m частное (a * b) / m помещается в слово и оценивается
+ *          по старшим словам до прохода, так что умножение и приведение —
+ *          один проход a * b - q * m в общей цепочке переносов вместо
+ *          умножения и деления. Проход сложения или вычитания m для
+ *          исправления оценки нужен с вероятностью порядка 2^-64.
+ *          Результат нормализован.
+ *
+ * @param[out] res Результат. Может совпадать с `a`; при ошибке не меняется.
+ * @param[in]  a   Множимое, приведенное по модулю: a < m.
+ * @param[in]  b   Множитель (любой).
+ * @param[in]  ctx Контекст модуля из bignum_mul_u64_mod_init.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG,
+ *         BIGNUM_MUL_U64_ERROR_DOMAIN при a >= m или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW при некорректной длине `a`.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_mod(bignum_t *res, const bignum_t *a, uint64_t b,
+                                           const bignum_mul_u64_mod_ctx_t *ctx);
+
+/**
+ * @brief Разбирает десятичную строку в bignum_t.
+ *
+ * @details Цифры берутся группами по 19 (10^19 < 2^64): группа собирается в
+ *          слово (16 цифр — параллельно, SSE2 или SWAR), и число
+ *          обновляется одним проходом res = res * 10^19 + группа. Знак,
+ *          пробелы и разделители не допускаются; ведущие нули допустимы и
+ *          не влияют на длину. Результат нормализован, 0 — `len = 1`.
+ *
+ * @param[out] res Результат; при ошибке не меняется.
+ * @param[in]  s   Цифры, старшая первой; завершающий ноль не нужен.
+ * @param[in]  n   Число символов.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG,
+ *         BIGNUM_MUL_U64_ERROR_INVALID_DIGIT (n == 0 или символ не цифра)
+ *         или BIGNUM_MUL_U64_ERROR_OVERFLOW, если число не помещается в
+ *         BIGNUM_CAPACITY слов. Возвращается первая найденная ошибка.
+ */
+bignum_mul_u64_status_t bignum_from_decimal(bignum_t *res, const char *s, size_t n);
+
+/**
+ * @brief Разбирает строку цифр основания radix (2..36) в bignum_t.
+ *
+ * @details Как bignum_from_decimal, с группами по k цифр, где radix^k —
+ *          наибольшая степень, помещающаяся в слово (из таблицы). Цифры
+ *          старше 9 — буквы `a`-`z` в любом регистре. При radix == 10 — то
+ *          же, что bignum_from_decimal.
+ *
+ * @return Как у bignum_from_decimal; BIGNUM_MUL_U64_ERROR_INVALID_DIGIT
+ *         также при radix вне 2..36 и при цифре не меньше radix.
+ */
+bignum_mul_u64_status_t bignum_from_radix(bignum_t *res, const char *s, size_t n, unsigned radix);
+
+/**
+ * @brief Классы множителя в счетчиках bignum_mul_u64.
+ * @details Класс — первый подходящий: 0, 1, степень двойки, меньше 2^32,
+ *          остальные.
+ */
+typedef enum {
+    BIGNUM_MUL_U64_STATS_B_ZERO = 0,
+    BIGNUM_MUL_U64_STATS_B_ONE,
+    BIGNUM_MUL_U64_STATS_B_POW2,
+    BIGNUM_MUL_U64_STATS_B_SMALL,
+    BIGNUM_MUL_U64_STATS_B_FULL,
+    BIGNUM_MUL_U64_STATS_B_CLASSES
+} bignum_mul_u64_stats_class_t;
+
+/**
+ * @brief Счетчики вызовов bignum_mul_u64, сумма по всем потокам.
+ *
+ * @details Считаются вызовы публичной bignum_mul_u64 (и
+ *          bignum_mul_u64_trim_count, и C-функций библиотеки, которые ее
+ *          вызывают); пакетные функции и ядра `_generic`/`_mulx` идут мимо
+ *          счетчиков. Длина и класс множителя учитываются, только если `res`
+ *          и `a` не NULL.
+ */
+typedef struct {
+    uint64_t calls;                                        /**< Все вызовы. */
+    uint64_t len[BIGNUM_CAPACITY + 1];                     /**< По `a->len` на входе. */
+    uint64_t len_invalid;                                  /**< `a->len` < 0 или > BIGNUM_CAPACITY. */
+    uint64_t multiplier[BIGNUM_MUL_U64_STATS_B_CLASSES];   /**< По классу `b`. */
+    uint64_t aliased;                                      /**< `res == a`. */
+    uint64_t null_arg;                                     /**< Возвраты BIGNUM_MUL_U64_ERROR_NULL_ARG. */
+    uint64_t overflow;                                     /**< Возвраты BIGNUM_MUL_U64_ERROR_OVERFLOW. */
+    uint64_t threads;                                      /**< Потоков, вызывавших bignum_mul_u64. */
+} bignum_mul_u64_stats_t;
+
+/**
+ * @brief Снимок счетчиков bignum_mul_u64 по всем потокам.
+ *
+ * @details Счетчики есть только в сборке CONFIG=stats (макрос
+ *          BIGNUM_MUL_U64_STATS, yasm `-D STATS`): у каждого потока свой
+ *          блок, и горячий путь пишет в него без атомарных RMW и без
+ *          блокировок. Блоки завершившихся потоков складываются в общий
+ *          итог. Снимок суммирует блоки под мьютексом регистрации; счетчики
+ *          потоков, которые в этот момент умножают, могут отставать на
+ *          несколько вызовов. При выходе из процесса итог печатается в файл
+ *          из переменной окружения `BIGNUM_MUL_U64_STATS` (по умолчанию — в
+ *          stderr). В остальных сборках счетчиков и накладных расходов нет.
+ *
+ * @param[out] out Снимок; без счетчиков в сборке — нули.
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_DOMAIN, если библиотека собрана без счетчиков.
+ */
+bignum_mul_u64_status_t bignum_mul_u64_stats_snapshot(bignum_mul_u64_stats_t *out);
+
 #ifdef __cplusplus
 }
 #endif
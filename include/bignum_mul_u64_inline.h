@@ -0,0 +1,127 @@
+/**
+ * @file    bignum_mul_u64_inline.h
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Встраиваемая (header-only) реализация bignum_mul_u64.
+ *
+ * @details
+ *   Ассемблерное ядро недоступно компилятору: его нельзя встроить в место
+ *   вызова, подставить константный множитель или выбросить проверки,
+ *   которые вызывающий код уже гарантирует. Для операндов в 1–2 слова
+ *   сам вызов дороже работы. `bignum_mul_u64_inline` — `static inline`
+ *   версия на `unsigned __int128`, которую компилятор встраивает и
+ *   оптимизирует вместе с окружающим кодом (в том числе при LTO).
+ *   Умножение 64x64->128 компилятор сводит к `mul` (или к `mulx` при
+ *   -mbmi2), поэтому интринсики не нужны.
+ *
+ *   Семантика повторяет ассемблерное ядро полностью:
+ *   - NULL в `res` или `a` — BIGNUM_MUL_U64_ERROR_NULL_ARG;
+ *   - `a->len` читается по младшим 32 битам со знаком, как `movsxd`;
+ *     отрицательная длина или длина больше BIGNUM_CAPACITY —
+ *     BIGNUM_MUL_U64_ERROR_OVERFLOW;
+ *   - старшие нулевые слова `a` отбрасываются из длины до умножения,
+ *     поэтому длина результата точная;
+ *   - `a->len == 0`, все слова `a` нулевые или `b == 0` — результат 0 с
+ *     `len = 1`;
+ *   - `b == 1` — копия `a` (при `res == a` пишется только `len`);
+ *   - перенос из старшего слова при `len == BIGNUM_CAPACITY` —
+ *     BIGNUM_MUL_U64_ERROR_OVERFLOW; слова `res` при этом уже записаны,
+ *     `res->len` не меняется;
+ *   - слова `res` выше длины результата не трогаются.
+ *   Отличие одно: `res->len` записывается целиком, а не младшим двойным
+ *   словом, что совпадает с ядром для любого корректного bignum_t.
+ *
+ * @see     bignum_mul_u64.h
+ * @since   1.0.0
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Длина a сокращается до значащей, как в ядре.
+ */
+
+#ifndef BIGNUM_MUL_U64_INLINE_H
+#define BIGNUM_MUL_U64_INLINE_H
+
+#include "bignum_mul_u64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+__extension__ typedef unsigned __int128 bignum_mul_u64_u128_t;
+
+/**
+ * @brief Встраиваемый вариант bignum_mul_u64 с той же семантикой.
+ *
+ * @param[out] res Указатель на структуру для хранения результата. Может совпадать с `a`.
+ * @param[in]  a   Указатель на множимое (bignum_t).
+ * @param[in]  b   Множитель (uint64_t).
+ *
+ * @return BIGNUM_MUL_U64_SUCCESS, BIGNUM_MUL_U64_ERROR_NULL_ARG или
+ *         BIGNUM_MUL_U64_ERROR_OVERFLOW — как у bignum_mul_u64.
+ */
+static inline bignum_mul_u64_status_t bignum_mul_u64_inline(bignum_t *res, const bignum_t *a, uint64_t b) {
+    if (res == NULL || a == NULL) {
+        return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    }
+
+    // Как `movsxd rcx, dword [a->len]` в ядре
+    int64_t len = (int32_t)(uint32_t)a->len;
+    if (len <= 0) {
+        if (len < 0) {
+            return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        }
+        res->words[0] = 0;
+        res->len = 1;
+        return BIGNUM_MUL_U64_SUCCESS;
+    }
+    if (len > BIGNUM_CAPACITY) {
+        return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    }
+
+    // Старшие нулевые слова не умножаются и не входят в длину результата
+    while (len > 0 && a->words[len - 1] == 0) {
+        --len;
+    }
+
+    if (len == 0 || b == 0) {
+        res->words[0] = 0;
+        res->len = 1;
+        return BIGNUM_MUL_U64_SUCCESS;
+    }
+
+    if (b == 1) {
+        if (res != a) {
+            for (int64_t i = 0; i < len; ++i) {
+                res->words[i] = a->words[i];
+            }
+        }
+        res->len = (size_t)len;
+        return BIGNUM_MUL_U64_SUCCESS;
+    }
+
+    // Слово i читается до записи res->words[i], поэтому res может совпадать с a
+    uint64_t carry = 0;
+    for (int64_t i = 0; i < len; ++i) {
+        bignum_mul_u64_u128_t p = (bignum_mul_u64_u128_t)a->words[i] * b + carry;
+        res->words[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+
+    if (carry != 0) {
+        if (len >= BIGNUM_CAPACITY) {
+            return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        }
+        res->words[len++] = carry;
+    }
+    res->len = (size_t)len;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIGNUM_MUL_U64_INLINE_H */
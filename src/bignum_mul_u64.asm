@@ -12,14 +12,46 @@
 ;   - rev. 3 (01.08.2025): Добавлена проверка границ для `a->len` для
 ;                         предотвращения переполнения буфера (stack smashing).
 ;                         Восстановлена полная документация.
+;   - rev. 4 (14.10.2026): Добавлено ядро на BMI2/ADX (`mulx`/`adcx`) и
+;                         диспетчеризация по CPUID. Исходная реализация
+;                         экспортирована как `bignum_mul_u64_generic`.
+;   - rev. 5 (14.10.2026): Основной цикл обоих ядер развернут в 4 раза
+;                         с вычисляемым входом и одним отрицательным индексом.
+;   - rev. 6 (14.10.2026): Ядра переведены на caller-saved регистры; кадр
+;                         стека создается только в debug-сборке.
+;   - rev. 7 (14.10.2026): Добавлены пакетные функции bignum_mul_u64_batch и
+;                         bignum_mul_u64_batch_scalar.
+;   - rev. 8 (14.10.2026): Добавлены bignum_mul_add_u64 и bignum_mul_sub_u64
+;                         (умножение с накоплением за один проход).
+;   - rev. 9 (14.10.2026): Быстрый путь для b == 1.
+;   - rev. 10 (14.10.2026): Емкость BIGNUM_CAPACITY задается при сборке;
+;                         при малой емкости тело разворачивается полностью.
+;   - rev. 11 (14.10.2026): Добавлена bignum_mul_u64_unchecked; проверяющие
+;                         ядра переходят в ее тело после проверок.
+;   - rev. 12 (14.10.2026): Пакетные функции диспетчеризуются; при сборке с
+;                         BATCH_IFMA выбирается движок на AVX-512 IFMA.
+;   - rev. 13 (14.10.2026): Старшие нулевые слова a не умножаются, длина
+;                         результата точная; добавлена bignum_mul_u64_trim_count.
+;   - rev. 14 (14.10.2026): Добавлена bignum_mul_u64_n на массивах слов
+;                         произвольной длины с невременной записью для
+;                         больших n; тело развертки параметризовано.
+;   - rev. 15 (14.10.2026): Добавлена bignum_mul_u128 (множитель из двух
+;                         слов, один проход, ядра на `mul` и `mulx`).
+;   - rev. 16 (14.10.2026): Добавлена bignum_mul_u64_n2 (два множителя за
+;                         один проход по массиву слов).
+;   - rev. 17 (14.10.2026): Сборка со счетчиками (-D STATS): bignum_mul_u64
+;                         передает вызов bignum_mul_u64_stats_call.
 ; -----------------------------------------------------------------------------
 
 section .text
 
 ; =============================================================================
-; @brief Умножает большое число (bignum_t) на 64-битное целое.
+; @brief Базовое ядро: умножает bignum_t на uint64_t через `mul`.
 ;
 ; @details
+; Работает на любом x86-64. Используется диспетчером `bignum_mul_u64`
+; на процессорах без BMI2/ADX.
+;
 ; **Протокол вызова (System V AMD64 ABI):**
 ;   - RDI: bignum_t *res (указатель на результат)
 ;   - RSI: const bignum_t *a (указатель на множимое)
@@ -30,28 +62,46 @@ section .text
 ; 1.  Проверка на NULL для `res` и `a`. Если любой из них NULL, возврат -1.
 ; 2.  Проверка корректности `a->len`. Если `len <= 0` или `len > BIGNUM_CAPACITY`,
 ;     возврат -1 для предотвращения переполнения буфера.
+; 2а. Сокращение длины: пока старшее слово `a` нулевое, len уменьшается
+;     (TRIM_PATH). Если нулевые все слова, результат — 0. Длина результата
+;     поэтому всегда точная, и цепочка `x = x * b_i` не умножает нули.
 ; 3.  Проверка тривиального случая: если множитель `b` (в RDX) равен 0,
-;     записать 0 в результат и вернуть успех.
-; 4.  Сохранение множителя `b` в R14, так как `mul` разрушает RDX.
+;     записать 0 в результат и вернуть успех. Если `b == 1`, скопировать
+;     `a` в `res` (при `res == a` — ничего не делать).
+; 4.  Сохранение множителя `b` в RSI, так как `mul` разрушает RDX
+;     (указатель на `a` к этому моменту уже переведен в R8).
 ; 5.  Инициализация:
-;     - RCX: счетчик цикла, равен `a->len`.
-;     - R8: указатель на `a->words`.
-;     - R9: указатель на `res->words`.
+;     - R8: указатель на конец `a->words` (`&a->words[len]`).
+;     - R9: указатель на конец `res->words` (`&res->words[len]`).
 ;     - R10: переменная для хранения переноса (carry), инициализируется 0.
-; 6.  Основной цикл (по словам `a`):
-;     a. Загрузить очередное слово из `a->words` в RAX.
-;     b. Выполнить 64x64->128-битное умножение: `mul r14`.
+;     - R11: единственный отрицательный индекс i = -(len + k0), где
+;       k0 = (-len) mod 4, так что i кратен UNROLL (4).
+; 6.  Основной цикл развернут в 4 раза (MUL_LIMB 0..3). Вход в тело
+;     вычисляемый (как в устройстве Даффа): через таблицу `.entry_table`
+;     управление попадает сразу на слот k0, поэтому первые len mod 4 слов
+;     обрабатываются первым, неполным проходом, и отдельный цикл для
+;     остатка не нужен. При BIGNUM_CAPACITY <= FULL_UNROLL_MAX (16) тело
+;     развернуто полностью на BIGNUM_CAPACITY слов (k0 = BIGNUM_CAPACITY -
+;     len, i = -BIGNUM_CAPACITY), и цикла нет вовсе. На каждое слово:
+;     a. Загрузить слово `a->words[i + k]` в RAX.
+;     b. Выполнить 64x64->128-битное умножение: `mul rsi`.
 ;        Результат: RDX:RAX.
 ;     c. Добавить к младшей части (RAX) перенос из предыдущей итерации (R10).
 ;     d. Проверить переполнение сложения (`adc rdx, 0`). Старшая часть (RDX)
 ;        теперь содержит новый перенос.
-;     e. Сохранить результат (RAX) в `res->words`.
+;     e. Сохранить результат (RAX) в `res->words[i + k]`.
 ;     f. Сохранить новый перенос (RDX) в R10.
+;     Управление циклом — одно `add r11, 4` / `jnz` на 4 слова
+;     (см. макрос UNROLLED_BODY).
 ; 7.  После цикла, если остался ненулевой перенос (в R10), записать его
 ;     в следующее слово результата. Проверить на переполнение емкости.
 ; 8.  Установить корректное значение `res->len`.
 ; 9.  Вернуть 0 (успех).
 ;
+; Шаги 1–3 выполняются без кадра стека; шаги 4–9 — в
+; `bignum_mul_u64_generic_unchecked`, куда ядро передает управление
+; хвостовым переходом (`jmp`).
+;
 ; @abi        System V AMD64 ABI
 ; @param[in]  rdi: bignum_t* res (указатель на структуру)
 ; @param[in]  rsi: bignum_t* a (указатель на структуру)
@@ -61,99 +111,736 @@ section .text
 ; @retval 0 – success
 ; @retval -1 – null pointer
 ; @retval -2 – overflow
-; @clobbers   rbx, r8–r15, rcx, rdx
+; @clobbers   rcx, rdx, rsi, r8–r11
 ; =============================================================================
 
 
 ; --- Константы ---
-BIGNUM_CAPACITY         equ 32
+; Емкость bignum_t в словах — параметр сборки (`yasm -D BIGNUM_CAPACITY=8`),
+; должна совпадать с BIGNUM_CAPACITY, с которой собран вызывающий C-код.
+%ifndef BIGNUM_CAPACITY
+%define BIGNUM_CAPACITY 32
+%endif
+%if BIGNUM_CAPACITY < 1
+%error "BIGNUM_CAPACITY must be positive"
+%endif
 BIGNUM_WORD_SIZE        equ 8
 BIGNUM_BITS             equ BIGNUM_CAPACITY * 64
 BIGNUM_OFFSET_WORDS     equ 0
 BIGNUM_OFFSET_LEN       equ BIGNUM_CAPACITY * BIGNUM_WORD_SIZE
+BIGNUM_SIZE             equ BIGNUM_OFFSET_LEN + BIGNUM_WORD_SIZE
+BIGNUM_STATUS_SIZE      equ 4
 SUCCESS                 equ 0
 ERROR_NULL_ARG          equ -1
 ERROR_OVERFLOW          equ -2
+ERROR_UNDERFLOW         equ -3
 
-global bignum_mul_u64
+; --- Биты CPUID.(EAX=7,ECX=0):EBX ---
+CPUID_LEAF_EXT_FEATURES equ 7
+CPUID_EBX_BMI2          equ 1 << 8
+CPUID_EBX_ADX           equ 1 << 19
+CPUID_EBX_AVX512F       equ 1 << 16
+CPUID_EBX_AVX512IFMA    equ 1 << 21
 
-bignum_mul_u64:
-    ; --- Пролог: сохраняем только rbp ---
+; --- CPUID.(EAX=4): параметры кэшей ---
+CPUID_LEAF_CACHE_PARAMS equ 4
+CPUID_CACHE_TYPE_MASK   equ 0x1F
+CPUID_CACHE_MAX_SUBLEAF equ 16
+
+; --- Порог невременной записи bignum_mul_u64_n, в словах ---
+; По умолчанию — до определения LLC (и если лист 4 недоступен): 64 МиБ
+; результата. `yasm -D NT_THRESHOLD=N` задает порог явно и отключает
+; определение по CPUID.
+%ifdef NT_THRESHOLD
+NT_DEFAULT_THRESHOLD    equ NT_THRESHOLD
+%else
+NT_DEFAULT_THRESHOLD    equ 1 << 23
+%endif
+
+; --- CPUID.(EAX=1):ECX и XCR0 (сохранение состояния AVX-512 ОС) ---
+CPUID_LEAF_FEATURES     equ 1
+CPUID_ECX_OSXSAVE       equ 1 << 27
+XCR0_AVX512_STATE       equ 0xE6          ; SSE, AVX, opmask, ZMM_Hi256, Hi16_ZMM
+
+; -----------------------------------------------------------------------------
+; Пролог и эпилог ядер. Ядра используют только caller-saved регистры
+; (rax, rcx, rdx, rsi, rdi, r8–r11), поэтому в release-сборке кадр стека не
+; нужен вовсе. Кадр на rbp создается только при FRAME_POINTER (CONFIG=debug),
+; чтобы `perf record --call-graph fp` корректно разворачивал стек.
+; -----------------------------------------------------------------------------
+%macro PROLOGUE 0
+%ifdef FRAME_POINTER
     push    rbp
     mov     rbp, rsp
-    push    rbx
-    push    r11
-    push    r12
-    push    r13
-    push    r14
-    push    r15
+%endif
+%endmacro
+
+%macro EPILOGUE 0
+%ifdef FRAME_POINTER
+    pop     rbp
+%endif
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Сокращение длины a до значащей: старшие нулевые слова не умножаются и не
+; попадают в длину результата. Вне горячего пути: ядро попадает сюда, только
+; если старшее слово a нулевое. Ожидает rsi = a, rcx = len >= 1 и метки
+; `.trimmed` (продолжение) и `.handle_zero` (все слова нулевые).
+; -----------------------------------------------------------------------------
+%macro TRIM_PATH 0
+.trim:
+    dec     rcx
+    jz      .handle_zero
+    cmp     qword [rsi + rcx*BIGNUM_WORD_SIZE - BIGNUM_WORD_SIZE], 0
+    je      .trim
+    jmp     .trimmed
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Быстрый путь b == 1: res = a. Если res == a, слова не копируются,
+; пишется только длина (она могла сократиться в TRIM_PATH). Копирование —
+; по два слова (`movdqu`). Ожидает rdi = res, rsi = a, rcx = len и метку
+; `.set_len_no_carry`.
+; -----------------------------------------------------------------------------
+%macro COPY_PATH 0
+.copy:
+    cmp     rdi, rsi
+    je      .set_len_no_carry
+    xor     r11d, r11d
+    test    ecx, 1
+    jz      .copy_pairs
+    mov     rax, [rsi]                        ; нечетная длина: первое слово
+    mov     [rdi], rax
+    inc     r11
+.copy_pairs:
+    cmp     r11, rcx
+    jae     .set_len_no_carry
+.copy_loop:
+    movdqu  xmm0, [rsi + r11*BIGNUM_WORD_SIZE]
+    movdqu  [rdi + r11*BIGNUM_WORD_SIZE], xmm0
+    add     r11, 2
+    cmp     r11, rcx
+    jb      .copy_loop
+    jmp     .set_len_no_carry
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Публичная точка входа с диспетчеризацией: косвенный переход через
+; указатель %2. До первого вызова %2 указывает на `.resolve`, который выбирает
+; ядра (`bignum_mul_u64_select`) и повторяет переход. `cpuid` портит RDX и
+; RCX, поэтому они сохраняются в R10/R11; RDI, RSI, R8 и R9 он не трогает.
+; -----------------------------------------------------------------------------
+%macro DISPATCH 2
+%1:
+    jmp     [rel %2]
+.resolve:
+    mov     r10, rdx
+    mov     r11, rcx
+    call    bignum_mul_u64_select
+    mov     rdx, r10
+    mov     rcx, r11
+    jmp     [rel %2]
+%endmacro
+
+; --- Развертка основного цикла ---
+; При BIGNUM_CAPACITY <= FULL_UNROLL_MAX тело разворачивается полностью
+; (BIGNUM_CAPACITY слотов, без управления циклом), иначе — в UNROLL раз.
+%define UNROLL 4
+%ifndef FULL_UNROLL_MAX
+%define FULL_UNROLL_MAX 16
+%endif
+%if BIGNUM_CAPACITY <= FULL_UNROLL_MAX
+%define FULL_UNROLL 1
+%define UNROLL_SLOTS BIGNUM_CAPACITY
+%else
+%define FULL_UNROLL 0
+%define UNROLL_SLOTS UNROLL
+%endif
+
+; -----------------------------------------------------------------------------
+; Одно слово развернутого тела. Индекс слова — r11 + %1 относительно концов
+; массивов r8 (a) и r9 (res); перенос — в r10, множитель — в rsi.
+; -----------------------------------------------------------------------------
+%macro MUL_LIMB 1
+    mov     rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mul     rsi
+    add     rax, r10
+    adc     rdx, 0
+    mov     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    mov     r10, rdx
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Одно слово развернутого тела на mulx/adcx. Множитель — в rdx, перенос —
+; в r10 плюс CF.
+; -----------------------------------------------------------------------------
+%macro MULX_LIMB 1
+    mulx    rsi, rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    adcx    rax, r10
+    mov     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    mov     r10, rsi
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Варианты MUL_LIMB/MULX_LIMB с невременной записью (`movnti`): результат
+; идет в память мимо кэша и не вытесняет из него множимое. Нужен `sfence`
+; после цикла.
+; -----------------------------------------------------------------------------
+%macro MUL_LIMB_NT 1
+    mov     rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mul     rsi
+    add     rax, r10
+    adc     rdx, 0
+    movnti  [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    mov     r10, rdx
+%endmacro
+
+%macro MULX_LIMB_NT 1
+    mulx    rsi, rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    adcx    rax, r10
+    movnti  [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    mov     r10, rsi
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Слова развернутого тела умножения с накоплением (res[i] +=/-= a[i] * b).
+; Регистры — как у MUL_LIMB/MULX_LIMB; слово res читается и пишется по тому же
+; индексу, поэтому res может совпадать с a.
+; -----------------------------------------------------------------------------
+%macro MULADD_LIMB 1
+    mov     rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mul     rsi
+    add     rax, r10
+    adc     rdx, 0
+    add     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    adc     rdx, 0
+    mov     r10, rdx
+%endmacro
+
+%macro MULSUB_LIMB 1
+    mov     rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mul     rsi
+    add     rax, r10
+    adc     rdx, 0
+    sub     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    adc     rdx, 0                            ; заем -> в следующий перенос
+    mov     r10, rdx
+%endmacro
+
+; Две независимые цепочки: CF (`adcx`) — перенос произведения,
+; OF (`adox`) — перенос сложения с res. Перенос в следующее слово равен
+; r10 + CF + OF и всегда помещается в 64 бита.
+%macro MULXADD_LIMB 1
+    mulx    rsi, rax, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    adcx    rax, r10
+    adox    rax, [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mov     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    mov     r10, rsi
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Слот развернутого тела: метка входа `.entry_%2` и слово %2 макросом %1.
+; Номер слота передается параметром, чтобы %assign-счетчик подставился
+; значением.
+%macro LIMB_SLOT 2
+.entry_%2:
+    %1      %2
+%endmacro
+
+; Сброс CF (и OF) в перенос r10 в конце прохода.
+;   %1 — 0: не нужен (`mul`), 1: CF (`adcx`), 2: CF и OF (`adcx`/`adox`).
+%macro FOLD_CARRY 1
+%if %1 == 1
+    adc     r10, 0                            ; CF -> в перенос, CF = 0
+%elif %1 == 2
+    mov     eax, 0                            ; mov не трогает флаги
+    adcx    r10, rax
+    adox    r10, rax                          ; CF = OF = 0
+%endif
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Развернутое тело с вычисляемым входом (как в устройстве Даффа).
+;   %1 — макрос слова (MUL_LIMB, MULX_LIMB, ...); %2 — вид FOLD_CARRY;
+;   %3 — 1: полная развертка на BIGNUM_CAPACITY слов, 0: цикл по UNROLL.
+;
+; Ожидает rcx = len (при полной развертке 1..BIGNUM_CAPACITY, иначе любое
+; len >= 1), r8/r9 — концы массивов a/res. Через `.entry_table` управление
+; попадает сразу на слот k0, так что неполная часть обрабатывается без
+; отдельного цикла остатка:
+;   - полная развертка: k0 = BIGNUM_CAPACITY - len, r11 = -BIGNUM_CAPACITY,
+;     управления циклом нет вовсе;
+;   - развертка в UNROLL раз: k0 = (-len) mod UNROLL, r11 = -(len + k0)
+;     кратен UNROLL, одно `add r11, UNROLL` / `jnz` на проход.
+; На выходе r10 — перенос, rax и r11 испорчены.
+; UNROLLED_BODY — вариант для bignum_t (полная развертка при малой емкости).
+; -----------------------------------------------------------------------------
+%macro UNROLLED_BODY_EX 3
+%if %3
+    mov     eax, BIGNUM_CAPACITY
+    sub     eax, ecx                          ; rax = k0
+    mov     r11, -BIGNUM_CAPACITY             ; r11 = i
+%else
+    mov     eax, ecx
+    neg     eax
+    and     eax, UNROLL - 1                   ; rax = k0
+    lea     r11, [rcx + rax]
+    neg     r11                               ; r11 = i
+%endif
+    lea     r10, [rel .entry_table]
+    movsxd  rax, dword [r10 + rax*4]
+    add     rax, r10
+    xor     r10d, r10d                        ; r10 = carry = 0, CF = OF = 0
+    jmp     rax
+
+%if %3 == 0
+.loop:
+%endif
+%assign UNROLL_SLOT 0
+%if %3
+%rep BIGNUM_CAPACITY
+    LIMB_SLOT %1, UNROLL_SLOT
+%assign UNROLL_SLOT UNROLL_SLOT + 1
+%endrep
+%else
+%rep UNROLL
+    LIMB_SLOT %1, UNROLL_SLOT
+%assign UNROLL_SLOT UNROLL_SLOT + 1
+%endrep
+%endif
+    FOLD_CARRY %2
+%if %3 == 0
+    add     r11, UNROLL                       ; CF = 0, пока r11 < 0
+    jnz     .loop
+%endif
+%endmacro
+
+%macro UNROLLED_BODY 2
+    UNROLLED_BODY_EX %1, %2, FULL_UNROLL
+%endmacro
+
+; Таблица смещений слотов `.entry_N` относительно `.entry_table`.
+;   %1 — число слотов (BIGNUM_CAPACITY или UNROLL), как у UNROLLED_BODY_EX.
+%macro ENTRY_DD 1
+    dd      .entry_%1 - .entry_table
+%endmacro
+
+%macro ENTRY_TABLE_EX 1
+align 4
+.entry_table:
+%assign UNROLL_SLOT 0
+%rep %1
+    ENTRY_DD UNROLL_SLOT
+%assign UNROLL_SLOT UNROLL_SLOT + 1
+%endrep
+%endmacro
+
+%macro ENTRY_TABLE 0
+    ENTRY_TABLE_EX UNROLL_SLOTS
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Тело ядра на массиве слов: dst[0..n-1] = src * b, возврат — перенос.
+;   %1 — макрос слова; %2 — вид FOLD_CARRY; %3 — 0: множитель в rsi (`mul`),
+;   1: в rdx (`mulx`); %4 — 1: невременная запись (`sfence` в конце).
+;
+; Вход по ABI: rdi = dst, rsi = src, rdx = n, rcx = b. Емкости нет, поэтому
+; тело всегда — цикл по UNROLL (UNROLLED_BODY_EX ..., 0), тот же, что у
+; bignum_mul_u64 при BIGNUM_CAPACITY > FULL_UNROLL_MAX.
+; -----------------------------------------------------------------------------
+%macro SPAN_BODY 4
+    test    rdx, rdx
+    jz      .empty
+    PROLOGUE
+    lea     r8, [rsi + rdx*BIGNUM_WORD_SIZE]  ; r8 = &src[n]
+    lea     r9, [rdi + rdx*BIGNUM_WORD_SIZE]  ; r9 = &dst[n]
+%if %3
+    mov     rax, rdx
+    mov     rdx, rcx                          ; rdx = b (неявный операнд mulx)
+    mov     rcx, rax                          ; rcx = n
+%else
+    mov     rsi, rcx                          ; rsi = b
+    mov     rcx, rdx                          ; rcx = n
+%endif
+    UNROLLED_BODY_EX %1, %2, 0
+%if %4
+    sfence                                    ; упорядочить movnti с последующими записями
+%endif
+    mov     rax, r10                          ; перенос
+    EPILOGUE
+    ret
+.empty:
+    xor     eax, eax
+    ret
+    ENTRY_TABLE_EX UNROLL
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Тело ядра умножения с накоплением.
+;   %1 — макрос слова (MULADD_LIMB, MULSUB_LIMB, MULXADD_LIMB);
+;   %2 — 0: res += a * b, 1: res -= a * b;
+;   %3 — 0: множитель в rsi (`mul`), 1: множитель в rdx (`mulx`).
+;
+; Регистры: rdi — res, rcx — a->len, затем длина результата L;
+; r8/r9 — концы a->words/res->words по a->len; r10 — перенос (заем);
+; r11 — отрицательный индекс развернутого тела.
+; -----------------------------------------------------------------------------
+%macro MULACC_BODY 3
+    test    rdi, rdi
+    jz      .error_1
+    test    rsi, rsi
+    jz      .error_1
+
+.validated:
+    PROLOGUE
+
+    movsxd  rcx, dword [rsi + BIGNUM_OFFSET_LEN] ; rcx = a->len
+    cmp     rcx, BIGNUM_CAPACITY
+    ja      .error_2                          ; len < 0 или len > CAPACITY
+    movsxd  rax, dword [rdi + BIGNUM_OFFSET_LEN] ; rax = res->len
+    cmp     rax, BIGNUM_CAPACITY
+    ja      .error_2
+
+    ; a == 0 или b == 0: res не меняется
+    test    rcx, rcx
+    jz      .unchanged
+    test    rdx, rdx
+    jz      .unchanged
+
+    ; Слова res выше res->len считаются нулями
+    cmp     rax, rcx
+    jae     .extended
+.zero_extend:
+    mov     qword [rdi + rax*BIGNUM_WORD_SIZE], 0
+    inc     rax
+    cmp     rax, rcx
+    jb      .zero_extend
+
+.extended:
+    lea     r8, [rsi + rcx*BIGNUM_WORD_SIZE]  ; r8 = &a->words[a->len]
+    lea     r9, [rdi + rcx*BIGNUM_WORD_SIZE]  ; r9 = &res->words[a->len]
+%if %3 == 0
+    mov     rsi, rdx                          ; rsi = b
+%endif
+
+    ; Вычисляемый вход в развернутое тело — как в bignum_mul_u64_generic
+    UNROLLED_BODY %1, %3 * 2
+
+    ; Распространение переноса по словам res выше a->len
+    movsxd  rax, dword [rdi + BIGNUM_OFFSET_LEN] ; rax = исходный res->len
+    cmp     rax, rcx
+    jbe     .final                            ; L = a->len
+.propagate:
+    test    r10, r10
+    jz      .len_from_res
+%if %2
+    sub     [rdi + rcx*BIGNUM_WORD_SIZE], r10
+%else
+    add     [rdi + rcx*BIGNUM_WORD_SIZE], r10
+%endif
+    mov     r10d, 0
+    adc     r10, 0                            ; r10 = CF
+    inc     rcx
+    cmp     rcx, rax
+    jb      .propagate
+    jmp     .final
+
+.len_from_res:
+    mov     rcx, rax                          ; L = res->len, переноса нет
+
+.final:
+    test    r10, r10
+    jz      .set_len
+%if %2
+    jmp     .error_3                          ; заем из старшего слова
+%else
+    cmp     rcx, BIGNUM_CAPACITY
+    jae     .error_2
+    mov     [rdi + rcx*BIGNUM_WORD_SIZE], r10
+    inc     rcx
+%endif
+
+.set_len:
+%if %2
+    ; Вычитание может обнулить старшие слова
+.trim:
+    cmp     rcx, 1
+    jbe     .store_len
+    cmp     qword [rdi + rcx*BIGNUM_WORD_SIZE - BIGNUM_WORD_SIZE], 0
+    jne     .store_len
+    dec     rcx
+    jmp     .trim
+.store_len:
+%endif
+    mov     [rdi + BIGNUM_OFFSET_LEN], ecx
+    jmp     .success
+
+.unchanged:
+    ; res->len == 0 трактуется как 0 и нормализуется к len = 1
+    test    rax, rax
+    jnz     .success
+    mov     dword [rdi + BIGNUM_OFFSET_LEN], 1
+    mov     qword [rdi], 0
+    jmp     .success
+
+.error_1:
+    mov     rax, ERROR_NULL_ARG
+    ret
+
+.error_2:
+    mov     rax, ERROR_OVERFLOW
+    jmp     .epilogue
+
+.error_3:
+    mov     rax, ERROR_UNDERFLOW
+    jmp     .epilogue
+
+.success:
+    xor     rax, rax ; SUCCESS
+
+.epilogue:
+    EPILOGUE
+    ret
+
+    ENTRY_TABLE
+%endmacro
+
+global bignum_mul_u64
+global bignum_mul_u64_generic
+global bignum_mul_u64_mulx
+global bignum_mul_u64_unchecked
+global bignum_mul_u64_trim_count
+global bignum_mul_u64_n
+global bignum_mul_u64_n_nt
+global bignum_mul_u64_n_generic
+global bignum_mul_u64_n_mulx
+global bignum_mul_u64_n2
+global bignum_mul_u64_n2_generic
+global bignum_mul_u64_n2_mulx
+global bignum_mul_u64_batch
+global bignum_mul_u64_batch_scalar
+global bignum_mul_u64_batch_generic
+global bignum_mul_u64_batch_scalar_generic
 
-    ; Проверка на NULL
+%ifdef BATCH_IFMA
+; Пакетный движок на AVX-512 IFMA (bignum_mul_u64_ifma.c)
+extern bignum_mul_u64_batch_ifma
+extern bignum_mul_u64_batch_scalar_ifma
+%endif
+global bignum_mul_add_u64
+global bignum_mul_sub_u64
+global bignum_mul_u128
+global bignum_mul_u128_generic
+global bignum_mul_u128_mulx
+
+%ifdef STATS
+; Счетчики вызовов bignum_mul_u64 (bignum_mul_u64_stats.c)
+extern bignum_mul_u64_stats_call
+global bignum_mul_u64_dispatch
+%endif
+
+bignum_mul_u64_generic:
+    ; Проверка на NULL (путь ошибки возвращается без кадра)
     test    rdi, rdi
     jz      .error_1
     test    rsi, rsi
     jz      .error_1
 
+.validated:
+    ; Точка входа для пакетных функций: указатели уже проверены
+
     ; Получаем длину из a->len (смещение BIGNUM_WORD_SIZE * BIGNUM_CAPACITY)
-    movsxd  rcx, dword [rsi + BIGNUM_OFFSET_LEN] ; rcx = a->len (32 - BIGNUM_CAPACITY)
+    movsxd  rcx, dword [rsi + BIGNUM_OFFSET_LEN] ; rcx = a->len
 
     ; Проверка границ len (КЛЮЧЕВОЕ ИСПРАВЛЕНИЕ 2)
     test    rcx, rcx
     jle     .error_or_zero_len ; Если len <= 0
-    cmp     rcx, BIGNUM_CAPACITY          ; 32 - BIGNUM_CAPACITY
-    jg      .error_2          ; Если len > 32
+    cmp     rcx, BIGNUM_CAPACITY
+    jg      .error_2          ; Если len > BIGNUM_CAPACITY
+
+    ; Старшие нулевые слова a не умножаются: длина сокращается до значащей
+    cmp     qword [rsi + rcx*BIGNUM_WORD_SIZE - BIGNUM_WORD_SIZE], 0
+    je      .trim
+.trimmed:
 
     ; Проверка на b == 0
     test    rdx, rdx
     jz      .handle_zero
 
-    ; Сохраняем указатели и множитель
-    mov     r12, rdi        ; r12 = res
-    mov     r13, rsi        ; r13 = a
-    mov     r14, rdx        ; r14 = b
+    ; b == 1: копия (или ничего, если res == a)
+    cmp     rdx, 1
+    je      .copy
+
+    ; Операнды корректны: умножение без проверок, rcx = len уже загружен
+    jmp     bignum_mul_u64_generic_unchecked.body
+
+.error_or_zero_len:
+    ; Если len == 0, это валидный случай для числа 0.
+    ; Но если len < 0, это ошибка. Мы трактуем и то, и то как 0.
+    ; Для большей строгости можно было бы разделить.
+    test    rcx, rcx
+    jnz     .error_2
+    ; Если len == 0, результат 0.
+    mov     dword [rdi + BIGNUM_OFFSET_LEN], 1
+    mov     qword [rdi], 0
+    jmp     .success
+
+.handle_zero:
+    mov     dword [rdi + BIGNUM_OFFSET_LEN], 1
+    mov     qword [rdi], 0
+    jmp     .success
+
+    TRIM_PATH
+    COPY_PATH
 
-    ; Указатели на массивы words
-    mov     r8, rsi         ; a_ptr = &a->words[0]
-    mov     r9, rdi         ; res_ptr = &res->words[0]
+.set_len_no_carry:
+    mov     [rdi + BIGNUM_OFFSET_LEN], ecx
 
-    xor     r10, r10        ; r10 = carry = 0
-    xor     r11, r11        ; r11 = loop counter i = 0
+.success:
+    xor     rax, rax ; SUCCESS
+    ret
 
-.loop:
-    mov rax, [r8]
-    mul r14
-    add rax, r10
-    adc rdx, 0
-    mov [r9], rax
-    mov r10, rdx
-    add r8, BIGNUM_WORD_SIZE
-    add r9, BIGNUM_WORD_SIZE
-    inc r11
-    cmp r11, rcx
-    jl .loop
+.error_1:
+    mov     rax, ERROR_NULL_ARG
+    ret
+
+.error_2:
+    mov     rax, ERROR_OVERFLOW
+    ret
+
+; -----------------------------------------------------------------------------
+; @brief Умножение без проверок на `mul` (шаги 4–9 базового ядра).
+;
+; @details
+; Предусловия: res и a не NULL, 1 <= a->len <= BIGNUM_CAPACITY. Быстрых
+; путей нет: при b == 0 результат — a->len нулевых слов (без нормализации
+; к len = 1), и длина не сокращается: старшие нулевые слова a умножаются.
+; Ветвления — только управление циклом (при полной развертке его нет) и
+; обработка итогового переноса.
+; Точка `.body` ожидает rcx = длину (переход из bignum_mul_u64_generic).
+;
+; @return     rax: 0 или -2 (перенос при a->len == BIGNUM_CAPACITY)
+; @clobbers   rcx, rdx, rsi, r8–r11
+; -----------------------------------------------------------------------------
+bignum_mul_u64_generic_unchecked:
+    movsxd  rcx, dword [rsi + BIGNUM_OFFSET_LEN] ; rcx = a->len
+
+.body:
+    PROLOGUE
+
+    ; Указатели на концы массивов words
+    lea     r8, [rsi + rcx*BIGNUM_WORD_SIZE]  ; r8 = &a->words[len]
+    lea     r9, [rdi + rcx*BIGNUM_WORD_SIZE]  ; r9 = &res->words[len]
+
+    ; Множитель — в освободившийся rsi, так как `mul` разрушает RDX
+    mov     rsi, rdx        ; rsi = b
+
+    ; Вход в развернутое тело: пропускаются k0 первых слотов
+    UNROLLED_BODY MUL_LIMB, 0
 
     test    r10, r10
-    jz      .set_len_no_carry
+    jz      .set_len
 
-.handle_final_carry:
     ; r9 уже указывает на слово после последнего результата
     cmp     rcx, BIGNUM_CAPACITY
-    jge     .error_2
+    jae     .error_2
     mov     [r9], r10          ; записать carry в res->words[len]
     inc     rcx                ; увеличиваем длину результата
 
+.set_len:
+    mov     [rdi + BIGNUM_OFFSET_LEN], ecx
+    xor     eax, eax ; SUCCESS
 
-.set_len_no_carry:
-    mov     [r12 + BIGNUM_OFFSET_LEN], ecx
-    jmp     .success
+.epilogue:
+    EPILOGUE
+    ret
+
+.error_2:
+    mov     rax, ERROR_OVERFLOW
+    jmp     .epilogue
+
+    ENTRY_TABLE
+
+
+
+
+; =============================================================================
+; @brief Ядро на BMI2/ADX: умножает bignum_t на uint64_t через `mulx`/`adcx`.
+;
+; @details
+; `mulx` берет множитель неявно из RDX и не трогает флаги, поэтому перенос
+; между словами идет по цепочке CF (`adcx`), а не через RAX/RDX. Внутри
+; развернутого тела нет инструкций, меняющих CF, кроме `adcx`.
+;
+; Требует BMI2 и ADX. Вызывать напрямую можно только после проверки CPUID,
+; иначе — #UD. Семантика и коды возврата совпадают с `bignum_mul_u64_generic`.
+;
+; **Алгоритм:**
+; 1.  Проверки аргументов, `a->len`, сокращение длины и быстрые пути
+;     `b == 0`, `b == 1` — как в базовом ядре.
+; 2.  Инициализация:
+;     - R8: указатель на конец `a->words` (`&a->words[len]`).
+;     - R9: указатель на конец `res->words` (`&res->words[len]`).
+;     - R11: индекс i = -(len + k0), k0 = (-len) mod 4; вход в
+;       развернутое тело — через `.entry_table`, как в базовом ядре.
+;     - R10: перенос, 0; CF = 0 (после `xor`).
+; 3.  Основной цикл развернут в 4 раза (MULX_LIMB 0..3). На каждое слово:
+;     a. `mulx rsi, rax, [a_i]` — RSI:RAX = a[i] * b.
+;     b. `adcx rax, r10` — младшая часть + старшая часть предыдущего
+;        произведения + CF.
+;     c. Сохранить RAX в `res->words[i]`, старшую часть — в R10.
+;     В конце прохода CF добавляется в R10 (`adc r10, 0`, после него CF = 0),
+;     и `add r11, 4` его уже не портит: пока r11 < 0, CF остается 0.
+;     При полной развертке (BIGNUM_CAPACITY <= 16) CF сбрасывается один раз.
+; 4.  После цикла обработать перенос в R10 так же, как базовое ядро.
+; Шаги 2–4 выполняет `bignum_mul_u64_mulx_unchecked` (переход без возврата).
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (указатель на структуру)
+; @param[in]  rsi: bignum_t* a (указатель на структуру)
+; @param[in]  rdx: uint64_t b (множитель)
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1 или -2)
+; @retval 0 – success
+; @retval -1 – null pointer
+; @retval -2 – overflow
+; @clobbers   rax, rcx, rdx, rsi, r8–r11
+; =============================================================================
+bignum_mul_u64_mulx:
+    ; Проверка на NULL (путь ошибки возвращается без кадра)
+    test    rdi, rdi
+    jz      .error_1
+    test    rsi, rsi
+    jz      .error_1
+
+.validated:
+    ; Точка входа для пакетных функций: указатели уже проверены
+    movsxd  rcx, dword [rsi + BIGNUM_OFFSET_LEN] ; rcx = a->len
+
+    ; Проверка границ len
+    test    rcx, rcx
+    jle     .error_or_zero_len
+    cmp     rcx, BIGNUM_CAPACITY
+    jg      .error_2
+
+    ; Старшие нулевые слова a не умножаются
+    cmp     qword [rsi + rcx*BIGNUM_WORD_SIZE - BIGNUM_WORD_SIZE], 0
+    je      .trim
+.trimmed:
+
+    ; Проверка на b == 0
+    test    rdx, rdx
+    jz      .handle_zero
+
+    ; b == 1: копия (или ничего, если res == a)
+    cmp     rdx, 1
+    je      .copy
+
+    jmp     bignum_mul_u64_mulx_unchecked.body
 
 .error_or_zero_len:
-    ; Если len == 0, это валидный случай для числа 0.
-    ; Но если len < 0, это ошибка. Мы трактуем и то, и то как 0.
-    ; Для большей строгости можно было бы разделить.
     test    rcx, rcx
     jnz     .error_2
-    ; Если len == 0, результат 0.
     mov     dword [rdi + BIGNUM_OFFSET_LEN], 1
     mov     qword [rdi], 0
     jmp     .success
@@ -163,25 +850,978 @@ bignum_mul_u64:
     mov     qword [rdi], 0
     jmp     .success
 
+    TRIM_PATH
+    COPY_PATH
+
+.set_len_no_carry:
+    mov     [rdi + BIGNUM_OFFSET_LEN], ecx
+
+.success:
+    xor     rax, rax ; SUCCESS
+    ret
+
 .error_1:
     mov     rax, ERROR_NULL_ARG
-    jmp    .epilogue
+    ret
 
 .error_2:
     mov     rax, ERROR_OVERFLOW
-    jmp    .epilogue
+    ret
 
-.success:
-    xor     rax, rax ; SUCCESS
+; -----------------------------------------------------------------------------
+; @brief Умножение без проверок на `mulx`/`adcx` (шаги 2–4 ядра на BMI2/ADX).
+;
+; @details
+; Предусловия — как у bignum_mul_u64_generic_unchecked; требует BMI2 и ADX.
+; Точка `.body` ожидает rcx = a->len.
+;
+; @return     rax: 0 или -2 (перенос при a->len == BIGNUM_CAPACITY)
+; @clobbers   rax, rcx, rsi, r8–r11
+; -----------------------------------------------------------------------------
+bignum_mul_u64_mulx_unchecked:
+    movsxd  rcx, dword [rsi + BIGNUM_OFFSET_LEN] ; rcx = a->len
+
+.body:
+    PROLOGUE
+
+    ; RDX = b остается на месте: это неявный операнд mulx
+    lea     r8, [rsi + rcx*BIGNUM_WORD_SIZE]  ; r8 = &a->words[len]
+    lea     r9, [rdi + rcx*BIGNUM_WORD_SIZE]  ; r9 = &res->words[len]
+
+    ; Вход в развернутое тело — как в базовом ядре
+    UNROLLED_BODY MULX_LIMB, 1
+
+    test    r10, r10
+    jz      .set_len
+
+    ; r9 указывает на слово после последнего результата
+    cmp     rcx, BIGNUM_CAPACITY
+    jae     .error_2
+    mov     [r9], r10
+    inc     rcx
+
+.set_len:
+    mov     [rdi + BIGNUM_OFFSET_LEN], ecx
+    xor     eax, eax ; SUCCESS
 
 .epilogue:
+    EPILOGUE
+    ret
+
+.error_2:
+    mov     rax, ERROR_OVERFLOW
+    jmp     .epilogue
+
+    ENTRY_TABLE
+
+
+; =============================================================================
+; @brief Умножение массива слов произвольной длины: dst = src * b.
+;
+; @details
+; `uint64_t bignum_mul_u64_n_*(uint64_t *dst, const uint64_t *src, size_t n,
+; uint64_t b)`: пишет n младших слов произведения в dst и возвращает слово
+; переноса (старшее слово произведения). Ограничения емкости нет; n == 0 —
+; возврат 0 без обращений к памяти. dst может совпадать с src.
+;
+; Внутренний цикл — тот же, что у ядер bignum_mul_u64 (MUL_LIMB/MULX_LIMB в
+; UNROLLED_BODY_EX). При n >= `bignum_mul_u64_nt_threshold` (результат
+; заметно больше LLC, см. bignum_mul_u64_select) ядро переходит к варианту
+; с невременной записью `*_nt`: переписывать кэш строками, к которым до
+; конца прохода никто не вернется, дороже, чем писать мимо него.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: uint64_t* dst
+; @param[in]  rsi: const uint64_t* src
+; @param[in]  rdx: size_t n
+; @param[in]  rcx: uint64_t b
+;
+; @return     rax: перенос
+; @clobbers   rcx, rdx, rsi, r8–r11
+; =============================================================================
+bignum_mul_u64_n_generic:
+    cmp     rdx, [rel bignum_mul_u64_nt_threshold]
+    jae     bignum_mul_u64_n_nt_generic
+    SPAN_BODY MUL_LIMB, 0, 0, 0
+
+bignum_mul_u64_n_nt_generic:
+    SPAN_BODY MUL_LIMB_NT, 0, 0, 1
+
+; Требует BMI2 и ADX.
+bignum_mul_u64_n_mulx:
+    cmp     rdx, [rel bignum_mul_u64_nt_threshold]
+    jae     bignum_mul_u64_n_nt_mulx
+    SPAN_BODY MULX_LIMB, 1, 1, 0
+
+bignum_mul_u64_n_nt_mulx:
+    SPAN_BODY MULX_LIMB_NT, 1, 1, 1
+
+; -----------------------------------------------------------------------------
+; Пара произведений bignum_mul_u64_n2: dst0 = src * b0, dst1 = src * b1.
+;
+; Общая часть: rdi = dst (массив из двух указателей), rsi = src, rdx = n,
+; rcx = b (два множителя). Множители — в красной зоне ([rsp - 8] = b0,
+; [rsp - 16] = b1) и читаются операндом `mul`/`mulx`: регистры нужны на
+; переносы, два конца dst, конец src и индекс. r9/r10 — концы dst0/dst1,
+; rsi — конец src, r11 = -n.
+; -----------------------------------------------------------------------------
+%macro N2_SETUP 0
+    mov     rax, [rcx]
+    mov     [rsp - 8], rax                    ; b0
+    mov     rax, [rcx + BIGNUM_WORD_SIZE]
+    mov     [rsp - 16], rax                   ; b1
+    mov     r9, [rdi]
+    lea     r9, [r9 + rdx*BIGNUM_WORD_SIZE]   ; r9 = &dst[0][n]
+    mov     r10, [rdi + BIGNUM_WORD_SIZE]
+    lea     r10, [r10 + rdx*BIGNUM_WORD_SIZE] ; r10 = &dst[1][n]
+    lea     rsi, [rsi + rdx*BIGNUM_WORD_SIZE] ; rsi = &src[n]
+    mov     r11, rdx
+    neg     r11                               ; r11 = -n
+%endmacro
+
+; Выход %1 (0 или 1) прохода на `mul`: слово src — в rdi, перенос — %2.
+%macro MUL_N2_OUT 2
+    mov     rax, rdi
+    mul     qword [rsp - 8 - %1*BIGNUM_WORD_SIZE]
+    add     rax, %2
+    adc     rdx, 0
+%if %1
+    mov     [r10 + r11*BIGNUM_WORD_SIZE], rax
+%else
+    mov     [r9 + r11*BIGNUM_WORD_SIZE], rax
+%endif
+    mov     %2, rdx
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Слово %1 (0 или 1) прохода на `mulx`: выход 0 — цепочка CF (`adcx`),
+; выход 1 — цепочка OF (`adox`). Старшие слова произведений не
+; переносятся `mov`: %2/%3 — старшие слова предыдущего слова для выходов
+; 0/1, %4/%5 — регистры для старших слов текущего.
+; -----------------------------------------------------------------------------
+%macro MULX_N2_LIMB 5
+    mov     rdx, [rsi + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mulx    %4, rdi, [rsp - 8]
+    adcx    rdi, %2
+    mov     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rdi
+    mulx    %5, rdi, [rsp - 16]
+    adox    rdi, %3
+    mov     [r10 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rdi
+%endmacro
+
+; =============================================================================
+; @brief Два произведения массива слов за один проход: dst[g] = src * b[g].
+;
+; @details
+; `bignum_mul_u64_carry2_t bignum_mul_u64_n2(uint64_t *const dst[2],
+; const uint64_t *src, size_t n, const uint64_t b[2])`: пишет n младших слов
+; src * b[g] в dst[g], g = 0, 1, и возвращает оба переноса в RAX:RDX
+; (структура из двух слов по System V). Переносы в регистрах, а не в
+; памяти: вызывающий код сразу ветвится по ним, и загрузка только что
+; записанного слова встала бы в зависимость от всей цепочки умножения. Слово src читается
+; один раз на оба выхода, и две цепочки переносов независимы. Основа
+; bignum_mul_u64_fanout. Каждое слово src читается до записи результатов,
+; так что dst[0] или dst[1] может совпадать с src.
+;
+; bignum_mul_u64_n2_mulx (BMI2/ADX) ведет выход 0 по флагу CF (`adcx`), а
+; выход 1 — по OF (`adox`): на слово выхода — `mulx`, сложение и запись,
+; без переноса в регистрах. Проход развернут в 2 раза, нечетная длина
+; входит сразу во второе слово; в конце прохода флаги сбрасываются в
+; старшие слова (как FOLD_CARRY). bignum_mul_u64_n2_generic держит
+; переносы в регистрах (`mul`/`adc`). Выбор по CPUID — как у bignum_mul_u64.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: uint64_t* const dst[2]
+; @param[in]  rsi: const uint64_t* src
+; @param[in]  rdx: size_t n
+; @param[in]  rcx: const uint64_t b[2]
+;
+; @return     rax: перенос dst[0], rdx: перенос dst[1]
+; @clobbers   rcx, rsi, rdi, r8–r11, красная зона [rsp - 16, rsp)
+; =============================================================================
+    DISPATCH bignum_mul_u64_n2, bignum_mul_u64_n2_impl
+
+bignum_mul_u64_n2_generic:
+    PROLOGUE
+    N2_SETUP
+    xor     ecx, ecx                          ; перенос выхода 0
+    xor     r8d, r8d                          ; перенос выхода 1
+    test    r11, r11
+    jz      .done
+.loop:
+    mov     rdi, [rsi + r11*BIGNUM_WORD_SIZE]
+    MUL_N2_OUT 0, rcx
+    MUL_N2_OUT 1, r8
+    inc     r11
+    jnz     .loop
+.done:
+    mov     rax, rcx
+    mov     rdx, r8
+    EPILOGUE
+    ret
+
+; Требует BMI2 и ADX. rbx (callee-saved) — четвертый регистр старших слов.
+bignum_mul_u64_n2_mulx:
+    PROLOGUE
+    push    rbx
+    N2_SETUP
+    xor     ecx, ecx
+    xor     r8d, r8d
+    xor     ebx, ebx
+    xor     eax, eax                          ; старшие слова = 0, CF = OF = 0
+    test    r11d, 1
+    jz      .check
+    lea     r11, [r11 - 1]                    ; нечетная n: -(n + 1), вход в слово 1
+    jmp     .limb_1
+.check:
+    test    r11, r11
+    jz      .done
+.loop:
+    MULX_N2_LIMB 0, rax, rbx, rcx, r8
+.limb_1:
+    MULX_N2_LIMB 1, rcx, r8, rax, rbx
+    mov     edi, 0                            ; mov не трогает флаги
+    adcx    rax, rdi
+    adox    rbx, rdi                          ; CF = OF = 0
+    add     r11, 2
+    jnz     .loop
+.done:
+    mov     rdx, rbx
+    pop     rbx
+    EPILOGUE
+    ret
+
+
+; =============================================================================
+; @brief Умножает большое число (bignum_t) на 64-битное целое.
+;
+; @details
+; Публичная точка входа. Выполняет косвенный переход через указатель
+; `bignum_mul_u64_impl` (макрос DISPATCH). Изначально указатель ссылается на
+; `bignum_mul_u64.resolve`, который при первом вызове проверяет CPUID,
+; записывает в указатель адрес подходящего ядра и передает ему управление.
+; Все последующие вызовы идут напрямую в выбранное ядро.
+;
+; Гонка при первом вызове из нескольких потоков безопасна: все потоки
+; записывают одно и то же значение выровненным 8-байтовым `mov`.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (указатель на структуру)
+; @param[in]  rsi: bignum_t* a (указатель на структуру)
+; @param[in]  rdx: uint64_t b (множитель)
+;
+; В сборке со счетчиками (`-D STATS`, CONFIG=stats) bignum_mul_u64 —
+; переход в bignum_mul_u64_stats_call (bignum_mul_u64_stats.c), а диспетчер
+; экспортирован как bignum_mul_u64_dispatch: счетчики обновляет C-код до и
+; после вызова диспетчера. Без STATS этого перехода нет.
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1 или -2)
+; @clobbers   как у выбранного ядра (со STATS — любые caller-saved)
+; =============================================================================
+%ifdef STATS
+bignum_mul_u64:
+    jmp     bignum_mul_u64_stats_call
+    DISPATCH bignum_mul_u64_dispatch, bignum_mul_u64_impl
+%else
+    DISPATCH bignum_mul_u64, bignum_mul_u64_impl
+%endif
+
+; =============================================================================
+; @brief Умножение без проверок для заранее проверенных операндов.
+;
+; @details
+; Тот же ABI, что у bignum_mul_u64, и та же диспетчеризация по CPUID
+; (указатель `bignum_mul_u64_unchecked_impl`). Вызывает
+; `bignum_mul_u64_generic_unchecked` или `bignum_mul_u64_mulx_unchecked`.
+;
+; Предусловия (не проверяются): res и a не NULL,
+; 1 <= a->len <= BIGNUM_CAPACITY. Быстрых путей b == 0 и b == 1 нет,
+; длина a не сокращается.
+;
+; @return     rax: bignum_mul_u64_status_t (0 или -2)
+; @clobbers   как у выбранного ядра
+; =============================================================================
+    DISPATCH bignum_mul_u64_unchecked, bignum_mul_u64_unchecked_impl
+
+; =============================================================================
+; @brief bignum_mul_u64 с отчетом о пропущенных старших нулевых словах.
+;
+; @details
+; Записывает в *skipped число старших нулевых слов `a` (a->len минус
+; значащая длина) и передает управление bignum_mul_u64 хвостовым
+; переходом. Ядро сокращает длину само; счетчик нужен, чтобы найти
+; источники ненормализованных чисел. При некорректной длине a, NULL в
+; `res` или `a` в *skipped пишется 0. `skipped` может быть NULL.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res
+; @param[in]  rsi: const bignum_t* a
+; @param[in]  rdx: uint64_t b
+; @param[out] rcx: size_t* skipped
+;
+; @return     rax: как у bignum_mul_u64
+; @clobbers   как у выбранного ядра
+; =============================================================================
+bignum_mul_u64_trim_count:
+    test    rcx, rcx
+    jz      bignum_mul_u64
+    xor     r9d, r9d                          ; r9 = skipped
+    test    rdi, rdi
+    jz      .store
+    test    rsi, rsi
+    jz      .store
+    movsxd  r8, dword [rsi + BIGNUM_OFFSET_LEN] ; r8 = a->len
+    test    r8, r8
+    jle     .store
+    cmp     r8, BIGNUM_CAPACITY
+    jg      .store
+.scan:
+    cmp     qword [rsi + r8*BIGNUM_WORD_SIZE - BIGNUM_WORD_SIZE], 0
+    jne     .store
+    inc     r9
+    dec     r8
+    jnz     .scan
+.store:
+    mov     [rcx], r9
+    jmp     bignum_mul_u64
+
+; =============================================================================
+; @brief Умножение массива слов с диспетчеризацией по CPUID.
+;
+; @details
+; `bignum_mul_u64_n` выбирает bignum_mul_u64_n_mulx или _generic (и по
+; длине — невременную запись), `bignum_mul_u64_n_nt` всегда пишет мимо
+; кэша. ABI и результат — как у ядер bignum_mul_u64_n_*.
+; =============================================================================
+    DISPATCH bignum_mul_u64_n, bignum_mul_u64_n_impl
+    DISPATCH bignum_mul_u64_n_nt, bignum_mul_u64_n_nt_impl
+
+; -----------------------------------------------------------------------------
+; @brief Выбор ядра по CPUID (выполняется один раз).
+;
+; @details
+; Ядро `bignum_mul_u64_mulx` выбирается, если поддерживаются и BMI2, и ADX;
+; иначе — `bignum_mul_u64_generic`. Записывает адрес ядра в
+; `bignum_mul_u64_impl`, а адрес его точки `.validated` — в
+; `bignum_mul_u64_core_impl` (используется пакетными функциями). Так же
+; выбираются ядра `bignum_mul_add_u64`, `bignum_mul_u64_unchecked`,
+; `bignum_mul_u128` и `bignum_mul_u64_n2`.
+; Пакетные функции получают движок на AVX-512 IFMA, только если он включен
+; при сборке (BATCH_IFMA, `make IFMA=1`) и поддерживается процессором и ОС;
+; иначе — скалярный цикл `bignum_mul_u64_batch_generic`.
+; Там же по листу 4 CPUID определяется размер LLC для порога невременной
+; записи bignum_mul_u64_n.
+; `cpuid` портит RBX (callee-saved), поэтому RBX сохраняется на стеке, как и
+; R12/R13 (максимальный лист и номер подлиста).
+;
+; @return     rax: адрес выбранного ядра
+; @clobbers   rax, rcx, rdx (RDI, RSI, R8–R11 не трогаются)
+; -----------------------------------------------------------------------------
+bignum_mul_u64_select:
+    push    rbx
+    push    r12
+    push    r13
+
+    ; Пакетные функции по умолчанию — скалярный цикл
+    lea     rax, [rel bignum_mul_u64_batch_generic]
+    mov     [rel bignum_mul_u64_batch_impl], rax
+    lea     rax, [rel bignum_mul_u64_batch_scalar_generic]
+    mov     [rel bignum_mul_u64_batch_scalar_impl], rax
+
+    xor     eax, eax
+    cpuid                                     ; eax = максимальный лист
+    mov     r12d, eax
+
+    ; Порог невременной записи bignum_mul_u64_n: результат вдвое больше LLC.
+    ; Подлисты листа 4 идут по уровням, последний — LLC. Без листа 4
+    ; (например, на AMD) остается NT_DEFAULT_THRESHOLD.
+%ifndef NT_THRESHOLD
+    cmp     r12d, CPUID_LEAF_CACHE_PARAMS
+    jb      .llc_done
+    xor     r13d, r13d                        ; r13 = подлист
+.llc_next:
+    mov     eax, CPUID_LEAF_CACHE_PARAMS
+    mov     ecx, r13d
+    cpuid
+    test    eax, CPUID_CACHE_TYPE_MASK        ; тип 0 — подлистов больше нет
+    jz      .llc_done
+    ; Размер = (ways + 1) * (partitions + 1) * (line + 1) * (sets + 1)
+    mov     edx, ebx
+    shr     edx, 22
+    inc     edx                               ; ways
+    mov     eax, ebx
+    shr     eax, 12
+    and     eax, 0x3FF
+    inc     eax                               ; partitions
+    imul    edx, eax
+    and     ebx, 0xFFF
+    inc     ebx                               ; line
+    imul    edx, ebx
+    mov     eax, edx
+    inc     ecx                               ; sets (старшая половина rcx — 0)
+    imul    rax, rcx                          ; rax = размер кэша в байтах
+    shr     rax, 2                            ; 2 * size / BIGNUM_WORD_SIZE слов
+    mov     [rel bignum_mul_u64_nt_threshold], rax
+    inc     r13d
+    cmp     r13d, CPUID_CACHE_MAX_SUBLEAF
+    jb      .llc_next
+.llc_done:
+%endif
+
+    cmp     r12d, CPUID_LEAF_EXT_FEATURES
+    jb      .use_generic
+
+%ifdef BATCH_IFMA
+    ; AVX-512 IFMA: и процессор, и ОС (XCR0) должны поддерживать zmm/opmask
+    mov     eax, CPUID_LEAF_FEATURES
+    cpuid
+    test    ecx, CPUID_ECX_OSXSAVE
+    jz      .no_ifma
+    xor     ecx, ecx
+    xgetbv                                    ; edx:eax = XCR0
+    and     eax, XCR0_AVX512_STATE
+    cmp     eax, XCR0_AVX512_STATE
+    jne     .no_ifma
+
+    mov     eax, CPUID_LEAF_EXT_FEATURES
+    xor     ecx, ecx
+    cpuid
+    and     ebx, CPUID_EBX_AVX512F | CPUID_EBX_AVX512IFMA
+    cmp     ebx, CPUID_EBX_AVX512F | CPUID_EBX_AVX512IFMA
+    jne     .no_ifma
+
+    lea     rax, [rel bignum_mul_u64_batch_ifma]
+    mov     [rel bignum_mul_u64_batch_impl], rax
+    lea     rax, [rel bignum_mul_u64_batch_scalar_ifma]
+    mov     [rel bignum_mul_u64_batch_scalar_impl], rax
+
+.no_ifma:
+%endif
+    mov     eax, CPUID_LEAF_EXT_FEATURES
+    xor     ecx, ecx
+    cpuid
+    and     ebx, CPUID_EBX_BMI2 | CPUID_EBX_ADX
+    cmp     ebx, CPUID_EBX_BMI2 | CPUID_EBX_ADX
+    jne     .use_generic
+
+    lea     rax, [rel bignum_mul_add_u64_mulx]
+    mov     [rel bignum_mul_add_u64_impl], rax
+    lea     rax, [rel bignum_mul_u64_mulx_unchecked]
+    mov     [rel bignum_mul_u64_unchecked_impl], rax
+    lea     rax, [rel bignum_mul_u64_n_mulx]
+    mov     [rel bignum_mul_u64_n_impl], rax
+    lea     rax, [rel bignum_mul_u64_n_nt_mulx]
+    mov     [rel bignum_mul_u64_n_nt_impl], rax
+    lea     rax, [rel bignum_mul_u128_mulx]
+    mov     [rel bignum_mul_u128_impl], rax
+    lea     rax, [rel bignum_mul_u64_n2_mulx]
+    mov     [rel bignum_mul_u64_n2_impl], rax
+    lea     rax, [rel bignum_mul_u64_mulx]
+    lea     rcx, [rel bignum_mul_u64_mulx.validated]
+    jmp     .store
+
+.use_generic:
+    lea     rax, [rel bignum_mul_add_u64_generic]
+    mov     [rel bignum_mul_add_u64_impl], rax
+    lea     rax, [rel bignum_mul_u64_generic_unchecked]
+    mov     [rel bignum_mul_u64_unchecked_impl], rax
+    lea     rax, [rel bignum_mul_u64_n_generic]
+    mov     [rel bignum_mul_u64_n_impl], rax
+    lea     rax, [rel bignum_mul_u64_n_nt_generic]
+    mov     [rel bignum_mul_u64_n_nt_impl], rax
+    lea     rax, [rel bignum_mul_u128_generic]
+    mov     [rel bignum_mul_u128_impl], rax
+    lea     rax, [rel bignum_mul_u64_n2_generic]
+    mov     [rel bignum_mul_u64_n2_impl], rax
+    lea     rax, [rel bignum_mul_u64_generic]
+    lea     rcx, [rel bignum_mul_u64_generic.validated]
+
+.store:
+    mov     [rel bignum_mul_u64_core_impl], rcx
+    mov     [rel bignum_mul_u64_impl], rax
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+
+; Кадр пакетного цикла: слот первого статуса плюс выравнивание. На входе
+; rsp = 8 (mod 16); после пяти push (и push rbp при FRAME_POINTER) и кадра
+; rsp перед вызовом ядра кратен 16, как требует System V ABI.
+%ifdef FRAME_POINTER
+%define BATCH_FRAME 8
+%else
+%define BATCH_FRAME 16
+%endif
+
+; -----------------------------------------------------------------------------
+; Тело пакетного цикла. %1 = 1 — множители берутся из массива r14,
+; %1 = 0 — один множитель в r14 для всех элементов.
+;
+; Регистры (callee-saved, переживают вызов ядра):
+;   r12 — res[i], r13 — a[i], r14 — b[i] (или b), r15 — status_out[i]
+;   (или NULL), rbx — оставшееся число элементов, [rsp] — первый ненулевой
+;   статус.
+; -----------------------------------------------------------------------------
+%macro BATCH_LOOP 1
+    mov     r12, rdi
+    mov     r13, rsi
+    mov     r14, rdx
+    mov     r15, r8
+    mov     rbx, rcx
+    mov     dword [rsp], SUCCESS
+
+    ; Ядро выбирается один раз на весь пакет
+    cmp     qword [rel bignum_mul_u64_core_impl], 0
+    jne     %%loop
+    call    bignum_mul_u64_select
+
+%%loop:
+    ; Следующий элемент: первая строка кэша слов и строка с len
+    prefetcht0 [r13 + BIGNUM_SIZE]
+    prefetcht0 [r13 + BIGNUM_SIZE + BIGNUM_OFFSET_LEN]
+
+    mov     rdi, r12
+    mov     rsi, r13
+%if %1
+    mov     rdx, [r14]
+%else
+    mov     rdx, r14
+%endif
+    call    [rel bignum_mul_u64_core_impl]
+
+    test    r15, r15
+    jz      %%no_status_out
+    mov     [r15], eax
+    add     r15, BIGNUM_STATUS_SIZE
+
+%%no_status_out:
+    test    eax, eax
+    jz      %%next
+    cmp     dword [rsp], SUCCESS
+    jne     %%next
+    mov     [rsp], eax                        ; запоминаем первую ошибку
+
+%%next:
+    add     r12, BIGNUM_SIZE
+    add     r13, BIGNUM_SIZE
+%if %1
+    add     r14, BIGNUM_WORD_SIZE
+%endif
+    dec     rbx
+    jnz     %%loop
+
+    movsxd  rax, dword [rsp]
+%endmacro
+
+; =============================================================================
+; @brief Пакетное умножение: res[i] = a[i] * b[i], i = 0..n-1.
+;
+; @details
+; Указатели на массивы проверяются один раз на весь пакет, ядро выбирается
+; один раз, после чего для каждого элемента вызывается точка `.validated`
+; выбранного ядра (без повторной проверки указателей). Перед обработкой
+; элемента выполняется программная предвыборка следующего `bignum_t`.
+; Проверка `a[i].len` остается поэлементной.
+;
+; `bignum_mul_u64_batch` — точка диспетчеризации (как у bignum_mul_u64);
+; скалярный цикл экспортирован как `bignum_mul_u64_batch_generic`.
+;
+; Обрабатываются все n элементов, даже если часть из них завершилась ошибкой.
+; Если `status_out` не NULL, в `status_out[i]` записывается статус элемента i.
+; Возвращается статус первого элемента, завершившегося ошибкой (или 0).
+; `res[i]` может совпадать с `a[i]`.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (массив из n результатов)
+; @param[in]  rsi: const bignum_t* a (массив из n множимых)
+; @param[in]  rdx: const uint64_t* b (массив из n множителей)
+; @param[in]  rcx: size_t n (число элементов)
+; @param[in]  r8:  bignum_mul_u64_status_t* status_out (массив из n или NULL)
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1 или -2)
+; @retval 0 – все элементы успешны (или n == 0)
+; @retval -1 – res, a или b равен NULL при n > 0
+; @retval -2 – первый неуспешный элемент вернул переполнение
+; @clobbers   rcx, rdx, rsi, rdi, r8–r11
+; =============================================================================
+    DISPATCH bignum_mul_u64_batch, bignum_mul_u64_batch_impl
+
+bignum_mul_u64_batch_generic:
+    test    rcx, rcx
+    jz      .empty
+    test    rdi, rdi
+    jz      .error_1
+    test    rsi, rsi
+    jz      .error_1
+    test    rdx, rdx
+    jz      .error_1
+
+    PROLOGUE
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    sub     rsp, BATCH_FRAME                  ; слот для первого статуса
+
+    BATCH_LOOP 1
+
+    add     rsp, BATCH_FRAME
     pop     r15
     pop     r14
     pop     r13
     pop     r12
-    pop     r11
     pop     rbx
-    pop     rbp
+    EPILOGUE
+    ret
+
+.empty:
+    xor     eax, eax ; SUCCESS
+    ret
+
+.error_1:
+    mov     rax, ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief Пакетное умножение на общий множитель: res[i] = a[i] * b.
+;
+; @details
+; То же, что `bignum_mul_u64_batch`, но один множитель `b` применяется ко
+; всем элементам.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (массив из n результатов)
+; @param[in]  rsi: const bignum_t* a (массив из n множимых)
+; @param[in]  rdx: uint64_t b (общий множитель)
+; @param[in]  rcx: size_t n (число элементов)
+; @param[in]  r8:  bignum_mul_u64_status_t* status_out (массив из n или NULL)
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1 или -2)
+; @retval 0 – все элементы успешны (или n == 0)
+; @retval -1 – res или a равен NULL при n > 0
+; @retval -2 – первый неуспешный элемент вернул переполнение
+; @clobbers   rcx, rdx, rsi, rdi, r8–r11
+; =============================================================================
+    DISPATCH bignum_mul_u64_batch_scalar, bignum_mul_u64_batch_scalar_impl
+
+bignum_mul_u64_batch_scalar_generic:
+    test    rcx, rcx
+    jz      .empty
+    test    rdi, rdi
+    jz      .error_1
+    test    rsi, rsi
+    jz      .error_1
+
+    PROLOGUE
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    sub     rsp, BATCH_FRAME                  ; слот для первого статуса
+
+    BATCH_LOOP 0
+
+    add     rsp, BATCH_FRAME
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    EPILOGUE
+    ret
+
+.empty:
+    xor     eax, eax ; SUCCESS
     ret
 
+.error_1:
+    mov     rax, ERROR_NULL_ARG
+    ret
+
+
+; =============================================================================
+; @brief Умножение с накоплением: res += a * b (аналог GMP mpn_addmul_1).
+;
+; @details
+; Умножение и сложение выполняются за один проход по словам `a` тем же
+; развернутым телом с вычисляемым входом, что и в bignum_mul_u64, без
+; временного bignum_t. Ядро выбирается при первом вызове так же, как для
+; bignum_mul_u64: на BMI2/ADX используются две цепочки переносов
+; (`adcx` для произведения, `adox` для сложения с res).
+;
+; **Алгоритм:**
+; 1.  Проверка на NULL, проверка `a->len` и `res->len` на [0, BIGNUM_CAPACITY].
+; 2.  Если `a->len == 0` или `b == 0`, res не меняется.
+; 3.  Если `res->len < a->len`, слова res до `a->len` обнуляются.
+; 4.  Основной проход по `a->len` словам: res[i] += a[i] * b + carry.
+; 5.  Перенос распространяется по словам res выше `a->len`; проход
+;     прекращается, как только перенос обнулился.
+; 6.  Ненулевой итоговый перенос записывается в слово L = max(len) или,
+;     если L == BIGNUM_CAPACITY, возвращается переполнение.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (аккумулятор, может совпадать с a)
+; @param[in]  rsi: const bignum_t* a (указатель на структуру)
+; @param[in]  rdx: uint64_t b (множитель)
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1 или -2)
+; @retval 0 – success
+; @retval -1 – null pointer
+; @retval -2 – overflow (или некорректная длина)
+; @clobbers   rcx, rdx, rsi, r8–r11
+; =============================================================================
+    DISPATCH bignum_mul_add_u64, bignum_mul_add_u64_impl
+
+bignum_mul_add_u64_generic:
+    MULACC_BODY MULADD_LIMB, 0, 0
+
+bignum_mul_add_u64_mulx:
+    MULACC_BODY MULXADD_LIMB, 0, 1
+
+; =============================================================================
+; @brief Умножение с вычитанием: res -= a * b (аналог GMP mpn_submul_1).
+;
+; @details
+; Тот же проход, что и у bignum_mul_add_u64, но произведение вычитается
+; из res, а заем идет в следующий перенос. У вычитания нет второго флага
+; заема (аналога `adox`), поэтому используется одно ядро на `mul`.
+; После вычитания старшие нулевые слова отбрасываются из длины.
+;
+; Если a * b > res, возвращается BIGNUM_MUL_U64_ERROR_UNDERFLOW; слова res
+; при этом испорчены, `res->len` не меняется.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (уменьшаемое, может совпадать с a)
+; @param[in]  rsi: const bignum_t* a (указатель на структуру)
+; @param[in]  rdx: uint64_t b (множитель)
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1, -2 или -3)
+; @retval 0 – success
+; @retval -1 – null pointer
+; @retval -2 – некорректная длина
+; @retval -3 – underflow (a * b > res)
+; @clobbers   rcx, rdx, rsi, r8–r11
+; =============================================================================
+bignum_mul_sub_u64:
+    MULACC_BODY MULSUB_LIMB, 1, 0
+
+; -----------------------------------------------------------------------------
+; Слово bignum_mul_u128 на `mul`: a_i * (b_hi:b_lo) плюс отложенные слова
+; rcx (позиция i) и rsi (позиция i + 1). Слово a_i читается один раз (в rdi),
+; до записи r_i, так что res может совпадать с a. Множители — в красной
+; зоне: [rsp - 8] = b_lo, [rsp - 16] = b_hi.
+; -----------------------------------------------------------------------------
+%macro MUL128_LIMB 1
+    mov     rdi, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mov     rax, rdi
+    mul     qword [rsp - 8]                   ; rdx:rax = a_i * b_lo
+    add     rax, rcx
+    adc     rdx, 0
+    mov     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rax
+    mov     r10, rdx                          ; r10 = h0 + перенос
+    mov     rax, rdi
+    mul     qword [rsp - 16]                  ; rdx:rax = a_i * b_hi
+    add     rax, r10
+    adc     rdx, 0
+    add     rax, rsi
+    adc     rdx, 0
+    mov     rcx, rax                          ; позиция i + 1
+    mov     rsi, rdx                          ; позиция i + 2
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Слово bignum_mul_u128 на `mulx` с двумя цепочками переносов.
+;   %1 — слот; %2 — h0 (новое отложенное слово i + 1); %3 — отложенное
+;   слово i (затем l1); %4 — отложенное слово i + 1; %5 — h1 (новое
+;   отложенное слово i + 2).
+; CF (`adcx`) — цепочка r_i = l0 + c0 и h0 + c1; OF (`adox`) — цепочка
+; h0 + l1, она переходит в следующее слово. После `adcx %5, rdi` CF = 0:
+; h1 <= 2^64 - 2. rdi — l0, затем ноль (`mov` не трогает флаги).
+; -----------------------------------------------------------------------------
+%macro MULX128_LIMB 5
+    mov     rdx, [r8 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE]
+    mulx    %2, rdi, [rsp - 8]                ; h0:l0 = a_i * b_lo
+    adcx    rdi, %3
+    mov     [r9 + r11*BIGNUM_WORD_SIZE + %1*BIGNUM_WORD_SIZE], rdi
+    mulx    %5, %3, [rsp - 16]                ; h1:l1 = a_i * b_hi
+    adox    %2, %3
+    adcx    %2, %4
+    mov     edi, 0
+    adcx    %5, rdi
+%endmacro
+
+; -----------------------------------------------------------------------------
+; Тело bignum_mul_u128.  %1 — 0: `mul`, 1: `mulx`/`adcx`/`adox`.
+;
+; Проход развернут в 2 раза; нечетная длина входит сразу во второй слот.
+; Отложенные слова — rcx (позиция i) и rsi (позиция i + 1) на входе слота
+; 0; в ядре на `mulx` слот 1 ожидает их в rax и r10. В конце прохода OF
+; сбрасывается в rsi: отложенное значение меньше b < 2^128, поэтому
+; rsi + OF помещается в слово, и `add r11, 2` может портить флаги.
+; Указатель res на время прохода — в красной зоне ([rsp - 24]).
+; -----------------------------------------------------------------------------
+%macro MUL128_BODY 1
+    test    rdi, rdi
+    jz      .error_1
+    test    rsi, rsi
+    jz      .error_1
+    PROLOGUE
+
+    movsxd  r8, dword [rsi + BIGNUM_OFFSET_LEN] ; r8 = a->len
+    cmp     r8, BIGNUM_CAPACITY
+    ja      .error_2                          ; len < 0 или len > CAPACITY
+    test    r8, r8
+    jz      .zero
+
+    ; Старшие нулевые слова a не умножаются
+.trim:
+    cmp     qword [rsi + r8*BIGNUM_WORD_SIZE - BIGNUM_WORD_SIZE], 0
+    jne     .trimmed
+    dec     r8
+    jnz     .trim
+    jmp     .zero
+.trimmed:
+    mov     rax, rdx
+    or      rax, rcx
+    jz      .zero                             ; b == 0
+
+    mov     [rsp - 8], rdx                    ; b_lo
+    mov     [rsp - 16], rcx                   ; b_hi
+    mov     [rsp - 24], rdi                   ; res
+    mov     r11, r8
+    lea     r8, [rsi + r11*BIGNUM_WORD_SIZE]  ; r8 = &a->words[n]
+    lea     r9, [rdi + r11*BIGNUM_WORD_SIZE]  ; r9 = &res->words[n]
+    neg     r11                               ; r11 = -n
+    xor     eax, eax
+    xor     ecx, ecx
+    xor     esi, esi
+    xor     r10d, r10d                        ; отложенные слова = 0, CF = OF = 0
+    test    r11d, 1
+    jz      .loop
+    lea     r11, [r11 - 1]                    ; нечетная n: -(n + 1), вход в слот 1
+    jmp     .slot_1
+
+.loop:
+%if %1
+    MULX128_LIMB 0, rax, rcx, rsi, r10
+.slot_1:
+    MULX128_LIMB 1, rcx, rax, r10, rsi
+    adox    rsi, rdi                          ; OF -> в rsi, rdi = 0
+%else
+    MUL128_LIMB 0
+.slot_1:
+    MUL128_LIMB 1
+%endif
+    add     r11, 2
+    jnz     .loop
+
+    ; Длина n = (r9 - res) / 8; отложенные слова n и n + 1 — rcx и rsi
+    mov     rdi, [rsp - 24]
+    mov     rax, r9
+    sub     rax, rdi
+    shr     rax, 3                            ; rax = n
+    test    rsi, rsi
+    jnz     .two_words
+    test    rcx, rcx
+    jz      .set_len                          ; len = n
+    cmp     rax, BIGNUM_CAPACITY
+    jae     .error_2
+    mov     [r9], rcx
+    inc     rax
+    jmp     .set_len
+
+.two_words:
+    lea     rdx, [rax + 2]
+    cmp     rdx, BIGNUM_CAPACITY
+    ja      .error_2
+    mov     [r9], rcx
+    mov     [r9 + BIGNUM_WORD_SIZE], rsi
+    mov     rax, rdx
+
+.set_len:
+    mov     [rdi + BIGNUM_OFFSET_LEN], eax
+    xor     eax, eax ; SUCCESS
+    jmp     .epilogue
+
+.zero:
+    mov     dword [rdi + BIGNUM_OFFSET_LEN], 1
+    mov     qword [rdi], 0
+    xor     eax, eax ; SUCCESS
+    jmp     .epilogue
+
+.error_1:
+    mov     rax, ERROR_NULL_ARG
+    ret
+
+.error_2:
+    mov     rax, ERROR_OVERFLOW
+
+.epilogue:
+    EPILOGUE
+    ret
+%endmacro
+
+; =============================================================================
+; @brief Умножение на 128-битный множитель: res = a * (b_hi * 2^64 + b_lo).
+;
+; @details
+; Один проход по словам a вместо двух проходов bignum_mul_u64 и сложения:
+; каждое слово a читается один раз и умножается на обе половины
+; множителя, а два отложенных слова (позиции i и i + 1) переходят в
+; следующее слово. На BMI2/ADX (bignum_mul_u128_mulx) сложения идут по
+; двум цепочкам: `adcx` (CF) и `adox` (OF). Ядро выбирается при первом
+; вызове так же, как у bignum_mul_u64.
+;
+; **Алгоритм:**
+; 1.  Проверка на NULL; `a->len < 0` или `> BIGNUM_CAPACITY` — возврат -2,
+;     `a->len == 0` — результат 0.
+; 2.  Старшие нулевые слова a не умножаются; a == 0 или b == 0 — результат 0.
+; 3.  Проход по n значащим словам: res[i] = младшее слово суммы.
+; 4.  Ненулевые отложенные слова пишутся в res[n] и res[n + 1]; если они не
+;     помещаются в BIGNUM_CAPACITY, возвращается переполнение (слова res
+;     испорчены, `res->len` не меняется). Длина результата точная.
+;
+; @abi        System V AMD64 ABI
+; @param[in]  rdi: bignum_t* res (может совпадать с a)
+; @param[in]  rsi: const bignum_t* a
+; @param[in]  rdx: uint64_t b_lo
+; @param[in]  rcx: uint64_t b_hi
+;
+; @return     rax: bignum_mul_u64_status_t (0, -1 или -2)
+; @clobbers   rcx, rdx, rsi, rdi, r8–r11, красная зона [rsp - 24, rsp)
+; =============================================================================
+    DISPATCH bignum_mul_u128, bignum_mul_u128_impl
+
+bignum_mul_u128_generic:
+    MUL128_BODY 0
+
+bignum_mul_u128_mulx:
+    MUL128_BODY 1
+
+
+section .data
+align 8
+; Указатели на выбранные ядра; до первого вызова — на резолверы.
+%ifdef STATS
+bignum_mul_u64_impl:        dq bignum_mul_u64_dispatch.resolve
+%else
+bignum_mul_u64_impl:        dq bignum_mul_u64.resolve
+%endif
+bignum_mul_add_u64_impl:    dq bignum_mul_add_u64.resolve
+bignum_mul_u64_unchecked_impl: dq bignum_mul_u64_unchecked.resolve
+bignum_mul_u64_batch_impl:  dq bignum_mul_u64_batch.resolve
+bignum_mul_u64_batch_scalar_impl: dq bignum_mul_u64_batch_scalar.resolve
+bignum_mul_u64_n_impl:      dq bignum_mul_u64_n.resolve
+bignum_mul_u64_n_nt_impl:   dq bignum_mul_u64_n_nt.resolve
+bignum_mul_u128_impl:       dq bignum_mul_u128.resolve
+bignum_mul_u64_n2_impl:     dq bignum_mul_u64_n2.resolve
+; Точка `.validated` выбранного ядра; 0 — ядро еще не выбрано.
+bignum_mul_u64_core_impl:   dq 0
+; Длина (в словах), начиная с которой bignum_mul_u64_n пишет мимо кэша.
+bignum_mul_u64_nt_threshold: dq NT_DEFAULT_THRESHOLD
 
+; Стек не исполняемый (иначе `ld -r` и компоновщик помечают объект как execstack)
+section .note.GNU-stack noalloc noexec nowrite progbits
@@ -0,0 +1,104 @@
+/**
+ * @file    bignum_mul_u64_arena.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Пул bignum_t с выровненными по строке кэша слотами (bignum_pool_t).
+ *
+ * @details
+ *   В массиве bignum_t шаг sizeof(bignum_t) не кратен 64 (264 байта при
+ *   емкости 32), поэтому числа начинаются с разных смещений в строке: то
+ *   же число занимает на строку больше, чем выровненное, а соседние числа
+ *   делят строку, и запись одного потока выбивает ее из кэша другого.
+ *   Здесь каждый слот начинается с границы 64 байт и занимает целое число
+ *   строк.
+ *
+ *   Блок арены выровнен на выравнивание слота (64, при шаге, кратном 128, —
+ *   128, чтобы слоты BIGNUM_POOL_PADDED совпадали с парами строк
+ *   предвыборки): первые байты блока на это выравнивание — заголовок
+ *   (указатель на следующий блок), за ним per_chunk слотов. Выдача —
+ *   из списка свободных слотов (ссылка хранится в первом слове слота), а
+ *   если он пуст — следующий нетронутый слот текущего блока; когда блок
+ *   исчерпан, выделяется новый того же размера.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_LINE     64
+#define ARENA_PAIR     128   // Пара строк пространственной предвыборки
+#define ARENA_PAGE     4096
+
+static size_t round_up(size_t x, size_t m) {
+    return (x + m - 1) / m * m;
+}
+
+/** Выравнивание блока и слотов: пара строк, если шаг ей кратен. */
+static size_t arena_align(const bignum_pool_t *pool) {
+    return pool->stride % ARENA_PAIR == 0 ? ARENA_PAIR : ARENA_LINE;
+}
+
+/** Новый блок в голову списка; следующие слоты выдаются из него. */
+static int arena_grow(bignum_pool_t *pool) {
+    size_t align = arena_align(pool);
+    if (pool->per_chunk > (SIZE_MAX - align) / pool->stride) return 0;
+    // Размер кратен выравниванию: шаг кратен ему, заголовок — одна единица
+    size_t size = align + pool->per_chunk * pool->stride;
+    unsigned char *chunk = aligned_alloc(align, size);
+    if (chunk == NULL) return 0;
+    *(void **)chunk = pool->chunks;
+    pool->chunks = chunk;
+    pool->next = chunk + align;
+    pool->end = chunk + size;
+    return 1;
+}
+
+bignum_mul_u64_status_t bignum_pool_init(bignum_pool_t *pool, size_t count, unsigned flags) {
+    if (pool == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    memset(pool, 0, sizeof(*pool));
+    pool->stride = round_up(sizeof(bignum_t), (flags & BIGNUM_POOL_PADDED) ? ARENA_PAIR : ARENA_LINE);
+    pool->per_chunk = count != 0 ? count : ARENA_PAGE / pool->stride;
+    if (pool->per_chunk == 0) pool->per_chunk = 1;
+    if (!arena_grow(pool)) {
+        memset(pool, 0, sizeof(*pool));
+        return BIGNUM_MUL_U64_ERROR_NOMEM;
+    }
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+void bignum_pool_destroy(bignum_pool_t *pool) {
+    if (pool == NULL) return;
+    void *chunk = pool->chunks;
+    while (chunk != NULL) {
+        void *next = *(void **)chunk;
+        free(chunk);
+        chunk = next;
+    }
+    memset(pool, 0, sizeof(*pool));
+}
+
+bignum_t *bignum_pool_alloc(bignum_pool_t *pool) {
+    if (pool == NULL || pool->stride == 0) return NULL;
+    bignum_t *x;
+    if (pool->free != NULL) {
+        x = pool->free;
+        memcpy(&pool->free, x->words, sizeof(void *));
+    } else {
+        if (pool->next == pool->end && !arena_grow(pool)) return NULL;
+        x = (bignum_t *)(void *)pool->next;
+        pool->next += pool->stride;
+    }
+    memset(x, 0, sizeof(*x));
+    return x;
+}
+
+void bignum_pool_free(bignum_pool_t *pool, bignum_t *x) {
+    if (pool == NULL || x == NULL) return;
+    memcpy(x->words, &pool->free, sizeof(void *));
+    pool->free = x;
+}
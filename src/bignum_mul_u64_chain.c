@@ -0,0 +1,111 @@
+/**
+ * @file    bignum_mul_u64_chain.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Произведение на цепочку множителей: bignum_mul_u64_chain.
+ *
+ * @details
+ *   a * b1 * ... * bk через bignum_mul_u64 на каждый множитель — k проходов
+ *   по растущему числу. Малые множители (факториалы, биномиальные
+ *   коэффициенты, произведения простых) здесь сначала перемножаются
+ *   между собой в слове: множитель добавляется в группу, пока сумма
+ *   битовых длин (`lzcnt`) группы и множителя не больше 64, а при сумме 65
+ *   — если старшая половина 128-битного произведения равна нулю. Затем на
+ *   каждую группу делается один проход bignum_mul_u64.
+ *
+ *   До первого прохода по битовым длинам a и групп оценивается длина
+ *   результата: произведение лежит в [2^(L - m), 2^L), где L — сумма длин,
+ *   m — число сомножителей. Если оно заведомо не помещается, возвращается
+ *   переполнение без единого прохода; если заведомо помещается, проходы
+ *   идут прямо в res. Только в промежутке шириной m бит проходы идут во
+ *   временное число, и res меняется лишь при успехе.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <string.h>
+
+__extension__ typedef unsigned __int128 chain_u128_t;
+
+/** Битовая длина x != 0. */
+static unsigned chain_bits(uint64_t x) {
+    return 64u - (unsigned)__builtin_clzll(x);
+}
+
+/**
+ * Следующая группа множителей b[*pos..): их произведение, помещающееся в
+ * слово; *pos сдвигается за группу. Единицы пропускаются; 1 — множителей
+ * больше нет (или все оставшиеся равны 1).
+ */
+static uint64_t chain_next_group(const uint64_t *b, size_t k, size_t *pos) {
+    uint64_t g = 1;
+    size_t i = *pos;
+    for (; i < k; ++i) {
+        uint64_t x = b[i];
+        if (x == 1) continue;
+        unsigned bits = chain_bits(g) + chain_bits(x);
+        if (bits > 65) break;
+        if (bits == 65) {
+            chain_u128_t p = (chain_u128_t)g * x;
+            if ((uint64_t)(p >> 64) != 0) break;
+        }
+        g *= x;
+    }
+    *pos = i;
+    return g;
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_chain(bignum_t *res, const bignum_t *a, const uint64_t *b, size_t k) {
+    if (res == NULL || a == NULL || (b == NULL && k > 0)) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+
+    // Длина читается как в ядре; некорректную отвергнет первый же проход
+    int64_t raw = (int32_t)(uint32_t)a->len;
+    if (raw < 0 || raw > BIGNUM_CAPACITY) return bignum_mul_u64(res, a, 1);
+    for (size_t i = 0; i < k; ++i) {
+        if (b[i] == 0) return bignum_mul_u64(res, a, 0);
+    }
+
+    size_t len = (size_t)raw;
+    while (len > 0 && a->words[len - 1] == 0) --len;
+    if (len == 0) return bignum_mul_u64(res, a, 1);
+
+    // Оценка длины произведения: [high - factors, high) бит
+    size_t high = 64 * (len - 1) + chain_bits(a->words[len - 1]);
+    size_t factors = 1;
+    for (size_t pos = 0; pos < k;) {
+        uint64_t g = chain_next_group(b, k, &pos);
+        if (g == 1) break;
+        high += chain_bits(g);
+        ++factors;
+    }
+    const size_t limit = 64 * (size_t)BIGNUM_CAPACITY;
+    if (high - factors >= limit) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+
+    bignum_t tmp;
+    bignum_t *dst = res;
+    if (high > limit) {
+        // Промежуток: переполнение покажет только последний проход
+        tmp.len = 0;
+        dst = &tmp;
+    }
+
+    const bignum_t *src = a;
+    for (size_t pos = 0; pos < k;) {
+        uint64_t g = chain_next_group(b, k, &pos);
+        if (g == 1) break;
+        bignum_mul_u64_status_t st = bignum_mul_u64(dst, src, g);
+        if (st != BIGNUM_MUL_U64_SUCCESS) return st;
+        src = dst;
+    }
+    if (src == a) return bignum_mul_u64(res, a, 1);   // Все множители равны 1
+
+    if (dst == &tmp) {
+        memcpy(res->words, tmp.words, tmp.len * sizeof(uint64_t));
+        res->len = tmp.len;
+    }
+    return BIGNUM_MUL_U64_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file    bignum_mul_u64_fanout.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Одно множимое на несколько множителей: bignum_mul_u64_fanout.
+ *
+ * @details
+ *   k вызовов bignum_mul_u64 с одним `a` — k проверок аргументов, k
+ *   сокращений длины и k проходов по a->words, каждый с одной цепочкой
+ *   переносов: `mul` следующего слова ждет перенос предыдущего. Здесь `a`
+ *   проверяется и сокращается один раз, а выходы обрабатываются группами
+ *   по FANOUT_GROUP проходами bignum_mul_u64_n2: слово a читается один раз
+ *   на группу и умножается на все ее множители, у каждого выхода свой
+ *   регистр переноса. Цепочки независимы, и умножения группы идут
+ *   параллельно, а a читается в FANOUT_GROUP раз реже. Остаток
+ *   k mod FANOUT_GROUP выходов — проходы bignum_mul_u64_n.
+ *
+ *   Группа больше пары не окупается: у `adcx`/`adox` только две цепочки
+ *   флагов, а переносы в регистрах (`add`/`adc` и `mov` на выход) дают
+ *   столько же команд на произведение, сколько одиночный проход.
+ *
+ *   Проход по группе читает слово a до записи результатов, но группы идут
+ *   одна за другой, поэтому выход на месте a портил бы множимое следующих
+ *   групп: в этом случае значащие слова a сначала копируются.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <string.h>
+
+/**
+ * Выходов в группе — по цепочке переносов на выход: на BMI2/ADX это флаги
+ * CF и OF, поэтому группа — пара.
+ */
+#define FANOUT_GROUP 2
+
+/** Перенос и длина одного выхода; n — значащая длина a, слова уже записаны. */
+static bignum_mul_u64_status_t fanout_finish(bignum_t *r, size_t n, uint64_t b, uint64_t carry) {
+    if (b == 0) {
+        r->len = 1;   // Слова прохода — нули
+        return BIGNUM_MUL_U64_SUCCESS;
+    }
+    if (carry != 0) {
+        if (n == BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        r->words[n++] = carry;
+    }
+    r->len = n;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_fanout(bignum_t *res[], const bignum_t *a, const uint64_t *b, size_t k) {
+    if (a == NULL || (k > 0 && (res == NULL || b == NULL))) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    for (size_t j = 0; j < k; ++j) {
+        if (res[j] == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    }
+    // Длина читается как в ядре
+    int64_t raw = (int32_t)(uint32_t)a->len;
+    if (raw < 0 || raw > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+
+    size_t n = (size_t)raw;
+    while (n > 0 && a->words[n - 1] == 0) --n;
+    if (n == 0) {
+        for (size_t j = 0; j < k; ++j) {
+            res[j]->words[0] = 0;
+            res[j]->len = 1;
+        }
+        return BIGNUM_MUL_U64_SUCCESS;
+    }
+
+    // Выход на месте a испортил бы множимое следующих групп
+    const uint64_t *src = a->words;
+    uint64_t copy[BIGNUM_CAPACITY];
+    for (size_t j = 0; j < k; ++j) {
+        if (res[j] == a) {
+            memcpy(copy, a->words, n * sizeof(uint64_t));
+            src = copy;
+            break;
+        }
+    }
+
+    bignum_mul_u64_status_t status = BIGNUM_MUL_U64_SUCCESS;
+    size_t j = 0;
+    for (; j + FANOUT_GROUP <= k; j += FANOUT_GROUP) {
+        uint64_t *dst[FANOUT_GROUP];
+        for (size_t g = 0; g < FANOUT_GROUP; ++g) dst[g] = res[j + g]->words;
+        bignum_mul_u64_carry2_t carry = bignum_mul_u64_n2(dst, src, n, b + j);
+        for (size_t g = 0; g < FANOUT_GROUP; ++g) {
+            if (fanout_finish(res[j + g], n, b[j + g], carry.carry[g]) != BIGNUM_MUL_U64_SUCCESS) {
+                status = BIGNUM_MUL_U64_ERROR_OVERFLOW;
+            }
+        }
+    }
+    for (; j < k; ++j) {
+        uint64_t carry = bignum_mul_u64_n(res[j]->words, src, n, b[j]);
+        if (fanout_finish(res[j], n, b[j], carry) != BIGNUM_MUL_U64_SUCCESS) {
+            status = BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file    bignum_mul_u64_ifma.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Пакетное умножение bignum_t на uint64_t на AVX-512 IFMA.
+ *
+ * @details
+ *   Восемь независимых умножений a[i] * b[i] выполняются одновременно:
+ *   слово (и цифра) k восьми чисел лежит в одном zmm-регистре (транспонированная
+ *   раскладка по слоям). Внутри используется основание 2^52:
+ *   1. Слова восьми чисел загружаются блоками 8x8 (маскированные загрузки,
+ *      слова выше len читаются как 0) и транспонируются.
+ *   2. Слова переводятся в 52-битные цифры A_k, множитель — в цифры
+ *      b0 (52 бита) и b1 (12 бит).
+ *   3. `vpmadd52luq`/`vpmadd52huq` накапливают младшие и старшие 52 бита
+ *      произведений A_k * b0 и A_k * b1 в R_k, R_k+1, R_k+2 (каждая сумма
+ *      меньше 2^54, переноса между словами нет).
+ *   4. Перенос нормализует R к 52-битным цифрам, цифры переводятся обратно
+ *      в 64-битные слова, транспонируются и записываются маскированно.
+ *
+ *   Векторный путь берется для группы из восьми элементов, если у всех
+ *   одинаковая корректная длина и b != 0. Иначе (разные длины, b == 0,
+ *   некорректная длина) и для остатка n mod 8 элементы обрабатываются
+ *   скалярным ядром `bignum_mul_u64`. Статусы, результат и
+ *   `res->len` совпадают с bignum_mul_u64_batch_generic.
+ *
+ *   Код собирается с `target("avx512f,avx512ifma")` и вызывается только
+ *   после проверки CPUID в `bignum_mul_u64_select`.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Длина результата сокращается до значащей, как
+ *                          в скалярном ядре.
+ */
+
+#include "bignum_mul_u64.h"
+#include <immintrin.h>
+
+#define IFMA_LANES       8
+#define IFMA_DIGIT_BITS  52
+#define IFMA_DIGIT_MASK  ((1ULL << IFMA_DIGIT_BITS) - 1)
+
+/* Слов в произведении не больше BIGNUM_CAPACITY + 1; +2 — цифры переноса R_k+1, R_k+2 */
+#define IFMA_MAX_WORDS   (((BIGNUM_CAPACITY + 1) + IFMA_LANES - 1) / IFMA_LANES * IFMA_LANES)
+#define IFMA_MAX_DIGITS  ((64 * (BIGNUM_CAPACITY + 1) + IFMA_DIGIT_BITS - 1) / IFMA_DIGIT_BITS + 3)
+
+#define IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+
+/**
+ * @brief Транспонирует матрицу 8x8 из 64-битных слов (r[i][j] -> r[j][i]).
+ */
+IFMA_TARGET static inline void ifma_transpose8(__m512i r[IFMA_LANES]) {
+    const __m512i lo128 = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+    const __m512i hi128 = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+    const __m512i lo256 = _mm512_set_epi64(11, 10, 9, 8, 3, 2, 1, 0);
+    const __m512i hi256 = _mm512_set_epi64(15, 14, 13, 12, 7, 6, 5, 4);
+    __m512i t[IFMA_LANES], u[IFMA_LANES];
+
+    for (int i = 0; i < IFMA_LANES; i += 2) {
+        t[i]     = _mm512_unpacklo_epi64(r[i], r[i + 1]);
+        t[i + 1] = _mm512_unpackhi_epi64(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < IFMA_LANES; i += 4) {
+        u[i]     = _mm512_permutex2var_epi64(t[i],     lo128, t[i + 2]);
+        u[i + 1] = _mm512_permutex2var_epi64(t[i + 1], lo128, t[i + 3]);
+        u[i + 2] = _mm512_permutex2var_epi64(t[i],     hi128, t[i + 2]);
+        u[i + 3] = _mm512_permutex2var_epi64(t[i + 1], hi128, t[i + 3]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        r[i]     = _mm512_permutex2var_epi64(u[i], lo256, u[i + 4]);
+        r[i + 4] = _mm512_permutex2var_epi64(u[i], hi256, u[i + 4]);
+    }
+}
+
+IFMA_TARGET static inline __m512i ifma_srl(__m512i x, unsigned n) {
+    return _mm512_srl_epi64(x, _mm_cvtsi32_si128((int)n));
+}
+
+IFMA_TARGET static inline __m512i ifma_sll(__m512i x, unsigned n) {
+    return _mm512_sll_epi64(x, _mm_cvtsi32_si128((int)n));
+}
+
+/**
+ * @brief Умножает 8 чисел одинаковой длины len на 8 множителей.
+ *
+ * @details Пишет len слов в каждый res[j]; слово переноса (len) — в top[j].
+ *          Все слова a читаются до первой записи в res, поэтому res[j] может
+ *          совпадать с a[j].
+ */
+IFMA_TARGET static void ifma_mul8(bignum_t *res, const bignum_t *a, __m512i vb,
+                                  size_t len, uint64_t top[IFMA_LANES]) {
+    const __m512i mask52 = _mm512_set1_epi64((long long)IFMA_DIGIT_MASK);
+    __m512i w[IFMA_MAX_WORDS];
+    __m512i d[IFMA_MAX_DIGITS];
+
+    /* 1. Загрузка и транспонирование блоками по 8 слов */
+    for (size_t q = 0; q < len; q += IFMA_LANES) {
+        size_t rem = len - q;
+        __mmask8 m = (__mmask8)(rem >= IFMA_LANES ? 0xFF : (1u << rem) - 1);
+        for (int j = 0; j < IFMA_LANES; ++j) {
+            w[q + j] = _mm512_maskz_loadu_epi64(m, &a[j].words[q]);
+        }
+        ifma_transpose8(&w[q]);
+    }
+
+    /* 2. 64-битные слова -> 52-битные цифры */
+    size_t digits = (64 * len + IFMA_DIGIT_BITS - 1) / IFMA_DIGIT_BITS;
+    for (size_t k = 0; k < digits; ++k) {
+        size_t bit = k * IFMA_DIGIT_BITS;
+        size_t wi = bit / 64;
+        unsigned s = (unsigned)(bit % 64);
+        __m512i x = ifma_srl(w[wi], s);
+        if (s > 64 - IFMA_DIGIT_BITS && wi + 1 < len) {
+            x = _mm512_or_si512(x, ifma_sll(w[wi + 1], 64 - s));
+        }
+        d[k] = _mm512_and_si512(x, mask52);
+    }
+
+    /* 3. R = A * b: b = b0 + b1 * 2^52 */
+    const __m512i b0 = _mm512_and_si512(vb, mask52);
+    const __m512i b1 = _mm512_srli_epi64(vb, IFMA_DIGIT_BITS);
+    __m512i r[IFMA_MAX_DIGITS];
+    for (size_t k = 0; k < digits + 2; ++k) {
+        r[k] = _mm512_setzero_si512();
+    }
+    for (size_t k = 0; k < digits; ++k) {
+        r[k]     = _mm512_madd52lo_epu64(r[k],     d[k], b0);
+        r[k + 1] = _mm512_madd52hi_epu64(r[k + 1], d[k], b0);
+        r[k + 1] = _mm512_madd52lo_epu64(r[k + 1], d[k], b1);
+        r[k + 2] = _mm512_madd52hi_epu64(r[k + 2], d[k], b1);
+    }
+
+    /* 4. Нормализация переноса: R -> 52-битные цифры (на месте d) */
+    __m512i carry = _mm512_setzero_si512();
+    for (size_t k = 0; k < digits + 2; ++k) {
+        __m512i t = _mm512_add_epi64(r[k], carry);
+        d[k] = _mm512_and_si512(t, mask52);
+        carry = _mm512_srli_epi64(t, IFMA_DIGIT_BITS);
+    }
+    d[digits + 2] = _mm512_setzero_si512();
+
+    /* 5. 52-битные цифры -> len + 1 64-битных слов */
+    for (size_t wi = 0; wi <= len; ++wi) {
+        size_t bit = wi * 64;
+        size_t k = bit / IFMA_DIGIT_BITS;
+        unsigned t = (unsigned)(bit % IFMA_DIGIT_BITS);
+        __m512i x = _mm512_or_si512(ifma_srl(d[k], t), ifma_sll(d[k + 1], IFMA_DIGIT_BITS - t));
+        if (t > 2 * IFMA_DIGIT_BITS - 64) {
+            x = _mm512_or_si512(x, ifma_sll(d[k + 2], 2 * IFMA_DIGIT_BITS - t));
+        }
+        w[wi] = x;
+    }
+    _mm512_storeu_si512((void *)top, w[len]);
+
+    /* 6. Обратное транспонирование и маскированная запись len слов */
+    for (size_t q = 0; q < len; q += IFMA_LANES) {
+        size_t rem = len - q;
+        __mmask8 m = (__mmask8)(rem >= IFMA_LANES ? 0xFF : (1u << rem) - 1);
+        ifma_transpose8(&w[q]);
+        for (int j = 0; j < IFMA_LANES; ++j) {
+            _mm512_mask_storeu_epi64(&res[j].words[q], m, w[q + j]);
+        }
+    }
+}
+
+/**
+ * @brief Общий цикл пакета; b_step = 1 — массив множителей, 0 — один множитель.
+ */
+IFMA_TARGET static bignum_mul_u64_status_t ifma_batch(bignum_t *res, const bignum_t *a,
+                                                      const uint64_t *b, size_t b_step, size_t n,
+                                                      bignum_mul_u64_status_t *status_out) {
+    bignum_mul_u64_status_t first = BIGNUM_MUL_U64_SUCCESS;
+    size_t i = 0;
+
+    for (; i + IFMA_LANES <= n; i += IFMA_LANES) {
+        /* Длина читается как в ядре: младшие 32 бита со знаком */
+        int64_t len = (int32_t)(uint32_t)a[i].len;
+        int uniform = len >= 1 && len <= BIGNUM_CAPACITY;
+        for (size_t j = 0; j < IFMA_LANES && uniform; ++j) {
+            uniform = (int64_t)(int32_t)(uint32_t)a[i + j].len == len && b[(i + j) * b_step] != 0;
+        }
+        if (!uniform) {
+            for (size_t j = 0; j < IFMA_LANES; ++j) {
+                bignum_mul_u64_status_t st = bignum_mul_u64(&res[i + j], &a[i + j], b[(i + j) * b_step]);
+                if (status_out) status_out[i + j] = st;
+                if (st != BIGNUM_MUL_U64_SUCCESS && first == BIGNUM_MUL_U64_SUCCESS) first = st;
+            }
+            continue;
+        }
+
+        __m512i vb = b_step ? _mm512_loadu_si512((const void *)&b[i]) : _mm512_set1_epi64((long long)b[0]);
+        uint64_t top[IFMA_LANES];
+        ifma_mul8(&res[i], &a[i], vb, (size_t)len, top);
+
+        for (size_t j = 0; j < IFMA_LANES; ++j) {
+            bignum_mul_u64_status_t st = BIGNUM_MUL_U64_SUCCESS;
+            size_t rl = (size_t)len;
+            if (top[j] != 0) {
+                if (rl >= BIGNUM_CAPACITY) {
+                    st = BIGNUM_MUL_U64_ERROR_OVERFLOW; /* len не меняется, как в ядре */
+                } else {
+                    res[i + j].words[rl++] = top[j];
+                }
+            } else {
+                /* Старшие нулевые слова a дают нули: длина точная, как в ядре */
+                while (rl > 1 && res[i + j].words[rl - 1] == 0) --rl;
+            }
+            if (st == BIGNUM_MUL_U64_SUCCESS) res[i + j].len = rl;
+            if (status_out) status_out[i + j] = st;
+            if (st != BIGNUM_MUL_U64_SUCCESS && first == BIGNUM_MUL_U64_SUCCESS) first = st;
+        }
+    }
+
+    for (; i < n; ++i) {
+        bignum_mul_u64_status_t st = bignum_mul_u64(&res[i], &a[i], b[i * b_step]);
+        if (status_out) status_out[i] = st;
+        if (st != BIGNUM_MUL_U64_SUCCESS && first == BIGNUM_MUL_U64_SUCCESS) first = st;
+    }
+    return first;
+}
+
+IFMA_TARGET bignum_mul_u64_status_t bignum_mul_u64_batch_ifma(bignum_t *res, const bignum_t *a,
+                                                              const uint64_t *b, size_t n,
+                                                              bignum_mul_u64_status_t *status_out) {
+    if (n == 0) return BIGNUM_MUL_U64_SUCCESS;
+    if (res == NULL || a == NULL || b == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    return ifma_batch(res, a, b, 1, n, status_out);
+}
+
+IFMA_TARGET bignum_mul_u64_status_t bignum_mul_u64_batch_scalar_ifma(bignum_t *res, const bignum_t *a,
+                                                                     uint64_t b, size_t n,
+                                                                     bignum_mul_u64_status_t *status_out) {
+    if (n == 0) return BIGNUM_MUL_U64_SUCCESS;
+    if (res == NULL || a == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    return ifma_batch(res, a, &b, 0, n, status_out);
+}
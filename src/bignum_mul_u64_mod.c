@@ -0,0 +1,190 @@
+/**
+ * @file    bignum_mul_u64_mod.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Умножение по модулю: bignum_mul_u64_mod_init и bignum_mul_u64_mod.
+ *
+ * @details
+ *   При a < m произведение a * b меньше m * 2^64, так что его частное от
+ *   деления на m помещается в одно слово: приведение — это вычитание
+ *   q * m с одним словом q, а не деление. q находится до прохода по
+ *   старшим словам произведения: модуль нормализуется сдвигом (старший
+ *   бит — единица), и три старших слова сдвинутого произведения делятся на
+ *   два старших слова сдвинутого модуля делением 3 на 2 с заранее
+ *   вычисленной обратной величиной (Möller–Granlund, как `udiv_qr_3by2` в
+ *   GMP) — два умножения вместо деления.
+ *
+ *   Старшие слова a * b для оценки берутся из четырех старших слов a: не
+ *   учтенный перенос из младших слов меньше единицы третьего слова окна
+ *   и ошибается в q не более чем на единицу. Вместе с ошибкой деления 3
+ *   на 2 это дает a * b - q * m в [-m, 2m), и его вычисление — один проход:
+ *   в цепочке переносов a * b на каждое слово сразу вычитается слово
+ *   q * m. Остаток вне [0, m) исправляется проходом сложения или
+ *   вычитания m, что случается с вероятностью порядка 2^-64.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <string.h>
+
+__extension__ typedef unsigned __int128 mod_u128_t;
+
+/** floor((2^192 - 1) / (d1:d0)) - 2^64 при старшем бите d1, равном 1. */
+static uint64_t mod_reciprocal(uint64_t d1, uint64_t d0) {
+    const mod_u128_t d = ((mod_u128_t)d1 << 64) | d0;
+    mod_u128_t rem = 0;
+    uint64_t q = 0;
+    // Деление столбиком по битам делимого, все 192 бита — единицы
+    for (int bit = 0; bit < 192; ++bit) {
+        int top = (int)(rem >> 127);
+        rem = (rem << 1) | 1;
+        q <<= 1;
+        if (top || rem >= d) {
+            rem -= d;
+            q |= 1;
+        }
+    }
+    return q;   // Частное в (2^64, 2^65]: младшие 64 бита — частное минус 2^64
+}
+
+/** floor((n2:n1:n0) / (d1:d0)) при (n2:n1) < (d1:d0); как udiv_qr_3by2 в GMP. */
+static uint64_t mod_div_3by2(uint64_t n2, uint64_t n1, uint64_t n0, uint64_t d1, uint64_t d0, uint64_t dinv) {
+    const mod_u128_t d = ((mod_u128_t)d1 << 64) | d0;
+    mod_u128_t p = (mod_u128_t)n2 * dinv + (((mod_u128_t)n2 << 64) | n1);
+    uint64_t q = (uint64_t)(p >> 64);
+    uint64_t q0 = (uint64_t)p;
+    uint64_t r1 = n1 - d1 * q;
+    mod_u128_t r = (((mod_u128_t)r1 << 64) | n0) - d;
+    r -= (mod_u128_t)d0 * q;
+    ++q;
+    if ((uint64_t)(r >> 64) >= q0) {
+        --q;
+        r += d;
+    }
+    if (r >= d) ++q;
+    return q;
+}
+
+/** Сравнение r[0..n) с m[0..n): не меньше ли r. */
+static int mod_geq(const uint64_t *r, const uint64_t *m, size_t n) {
+    for (size_t i = n; i-- > 0;) {
+        if (r[i] != m[i]) return r[i] > m[i];
+    }
+    return 1;
+}
+
+/**
+ * r[0..n) = a * b - q * m одним проходом; a[0..alen), alen <= n, старшие
+ * слова a как бы нули. r может совпадать с a: слово a читается до записи
+ * того же слова r. Возвращает старшее слово разности со знаком.
+ */
+static int64_t mod_mul_submul(uint64_t *r, const uint64_t *a, size_t alen, uint64_t b, uint64_t q,
+                              const uint64_t *m, size_t n) {
+    uint64_t c_ab = 0, c_qm = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t ai = i < alen ? a[i] : 0;
+        mod_u128_t p = (mod_u128_t)ai * b + c_ab;
+        // Заем входит в перенос q * m: q * m[i] + c_qm + 1 < 2^128
+        mod_u128_t t = (mod_u128_t)q * m[i] + c_qm;
+        uint64_t lo_p = (uint64_t)p, lo_t = (uint64_t)t;
+        r[i] = lo_p - lo_t;
+        c_ab = (uint64_t)(p >> 64);
+        c_qm = (uint64_t)(t >> 64) + (lo_p < lo_t);
+    }
+    return (int64_t)(c_ab - c_qm);
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_mod_init(bignum_mul_u64_mod_ctx_t *ctx, const bignum_t *m) {
+    if (ctx == NULL || m == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    int64_t raw = (int32_t)(uint32_t)m->len;
+    if (raw < 0 || raw > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    size_t n = (size_t)raw;
+    while (n > 0 && m->words[n - 1] == 0) --n;
+    if (n == 0) return BIGNUM_MUL_U64_ERROR_DOMAIN;
+
+    memcpy(ctx->m, m->words, n * sizeof(uint64_t));
+    ctx->len = n;
+    ctx->shift = (unsigned)__builtin_clzll(m->words[n - 1]);
+
+    // Два старших слова m << shift (младших слов ниже нулевого как бы нули)
+    uint64_t w1 = m->words[n - 1];
+    uint64_t w0 = n >= 2 ? m->words[n - 2] : 0;
+    uint64_t wm = n >= 3 ? m->words[n - 3] : 0;
+    unsigned s = ctx->shift;
+    ctx->d1 = s == 0 ? w1 : (w1 << s) | (w0 >> (64 - s));
+    ctx->d0 = s == 0 ? w0 : (w0 << s) | (wm >> (64 - s));
+    ctx->dinv = mod_reciprocal(ctx->d1, ctx->d0);
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_mod(bignum_t *res, const bignum_t *a, uint64_t b,
+                                           const bignum_mul_u64_mod_ctx_t *ctx) {
+    if (res == NULL || a == NULL || ctx == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    int64_t raw = (int32_t)(uint32_t)a->len;
+    if (raw < 0 || raw > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+
+    const size_t n = ctx->len;
+    const uint64_t *m = ctx->m;
+    size_t alen = (size_t)raw;
+    while (alen > 0 && a->words[alen - 1] == 0) --alen;
+    if (alen > n || (alen == n && mod_geq(a->words, m, n))) return BIGNUM_MUL_U64_ERROR_DOMAIN;
+
+    // x[n-3..n] = слова a * b по a[n-4..n-1]; перенос из a[0..n-4) не учтен
+    uint64_t x[4];
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        size_t idx = n + i - 4;   // Индексы ниже нуля переполняются и не меньше alen
+        uint64_t ai = idx < alen ? a->words[idx] : 0;
+        mod_u128_t p = (mod_u128_t)ai * b + carry;
+        if (i > 0) x[i - 1] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    x[3] = carry;
+
+    // Окно из трех старших слов (a * b) << shift и оценка частного
+    const unsigned s = ctx->shift;
+    uint64_t n2 = x[3], n1 = x[2], n0 = x[1];
+    if (s != 0) {
+        n2 = (x[3] << s) | (x[2] >> (64 - s));
+        n1 = (x[2] << s) | (x[1] >> (64 - s));
+        n0 = (x[1] << s) | (x[0] >> (64 - s));
+    }
+    uint64_t q;
+    if (n2 > ctx->d1 || (n2 == ctx->d1 && n1 >= ctx->d0)) {
+        q = UINT64_MAX;
+    } else {
+        q = mod_div_3by2(n2, n1, n0, ctx->d1, ctx->d0, ctx->dinv);
+    }
+
+    // Один проход прямо в res: ошибок дальше нет
+    uint64_t *r = res->words;
+    int64_t top = mod_mul_submul(r, a->words, alen, b, q, m, n);
+
+    while (top < 0) {
+        uint64_t c = 0;
+        for (size_t i = 0; i < n; ++i) {
+            mod_u128_t sum = (mod_u128_t)r[i] + m[i] + c;
+            r[i] = (uint64_t)sum;
+            c = (uint64_t)(sum >> 64);
+        }
+        top += (int64_t)c;
+    }
+    while (top > 0 || mod_geq(r, m, n)) {
+        uint64_t c = 0;
+        for (size_t i = 0; i < n; ++i) {
+            mod_u128_t diff = (mod_u128_t)r[i] - m[i] - c;
+            r[i] = (uint64_t)diff;
+            c = (uint64_t)(diff >> 64) & 1;
+        }
+        top -= (int64_t)c;
+    }
+
+    size_t len = n;
+    while (len > 1 && r[len - 1] == 0) --len;
+    res->len = len;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
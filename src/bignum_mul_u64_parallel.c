@@ -0,0 +1,148 @@
+/**
+ * @file    bignum_mul_u64_parallel.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Многопоточное умножение массива слов: bignum_mul_u64_n_parallel.
+ *
+ * @details
+ *   На операндах в мегабайты bignum_mul_u64_n упирается в пропускную
+ *   способность памяти одного ядра. Цепочку переноса можно разрезать:
+ *   каждый кусок умножается независимо с нулевым входным переносом, а
+ *   затем последовательный проход добавляет перенос куска t-1 к началу
+ *   куска t. Перенос почти всегда гасится в первом же слове, так что
+ *   проход стоит O(число потоков).
+ *
+ *   Кусок t обрабатывается потоком t (кусок 0 — вызывающим потоком).
+ *   Поток t создается закрепленным за t-м процессором маски affinity
+ *   процесса (по модулю их числа). Границы выровнены по страницам `dst` и
+ *   зависят только от (dst, n, threads), поэтому при одинаковом разбиении
+ *   кусок t каждый раз пишет тот же процессор: страницы, впервые записанные
+ *   им, остаются в его NUMA-узле (политика first-touch), и повторные вызовы
+ *   читают и пишут локальную память. Кусок 0 идет там, где выполняется
+ *   вызывающий поток; его не перезакрепляют.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Рабочие потоки закрепляются за процессорами.
+ */
+
+#define _GNU_SOURCE
+
+#include "bignum_mul_u64.h"
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define PAR_PAGE_WORDS       (4096 / sizeof(uint64_t))
+// Меньшие куски не окупают создание потока
+#define PAR_MIN_CHUNK_WORDS  ((size_t)1 << 16)
+#define PAR_MAX_THREADS      256
+
+typedef struct {
+    uint64_t       *dst;
+    const uint64_t *src;
+    size_t          n;
+    uint64_t        b;
+    uint64_t        carry;
+} par_chunk_t;
+
+static void *par_worker(void *arg) {
+    par_chunk_t *c = arg;
+    c->carry = bignum_mul_u64_n(c->dst, c->src, c->n, c->b);
+    return NULL;
+}
+
+/**
+ * Первые max процессоров маски affinity процесса по порядку; возвращает их
+ * число (0, если маску прочитать не удалось).
+ */
+static unsigned par_cpus(int *cpus, unsigned max) {
+    cpu_set_t set;
+    unsigned n = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return 0;
+    for (int c = 0; c < CPU_SETSIZE && n < max; ++c) {
+        if (CPU_ISSET(c, &set)) cpus[n++] = c;
+    }
+    return n;
+}
+
+/**
+ * Граница куска t из threads: t * n / threads, округленная вниз до страницы
+ * dst. При куске не меньше страницы границы возрастают.
+ */
+static size_t par_boundary(const uint64_t *dst, size_t n, unsigned t, unsigned threads) {
+    if (t == 0) return 0;
+    if (t == threads) return n;
+    size_t misalign = ((uintptr_t)dst / sizeof(uint64_t)) % PAR_PAGE_WORDS;
+    size_t q = n / threads * t + n % threads * t / threads;
+    return (q + misalign) / PAR_PAGE_WORDS * PAR_PAGE_WORDS - misalign;
+}
+
+uint64_t bignum_mul_u64_n_parallel(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b,
+                                   unsigned threads) {
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned)online : 1;
+    }
+    if (threads > PAR_MAX_THREADS) threads = PAR_MAX_THREADS;
+    if (threads > n / PAR_MIN_CHUNK_WORDS) threads = (unsigned)(n / PAR_MIN_CHUNK_WORDS);
+    if (threads <= 1) return bignum_mul_u64_n(dst, src, n, b);
+
+    par_chunk_t chunks[PAR_MAX_THREADS];
+    pthread_t tid[PAR_MAX_THREADS];
+    int started[PAR_MAX_THREADS];
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t lo = par_boundary(dst, n, t, threads);
+        size_t hi = par_boundary(dst, n, t + 1, threads);
+        chunks[t].dst = dst + lo;
+        chunks[t].src = src + lo;
+        chunks[t].n = hi - lo;
+        chunks[t].b = b;
+        chunks[t].carry = 0;
+    }
+
+    // Поток t — на t-м процессоре маски. Если закрепленный поток не
+    // создается, пробуем без закрепления; поток, который не удалось создать
+    // совсем, заменяет вызывающий
+    int cpus[PAR_MAX_THREADS];
+    unsigned ncpus = par_cpus(cpus, threads);
+    pthread_attr_t attr;
+    int pinned = ncpus > 0 && pthread_attr_init(&attr) == 0;
+    for (unsigned t = 1; t < threads; ++t) {
+        started[t] = 0;
+        if (pinned) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpus[t % ncpus], &set);
+            started[t] = pthread_attr_setaffinity_np(&attr, sizeof(set), &set) == 0 &&
+                         pthread_create(&tid[t], &attr, par_worker, &chunks[t]) == 0;
+        }
+        if (!started[t]) started[t] = pthread_create(&tid[t], NULL, par_worker, &chunks[t]) == 0;
+    }
+    if (pinned) pthread_attr_destroy(&attr);
+    par_worker(&chunks[0]);
+    for (unsigned t = 1; t < threads; ++t) {
+        if (started[t]) {
+            pthread_join(tid[t], NULL);
+        } else {
+            par_worker(&chunks[t]);
+        }
+    }
+
+    // Последовательная коррекция: перенос куска t-1 — в начало куска t.
+    // Сумма переноса волны и переноса куска не переполняется: произведение
+    // куска плюс входной перенос меньше 2^(64 * (n_t + 1)).
+    uint64_t carry = chunks[0].carry;
+    for (unsigned t = 1; t < threads; ++t) {
+        uint64_t *p = chunks[t].dst;
+        for (size_t i = 0; carry != 0 && i < chunks[t].n; ++i) {
+            uint64_t s = p[i] + carry;
+            carry = s < carry;
+            p[i] = s;
+        }
+        carry += chunks[t].carry;
+    }
+    return carry;
+}
@@ -0,0 +1,469 @@
+/**
+ * @file    bignum_mul_u64_pool.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Асинхронное пакетное умножение на пуле потоков с кражей работы.
+ *
+ * @details
+ *   Задание (res[], a[], b[], n) режется на куски по POOL_CHUNK_BYTES
+ *   операндов; кусок — один вызов bignum_mul_u64_batch. Отправка кладет
+ *   задание в общую очередь под мьютексом (одна блокировка на задание, а не
+ *   на кусок). Свободный рабочий поток забирает задание и раскладывает его
+ *   куски в свой дек, остальные рабочие крадут куски с противоположного
+ *   конца. Так пачки разного размера от разных вызывающих потоков
+ *   выравниваются по ядрам без центрального счетчика.
+ *
+ *   Дек — Chase-Lev с фиксированным кольцом (Lê, Pop, Cohen, Zappa Nardelli,
+ *   "Correct and Efficient Work-Stealing for Weak Memory Models", 2013):
+ *   владелец кладет и берет снизу без атомарных RMW, кроме спора за
+ *   последний элемент, вор забирает сверху через CAS. Куски кладутся от
+ *   последнего к первому, так что владелец идет по памяти вперед, а воры
+ *   берут дальний конец задания. Если кольцо заполнено, кусок выполняется
+ *   сразу.
+ *
+ *   Простаивающий рабочий засыпает на условной переменной. Эпоха работы
+ *   читается до обхода чужих деков и сверяется под мьютексом перед сном:
+ *   если задание или новые куски появились за время обхода, рабочий не
+ *   засыпает.
+ *
+ *   Задание завершает рабочий, выполнивший последний кусок: он находит
+ *   первый неуспешный статус по кускам (как bignum_mul_u64_batch), вызывает
+ *   обратный вызов и отмечает задание выполненным. Задание без дескриптора
+ *   освобождается им же.
+ *
+ *   bignum_mul_u64_n_parallel_pool кладет в ту же очередь задание над
+ *   массивом слов: кусок — вызов bignum_mul_u64_n на отрезке, границы
+ *   которого выровнены по строкам `dst`, с нулевым входным переносом.
+ *   Вызывающий поток ждет задание и, как bignum_mul_u64_n_parallel,
+ *   последовательно добавляет перенос каждого куска к началу следующего.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Задания над массивом слов
+ *                          (bignum_mul_u64_n_parallel_pool).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bignum_mul_u64.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Кусок: результаты и множимые занимают около L1d
+#define POOL_CHUNK_BYTES  (32 * 1024)
+#define POOL_DEQUE_SIZE   1024  // Степень двойки
+#define POOL_MAX_THREADS  256
+#define POOL_CACHE_LINE   64
+#define POOL_LINE_WORDS   (POOL_CACHE_LINE / sizeof(uint64_t))
+// Меньшие куски массива слов не окупают пробуждение рабочего
+#define POOL_SPAN_MIN_WORDS ((size_t)1 << 14)
+
+typedef struct pool_task {
+    bignum_mul_u64_job_t    *job;
+    size_t                   lo;
+    size_t                   hi;
+    bignum_mul_u64_status_t  status;
+    uint64_t                 carry;    // Перенос куска массива слов
+} pool_task_t;
+
+struct bignum_mul_u64_job {
+    struct bignum_mul_u64_job *next;       // Очередь отправки
+    bignum_t                  *res;
+    const bignum_t            *a;
+    const uint64_t            *b;
+    uint64_t                  *dst;        // Задание над массивом слов, иначе NULL
+    const uint64_t            *src;
+    uint64_t                   mul;
+    bignum_mul_u64_status_t   *status_out;
+    bignum_mul_u64_done_fn     done_fn;
+    void                      *done_arg;
+    int                        detached;   // Без дескриптора: освобождает рабочий
+    bignum_mul_u64_status_t    status;
+    atomic_int                 done;
+    atomic_size_t              remaining;  // Невыполненные куски
+    size_t                     ntasks;
+    pool_task_t                tasks[];
+};
+
+// top и bottom — в разных строках: вор пишет top, владелец — bottom
+typedef struct {
+    _Alignas(POOL_CACHE_LINE) atomic_llong top;
+    _Alignas(POOL_CACHE_LINE) atomic_llong bottom;
+    _Atomic(pool_task_t *) ring[POOL_DEQUE_SIZE];
+} pool_deque_t;
+
+typedef struct {
+    pool_deque_t              deque;
+    struct bignum_mul_u64_pool *pool;
+    unsigned                  index;
+    uint64_t                  rng;        // Начало обхода жертв
+    pthread_t                 tid;
+} pool_worker_t;
+
+struct bignum_mul_u64_pool {
+    pthread_mutex_t        lock;
+    pthread_cond_t         work_cv;   // Новое задание или новые куски
+    pthread_cond_t         done_cv;   // Завершение любого задания
+    bignum_mul_u64_job_t  *head;      // Очередь отправки (FIFO)
+    bignum_mul_u64_job_t  *tail;
+    size_t                 pending;   // Отправленные и не завершенные задания
+    int                    shutdown;
+    atomic_ullong          epoch;     // Растет под lock при появлении работы
+    size_t                 chunk;     // Элементов в куске
+    unsigned               nworkers;  // Деков; не меняется после создания
+    unsigned               started;   // Созданных потоков
+    pool_worker_t         *workers;
+};
+
+static int deque_push(pool_deque_t *d, pool_task_t *task) {
+    long long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= POOL_DEQUE_SIZE) return 0;
+    atomic_store_explicit(&d->ring[b & (POOL_DEQUE_SIZE - 1)], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return 1;
+}
+
+static pool_task_t *deque_pop(pool_deque_t *d) {
+    long long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+    pool_task_t *task = atomic_load_explicit(&d->ring[b & (POOL_DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (t == b) {
+        // Последний элемент: спор с ворами через top
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static pool_task_t *deque_steal(pool_deque_t *d) {
+    long long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+    pool_task_t *task = atomic_load_explicit(&d->ring[t & (POOL_DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+/** Помечает задание выполненным; после этого рабочий его не трогает. */
+static void pool_complete(struct bignum_mul_u64_pool *pool, bignum_mul_u64_job_t *job) {
+    bignum_mul_u64_status_t status = BIGNUM_MUL_U64_SUCCESS;
+    for (size_t i = 0; i < job->ntasks && status == BIGNUM_MUL_U64_SUCCESS; ++i) {
+        status = job->tasks[i].status;
+    }
+    job->status = status;
+    if (job->done_fn != NULL) job->done_fn(job->done_arg, status);
+
+    int detached = job->detached;
+    if (detached) free(job);
+    pthread_mutex_lock(&pool->lock);
+    if (!detached) atomic_store_explicit(&job->done, 1, memory_order_release);
+    pool->pending--;
+    pthread_cond_broadcast(&pool->done_cv);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void pool_run(struct bignum_mul_u64_pool *pool, pool_task_t *task) {
+    bignum_mul_u64_job_t *job = task->job;
+    size_t lo = task->lo;
+    if (job->dst != NULL) {
+        task->carry = bignum_mul_u64_n(job->dst + lo, job->src + lo, task->hi - lo, job->mul);
+    } else {
+        task->status = bignum_mul_u64_batch(job->res + lo, job->a + lo, job->b + lo, task->hi - lo,
+                                            job->status_out != NULL ? job->status_out + lo : NULL);
+    }
+    if (atomic_fetch_sub_explicit(&job->remaining, 1, memory_order_acq_rel) == 1) {
+        pool_complete(pool, job);
+    }
+}
+
+/** Раскладывает куски задания в свой дек и будит воров. */
+static void pool_distribute(struct bignum_mul_u64_pool *pool, pool_worker_t *w, bignum_mul_u64_job_t *job) {
+    for (size_t i = job->ntasks; i-- > 1;) {
+        if (!deque_push(&w->deque, &job->tasks[i])) pool_run(pool, &job->tasks[i]);
+    }
+    if (job->ntasks > 1 && pool->nworkers > 1) {
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add_explicit(&pool->epoch, 1, memory_order_release);
+        pthread_cond_broadcast(&pool->work_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    // Первый кусок — сразу, пока воры просыпаются
+    pool_run(pool, &job->tasks[0]);
+}
+
+static pool_task_t *pool_steal(struct bignum_mul_u64_pool *pool, pool_worker_t *w) {
+    unsigned n = pool->nworkers;
+    w->rng ^= w->rng << 13;
+    w->rng ^= w->rng >> 7;
+    w->rng ^= w->rng << 17;
+    unsigned start = (unsigned)(w->rng % n);
+    for (unsigned k = 0; k < n; ++k) {
+        unsigned v = (start + k) % n;
+        if (v == w->index) continue;
+        pool_task_t *task = deque_steal(&pool->workers[v].deque);
+        if (task != NULL) return task;
+    }
+    return NULL;
+}
+
+static void *pool_worker(void *arg) {
+    pool_worker_t *w = arg;
+    struct bignum_mul_u64_pool *pool = w->pool;
+    for (;;) {
+        pool_task_t *task = deque_pop(&w->deque);
+        if (task != NULL) {
+            pool_run(pool, task);
+            continue;
+        }
+        unsigned long long epoch = atomic_load_explicit(&pool->epoch, memory_order_acquire);
+        task = pool_steal(pool, w);
+        if (task != NULL) {
+            pool_run(pool, task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        bignum_mul_u64_job_t *job = pool->head;
+        if (job != NULL) {
+            pool->head = job->next;
+            if (pool->head == NULL) pool->tail = NULL;
+            pthread_mutex_unlock(&pool->lock);
+            pool_distribute(pool, w, job);
+            continue;
+        }
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        if (atomic_load_explicit(&pool->epoch, memory_order_relaxed) == epoch) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+bignum_mul_u64_pool_t *bignum_mul_u64_pool_create(unsigned nthreads) {
+    if (nthreads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (unsigned)online : 1;
+    }
+    if (nthreads > POOL_MAX_THREADS) nthreads = POOL_MAX_THREADS;
+
+    bignum_mul_u64_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) return NULL;
+    pool->workers = aligned_alloc(POOL_CACHE_LINE, nthreads * sizeof(pool_worker_t));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+    atomic_init(&pool->epoch, 0);
+    pool->chunk = POOL_CHUNK_BYTES / (2 * sizeof(bignum_t));
+    if (pool->chunk == 0) pool->chunk = 1;
+
+    for (unsigned i = 0; i < nthreads; ++i) {
+        pool_worker_t *w = &pool->workers[i];
+        atomic_init(&w->deque.top, 0);
+        atomic_init(&w->deque.bottom, 0);
+        w->pool = pool;
+        w->index = i;
+        w->rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+    // Пул работает с теми потоками, которые удалось создать; деки
+    // несозданных остаются пустыми, и обход жертв их просто пропускает
+    pool->nworkers = nthreads;
+    for (unsigned i = 0; i < nthreads; ++i) {
+        if (pthread_create(&pool->workers[i].tid, NULL, pool_worker, &pool->workers[i]) != 0) break;
+        pool->started = i + 1;
+    }
+    if (pool->started == 0) {
+        pthread_cond_destroy(&pool->done_cv);
+        pthread_cond_destroy(&pool->work_cv);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void bignum_mul_u64_pool_destroy(bignum_mul_u64_pool_t *pool) {
+    if (pool == NULL) return;
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending != 0) pthread_cond_wait(&pool->done_cv, &pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+    for (unsigned i = 0; i < pool->started; ++i) pthread_join(pool->workers[i].tid, NULL);
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+/** Задание из ntasks кусков без операндов и без обратного вызова. */
+static bignum_mul_u64_job_t *pool_job_alloc(size_t ntasks) {
+    bignum_mul_u64_job_t *job = malloc(sizeof(*job) + ntasks * sizeof(pool_task_t));
+    if (job == NULL) return NULL;
+    job->next = NULL;
+    job->res = NULL;
+    job->a = NULL;
+    job->b = NULL;
+    job->dst = NULL;
+    job->src = NULL;
+    job->mul = 0;
+    job->status_out = NULL;
+    job->done_fn = NULL;
+    job->done_arg = NULL;
+    job->detached = 0;
+    job->status = BIGNUM_MUL_U64_SUCCESS;
+    atomic_init(&job->done, 0);
+    atomic_init(&job->remaining, ntasks);
+    job->ntasks = ntasks;
+    for (size_t i = 0; i < ntasks; ++i) {
+        job->tasks[i].job = job;
+        job->tasks[i].status = BIGNUM_MUL_U64_SUCCESS;
+        job->tasks[i].carry = 0;
+    }
+    return job;
+}
+
+/** Учитывает задание в pending и ставит в очередь отправки (пустое — завершает). */
+static void pool_enqueue(struct bignum_mul_u64_pool *pool, bignum_mul_u64_job_t *job) {
+    pthread_mutex_lock(&pool->lock);
+    pool->pending++;
+    pthread_mutex_unlock(&pool->lock);
+    if (job->ntasks == 0) {
+        // Пустое задание завершается в вызывающем потоке
+        pool_complete(pool, job);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->tail != NULL) {
+        pool->tail->next = job;
+    } else {
+        pool->head = job;
+    }
+    pool->tail = job;
+    atomic_fetch_add_explicit(&pool->epoch, 1, memory_order_release);
+    pthread_cond_signal(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/** Ждет, пока задание с дескриптором не будет отмечено выполненным. */
+static void pool_await(struct bignum_mul_u64_pool *pool, const bignum_mul_u64_job_t *job) {
+    if (atomic_load_explicit(&job->done, memory_order_acquire)) return;
+    pthread_mutex_lock(&pool->lock);
+    while (!atomic_load_explicit(&job->done, memory_order_acquire)) {
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_submit(bignum_mul_u64_pool_t *pool, bignum_t *res, const bignum_t *a,
+                                              const uint64_t *b, size_t n, bignum_mul_u64_status_t *status_out,
+                                              bignum_mul_u64_done_fn done_fn, void *done_arg,
+                                              bignum_mul_u64_job_t **job_out) {
+    if (job_out != NULL) *job_out = NULL;
+    if (pool == NULL || (n > 0 && (res == NULL || a == NULL || b == NULL))) {
+        return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    }
+    size_t ntasks = (n + pool->chunk - 1) / pool->chunk;
+    bignum_mul_u64_job_t *job = pool_job_alloc(ntasks);
+    if (job == NULL) return BIGNUM_MUL_U64_ERROR_NOMEM;
+    job->res = res;
+    job->a = a;
+    job->b = b;
+    job->status_out = status_out;
+    job->done_fn = done_fn;
+    job->done_arg = done_arg;
+    job->detached = job_out == NULL;
+    for (size_t i = 0; i < ntasks; ++i) {
+        job->tasks[i].lo = i * pool->chunk;
+        job->tasks[i].hi = i + 1 < ntasks ? (i + 1) * pool->chunk : n;
+    }
+    if (job_out != NULL) *job_out = job;
+    pool_enqueue(pool, job);
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+/**
+ * Граница куска t из ntasks: t * n / ntasks, округленная вниз до строки
+ * dst, чтобы соседние куски не писали в одну строку.
+ */
+static size_t pool_span_boundary(const uint64_t *dst, size_t n, size_t t, size_t ntasks) {
+    if (t == 0) return 0;
+    if (t == ntasks) return n;
+    size_t misalign = ((uintptr_t)dst / sizeof(uint64_t)) % POOL_LINE_WORDS;
+    size_t q = n / ntasks * t + n % ntasks * t / ntasks;
+    return (q + misalign) / POOL_LINE_WORDS * POOL_LINE_WORDS - misalign;
+}
+
+uint64_t bignum_mul_u64_n_parallel_pool(bignum_mul_u64_pool_t *pool, uint64_t *dst, const uint64_t *src,
+                                        size_t n, uint64_t b) {
+    size_t ntasks = pool != NULL ? pool->started : 0;
+    if (ntasks > n / POOL_SPAN_MIN_WORDS) ntasks = n / POOL_SPAN_MIN_WORDS;
+    bignum_mul_u64_job_t *job = ntasks > 1 ? pool_job_alloc(ntasks) : NULL;
+    if (job == NULL) return bignum_mul_u64_n(dst, src, n, b);
+    job->dst = dst;
+    job->src = src;
+    job->mul = b;
+    for (size_t t = 0; t < ntasks; ++t) {
+        job->tasks[t].lo = pool_span_boundary(dst, n, t, ntasks);
+        job->tasks[t].hi = pool_span_boundary(dst, n, t + 1, ntasks);
+    }
+    pool_enqueue(pool, job);
+    pool_await(pool, job);
+
+    // Коррекция, как в bignum_mul_u64_n_parallel: перенос куска t-1 — в
+    // начало куска t
+    uint64_t carry = job->tasks[0].carry;
+    for (size_t t = 1; t < ntasks; ++t) {
+        uint64_t *p = dst + job->tasks[t].lo;
+        size_t len = job->tasks[t].hi - job->tasks[t].lo;
+        for (size_t i = 0; carry != 0 && i < len; ++i) {
+            uint64_t s = p[i] + carry;
+            carry = s < carry;
+            p[i] = s;
+        }
+        carry += job->tasks[t].carry;
+    }
+    free(job);
+    return carry;
+}
+
+int bignum_mul_u64_poll(const bignum_mul_u64_job_t *job) {
+    if (job == NULL) return 1;
+    return atomic_load_explicit(&job->done, memory_order_acquire);
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_wait(bignum_mul_u64_pool_t *pool, bignum_mul_u64_job_t *job) {
+    if (pool == NULL || job == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    pool_await(pool, job);
+    bignum_mul_u64_status_t status = job->status;
+    free(job);
+    return status;
+}
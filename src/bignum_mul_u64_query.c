@@ -0,0 +1,74 @@
+/**
+ * @file    bignum_mul_u64_query.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Запросы о произведении без его вычисления: bignum_mul_u64_carry
+ *          и bignum_mul_u64_fits.
+ *
+ * @details
+ *   Слово переноса произведения на L значащих слов почти всегда
+ *   определяется старшим словом: перенос из младших слов в старшее меньше
+ *   b, поэтому если младшая половина a[L-1] * b плюс (b - 1) не
+ *   переполняется, перенос равен старшей половине этого произведения.
+ *   Только в оставшемся случае (вероятность порядка b / 2^64) проходится
+ *   вся цепочка. Для bignum_mul_u64_fits достаточно длин старшего слова и
+ *   множителя в битах (`lzcnt`), цепочка нужна лишь при сумме длин 65.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+
+__extension__ typedef unsigned __int128 query_u128_t;
+
+/**
+ * Значащая длина a: длина читается как в ядре (младшие 32 бита со знаком),
+ * старшие нулевые слова отбрасываются. 0 — a некорректно или равно нулю.
+ */
+static size_t query_significant_len(const bignum_t *a) {
+    int64_t len = (int32_t)(uint32_t)a->len;
+    if (len <= 0 || len > BIGNUM_CAPACITY) return 0;
+    while (len > 0 && a->words[len - 1] == 0) --len;
+    return (size_t)len;
+}
+
+/** Перенос из len > 0 слов w при умножении на b != 0. */
+static uint64_t query_carry(const uint64_t *w, size_t len, uint64_t b) {
+    query_u128_t top = (query_u128_t)w[len - 1] * b;
+    if ((uint64_t)top <= UINT64_MAX - (b - 1)) {
+        return (uint64_t)(top >> 64);
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < len; ++i) {
+        query_u128_t p = (query_u128_t)w[i] * b + carry;
+        carry = (uint64_t)(p >> 64);
+    }
+    return carry;
+}
+
+uint64_t bignum_mul_u64_carry(const bignum_t *a, uint64_t b) {
+    if (a == NULL || b == 0) return 0;
+    size_t len = query_significant_len(a);
+    if (len == 0) return 0;
+    return query_carry(a->words, len, b);
+}
+
+int bignum_mul_u64_fits(const bignum_t *a, uint64_t b) {
+    if (a == NULL) return 0;
+    int64_t raw = (int32_t)(uint32_t)a->len;
+    if (raw < 0 || raw > BIGNUM_CAPACITY) return 0;      // len == 0 — число 0, как в ядре
+
+    size_t len = query_significant_len(a);
+    if (len < BIGNUM_CAPACITY || b <= 1) return 1;
+
+    // top < 2^p, b < 2^q: при p + q <= 64 (top + 1) * b <= 2^64 и переноса
+    // нет; при p + q >= 66 уже top * b >= 2^64
+    uint64_t top = a->words[len - 1];
+    int bits = (64 - __builtin_clzll(top)) + (64 - __builtin_clzll(b));
+    if (bits <= 64) return 1;
+    if (bits >= 66) return 0;
+    return query_carry(a->words, len, b) == 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file    bignum_mul_u64_radix.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Разбор строки цифр в bignum_t: bignum_from_decimal и
+ *          bignum_from_radix.
+ *
+ * @details
+ *   По одной цифре разбор — это умножение всего числа на 10 и сложение на
+ *   каждую цифру. Здесь цифры берутся группами по k (k — наибольшее, при
+ *   котором radix^k помещается в слово: 19 для десятичных), группа
+ *   собирается в одно слово, и число обновляется одним проходом
+ *   res = res * radix^k + группа: группа входит как входной перенос цепочки
+ *   умножения, отдельного прохода сложения нет. Проходов в k раз меньше, и
+ *   каждый — обычный `mul` на слово.
+ *
+ *   Первая группа неполная (n mod k цифр), остальные — ровно по k, так что
+ *   множитель у всех проходов один и берется из таблицы radix_table.
+ *   В десятичной группе 16 цифр разбираются параллельно: на x86-64 через
+ *   SSE2 (вычитание '0', проверка диапазона одним `pmovmskb`, затем
+ *   `pmaddwd` складывает пары, четверки и восьмерки цифр), в остальных
+ *   случаях — по 8 цифр в слове (SWAR). Оставшиеся 3 цифры — по одной.
+ *
+ *   Число собирается во временном буфере и копируется в res только при
+ *   успехе. Ведущие нули не удлиняют число: пока значение 0, проход
+ *   умножения не выполняется.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+__extension__ typedef unsigned __int128 radix_u128_t;
+
+#define RADIX_DECIMAL_DIGITS  19
+
+/** Цифр в слове и radix^digits для оснований 2..36. */
+static const struct {
+    unsigned digits;
+    uint64_t base;
+} radix_table[37] = {
+    [2]  = {63, 0x8000000000000000ULL}, [3]  = {40, 0xa8b8b452291fe821ULL},
+    [4]  = {31, 0x4000000000000000ULL}, [5]  = {27, 0x6765c793fa10079dULL},
+    [6]  = {24, 0x41c21cb8e1000000ULL}, [7]  = {22, 0x3642798750226111ULL},
+    [8]  = {21, 0x8000000000000000ULL}, [9]  = {20, 0xa8b8b452291fe821ULL},
+    [10] = {19, 0x8ac7230489e80000ULL}, [11] = {18, 0x4d28cb56c33fa539ULL},
+    [12] = {17, 0x1eca170c00000000ULL}, [13] = {17, 0x780c7372621bd74dULL},
+    [14] = {16, 0x1e39a5057d810000ULL}, [15] = {16, 0x5b27ac993df97701ULL},
+    [16] = {15, 0x1000000000000000ULL}, [17] = {15, 0x27b95e997e21d9f1ULL},
+    [18] = {15, 0x5da0e1e53c5c8000ULL}, [19] = {15, 0xd2ae3299c1c4aedbULL},
+    [20] = {14, 0x16bcc41e90000000ULL}, [21] = {14, 0x2d04b7fdd9c0ef49ULL},
+    [22] = {14, 0x5658597bcaa24000ULL}, [23] = {14, 0xa0e2073737609371ULL},
+    [24] = {13, 0x0c29e98000000000ULL}, [25] = {13, 0x14adf4b7320334b9ULL},
+    [26] = {13, 0x226ed36478bfa000ULL}, [27] = {13, 0x383d9170b85ff80bULL},
+    [28] = {13, 0x5a3c23e39c000000ULL}, [29] = {13, 0x8e65137388122bcdULL},
+    [30] = {13, 0xdd41bb36d259e000ULL}, [31] = {12, 0x0aee5720ee830681ULL},
+    [32] = {12, 0x1000000000000000ULL}, [33] = {12, 0x172588ad4f5f0981ULL},
+    [34] = {12, 0x211e44f7d02c1000ULL}, [35] = {12, 0x2ee56725f06e5c71ULL},
+    [36] = {12, 0x41c21cb8e1000000ULL},
+};
+
+/** Значение цифры: '0'-'9', 'a'-'z' и 'A'-'Z'; 36 — не цифра. */
+static unsigned radix_digit(unsigned char c) {
+    if ((unsigned)(c - '0') < 10) return (unsigned)(c - '0');
+    c |= 0x20;
+    if ((unsigned)(c - 'a') < 26) return (unsigned)(c - 'a') + 10;
+    return 36;
+}
+
+/** Группа из count цифр основания radix по одной; 0 — недопустимая цифра. */
+static int radix_parse_scalar(const char *p, size_t count, unsigned radix, uint64_t *out) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned d = radix_digit((unsigned char)p[i]);
+        if (d >= radix) return 0;
+        v = v * radix + d;
+    }
+    *out = v;
+    return 1;
+}
+
+#if defined(__SSE2__)
+/** 16 десятичных цифр (первая — старшая); 0 — недопустимый символ. */
+static int radix_parse16(const char *p, uint64_t *out) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)(const void *)p), _mm_set1_epi8('0'));
+    // Цифра — байт 0..9 со знаком; остальные символы дают < 0 или > 9
+    __m128i bad = _mm_or_si128(_mm_cmplt_epi8(v, zero), _mm_cmpgt_epi8(v, _mm_set1_epi8(9)));
+    if (_mm_movemask_epi8(bad) != 0) return 0;
+
+    const __m128i m10 = _mm_setr_epi16(10, 1, 10, 1, 10, 1, 10, 1);
+    const __m128i m100 = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+    const __m128i m10000 = _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1);
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), m10);   // 4 пары цифр 0..7
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), m10);   // 4 пары цифр 8..15
+    __m128i q4 = _mm_madd_epi16(_mm_packs_epi32(lo, hi), m100);     // 4 четверки
+    __m128i q8 = _mm_madd_epi16(_mm_packs_epi32(q4, q4), m10000);   // 2 восьмерки
+    uint64_t high = (uint32_t)_mm_cvtsi128_si32(q8);
+    uint64_t low = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(q8, 4));
+    *out = high * 100000000u + low;
+    return 1;
+}
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/** 8 десятичных цифр в одном слове (SWAR); 0 — недопустимый символ. */
+static int radix_parse8(const char *p, uint64_t *out) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    // Все байты в '0'..'9': старшая тетрада 3 и у v, и у v + 6
+    if ((v & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+        ((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL) {
+        return 0;
+    }
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8);   // Пары цифр в четных байтах
+    v = ((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+         ((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    *out = (uint32_t)v;
+    return 1;
+}
+
+static int radix_parse16(const char *p, uint64_t *out) {
+    uint64_t high, low;
+    if (!radix_parse8(p, &high) || !radix_parse8(p + 8, &low)) return 0;
+    *out = high * 100000000u + low;
+    return 1;
+}
+#else
+static int radix_parse16(const char *p, uint64_t *out) {
+    return radix_parse_scalar(p, 16, 10, out);
+}
+#endif
+
+/** Полная десятичная группа из 19 цифр. */
+static int radix_parse19(const char *p, uint64_t *out) {
+    uint64_t high, low;
+    if (!radix_parse16(p, &high) || !radix_parse_scalar(p + 16, 3, 10, &low)) return 0;
+    *out = high * 1000 + low;
+    return 1;
+}
+
+/**
+ * w[0..*len) = w * base + chunk одним проходом; 0 — не помещается в
+ * BIGNUM_CAPACITY слов.
+ */
+static int radix_fold(uint64_t *w, size_t *len, uint64_t base, uint64_t chunk) {
+    size_t n = *len;
+    uint64_t carry = chunk;
+    for (size_t i = 0; i < n; ++i) {
+        radix_u128_t p = (radix_u128_t)w[i] * base + carry;
+        w[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    if (carry != 0) {
+        if (n == BIGNUM_CAPACITY) return 0;
+        w[n] = carry;
+        *len = n + 1;
+    }
+    return 1;
+}
+
+/** Общий разбор: группы по radix_table[radix].digits цифр. */
+static bignum_mul_u64_status_t radix_parse(bignum_t *res, const char *s, size_t n, unsigned radix) {
+    if (res == NULL || (s == NULL && n > 0)) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    if (radix < 2 || radix > 36 || n == 0) return BIGNUM_MUL_U64_ERROR_INVALID_DIGIT;
+
+    const size_t k = radix_table[radix].digits;
+    const uint64_t base = radix_table[radix].base;
+    uint64_t w[BIGNUM_CAPACITY];
+    size_t len = 0;
+    size_t head = n % k;
+    uint64_t chunk;
+
+    if (head != 0) {
+        if (!radix_parse_scalar(s, head, radix, &chunk)) return BIGNUM_MUL_U64_ERROR_INVALID_DIGIT;
+        if (chunk != 0) w[len++] = chunk;
+    }
+    for (size_t pos = head; pos < n; pos += k) {
+        int ok = radix == 10 ? radix_parse19(s + pos, &chunk) : radix_parse_scalar(s + pos, k, radix, &chunk);
+        if (!ok) return BIGNUM_MUL_U64_ERROR_INVALID_DIGIT;
+        if (len == 0) {
+            // Пока значение 0, произведение не нужно
+            if (chunk != 0) w[len++] = chunk;
+        } else if (!radix_fold(w, &len, base, chunk)) {
+            return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        }
+    }
+
+    if (len == 0) {
+        res->words[0] = 0;
+        res->len = 1;
+    } else {
+        memcpy(res->words, w, len * sizeof(uint64_t));
+        res->len = len;
+    }
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+bignum_mul_u64_status_t bignum_from_decimal(bignum_t *res, const char *s, size_t n) {
+    return radix_parse(res, s, n, 10);
+}
+
+bignum_mul_u64_status_t bignum_from_radix(bignum_t *res, const char *s, size_t n, unsigned radix) {
+    return radix_parse(res, s, n, radix);
+}
@@ -0,0 +1,236 @@
+/**
+ * @file    bignum_mul_u64_soa.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Пакет bignum в раскладке "структура массивов" (bignum_batch_t).
+ *
+ * @details
+ *   В массиве bignum_t слово k соседних чисел отстоит на sizeof(bignum_t)
+ *   байт, поэтому обработка "столбцом" (одно слово многих чисел) не
+ *   попадает ни в векторные регистры, ни в шаблоны аппаратной предвыборки.
+ *   В bignum_batch_t слово k всех чисел лежит подряд в одном слое
+ *   `words[k * stride ...]`, каждый слой выровнен на 64 байта.
+ *
+ *   Инвариант: слова числа i выше len[i] нулевые, а слои с номером
+ *   >= rows нулевые у всех чисел. Ядро умножения опирается на него:
+ *   проходит слои 0..rows-1 для всех чисел (нулевые слова числа дают 0
+ *   и выносят его перенос в слой len[i]), так что длины по числам не
+ *   нужно маскировать. Числа идут группами по четыре: переносы группы
+ *   остаются в регистрах, а четыре цепочки `mul` не зависят друг от
+ *   друга, в отличие от одной цепочки в ядре bignum_mul_u64.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Длина результата сокращается до значащей.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdlib.h>
+#include <string.h>
+
+__extension__ typedef unsigned __int128 soa_u128_t;
+
+#define SOA_ALIGN  64
+#define SOA_LANES  (SOA_ALIGN / sizeof(uint64_t))
+
+// Числа, которые ядро умножения ведет одновременно
+#define SOA_GROUP  4
+
+// Дистанция программной предвыборки по слою, в словах (две строки кэша)
+#define SOA_PREFETCH  16
+
+bignum_mul_u64_status_t bignum_batch_init(bignum_batch_t *batch, size_t count) {
+    if (batch == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    memset(batch, 0, sizeof(*batch));
+    if (count == 0) return BIGNUM_MUL_U64_SUCCESS;
+
+    // Шаг, кратный 4 КиБ, дает совпадение младших битов адресов соседних
+    // слоев (4K aliasing) и одинаковые наборы кэша: добавляется строка
+    size_t stride = (count + SOA_LANES - 1) / SOA_LANES * SOA_LANES;
+    if (stride * sizeof(uint64_t) % 4096 == 0) stride += SOA_LANES;
+    size_t words_size = stride * BIGNUM_CAPACITY * sizeof(uint64_t);
+    size_t len_size = (count * sizeof(size_t) + SOA_ALIGN - 1) / SOA_ALIGN * SOA_ALIGN;
+    uint64_t *words = aligned_alloc(SOA_ALIGN, words_size);
+    size_t *len = aligned_alloc(SOA_ALIGN, len_size);
+    if (words == NULL || len == NULL) {
+        free(words);
+        free(len);
+        return BIGNUM_MUL_U64_ERROR_NOMEM;
+    }
+    memset(words, 0, words_size);
+    memset(len, 0, len_size);
+
+    batch->words = words;
+    batch->len = len;
+    batch->count = count;
+    batch->stride = stride;
+    batch->rows = 0;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+void bignum_batch_free(bignum_batch_t *batch) {
+    if (batch == NULL) return;
+    free(batch->words);
+    free(batch->len);
+    memset(batch, 0, sizeof(*batch));
+}
+
+/** Обнуляет слои [from, to) для всех чисел пакета. */
+static void soa_zero_rows(bignum_batch_t *batch, size_t from, size_t to) {
+    if (from < to) {
+        memset(batch->words + from * batch->stride, 0, (to - from) * batch->stride * sizeof(uint64_t));
+    }
+}
+
+bignum_mul_u64_status_t bignum_batch_pack(bignum_batch_t *batch, const bignum_t *src, size_t n) {
+    if (batch == NULL || (src == NULL && n > 0)) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    if (n > batch->count) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+
+    // Длина читается как в ядре: младшие 32 бита со знаком
+    size_t rows = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int64_t len = (int32_t)(uint32_t)src[i].len;
+        if (len < 0 || len > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        if ((size_t)len > rows) rows = (size_t)len;
+    }
+
+    size_t stride = batch->stride;
+    soa_zero_rows(batch, 0, batch->rows > rows ? batch->rows : rows);
+    for (size_t i = 0; i < n; ++i) {
+        size_t len = (size_t)(int32_t)(uint32_t)src[i].len;
+        for (size_t k = 0; k < len; ++k) {
+            batch->words[k * stride + i] = src[i].words[k];
+        }
+        batch->len[i] = len;
+    }
+    for (size_t i = n; i < batch->count; ++i) {
+        batch->len[i] = 0;
+    }
+    batch->rows = rows;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+bignum_mul_u64_status_t bignum_batch_unpack(const bignum_batch_t *batch, bignum_t *dst, size_t n) {
+    if (batch == NULL || (dst == NULL && n > 0)) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    if (n > batch->count) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+
+    size_t stride = batch->stride;
+    for (size_t i = 0; i < n; ++i) {
+        size_t len = batch->len[i];
+        for (size_t k = 0; k < len; ++k) {
+            dst[i].words[k] = batch->words[k * stride + i];
+        }
+        dst[i].len = len;
+    }
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+/**
+ * Умножает SOA_GROUP соседних чисел: слои 0..rows-1 и слой переноса rows
+ * (если rows < BIGNUM_CAPACITY). Итоговые переносы — в carry_out.
+ */
+static void soa_mul_group(uint64_t *dst, const uint64_t *src, size_t stride, size_t rows,
+                          const uint64_t *b, uint64_t *carry_out) {
+    uint64_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+    uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    for (size_t k = 0; k < rows; ++k) {
+        const uint64_t *s = src + k * stride;
+        uint64_t *d = dst + k * stride;
+        // Слои отстоят больше чем на страницу, аппаратная предвыборка их не видит
+        __builtin_prefetch(s + SOA_PREFETCH);
+        __builtin_prefetch(d + SOA_PREFETCH, 1);
+        soa_u128_t p0 = (soa_u128_t)s[0] * b0;
+        soa_u128_t p1 = (soa_u128_t)s[1] * b1;
+        soa_u128_t p2 = (soa_u128_t)s[2] * b2;
+        soa_u128_t p3 = (soa_u128_t)s[3] * b3;
+        // Сложение переноса в 64-битных словах: с `p += c` на __int128
+        // компилятор выгружает половины произведений в стек
+        uint64_t l0 = (uint64_t)p0 + c0, l1 = (uint64_t)p1 + c1;
+        uint64_t l2 = (uint64_t)p2 + c2, l3 = (uint64_t)p3 + c3;
+        c0 = (uint64_t)(p0 >> 64) + (l0 < c0);
+        c1 = (uint64_t)(p1 >> 64) + (l1 < c1);
+        c2 = (uint64_t)(p2 >> 64) + (l2 < c2);
+        c3 = (uint64_t)(p3 >> 64) + (l3 < c3);
+        d[0] = l0; d[1] = l1; d[2] = l2; d[3] = l3;
+    }
+    if (rows < BIGNUM_CAPACITY) {
+        uint64_t *d = dst + rows * stride;
+        d[0] = c0; d[1] = c1; d[2] = c2; d[3] = c3;
+    }
+    carry_out[0] = c0; carry_out[1] = c1; carry_out[2] = c2; carry_out[3] = c3;
+}
+
+/** Выставляет длину и статус числа i после прохода по слоям. */
+static void soa_finish_lane(bignum_batch_t *res, const bignum_batch_t *a, const uint64_t *b, size_t i,
+                            size_t rows, uint64_t carry, bignum_mul_u64_status_t *status_out,
+                            bignum_mul_u64_status_t *first) {
+    bignum_mul_u64_status_t st = BIGNUM_MUL_U64_SUCCESS;
+    size_t len = a->len[i];
+    if (len == 0 || b[i] == 0) {
+        len = 1;                                          // 0 с len = 1, слова уже нулевые
+    } else {
+        if (len < rows) {
+            len += res->words[len * res->stride + i] != 0;    // перенос ушел в слой len
+        } else if (carry != 0) {
+            if (len >= BIGNUM_CAPACITY) {
+                st = BIGNUM_MUL_U64_ERROR_OVERFLOW;           // остаются младшие CAP слов, len = CAP
+            } else {
+                ++len;
+            }
+        }
+        // Старшие нулевые слова a дают нули: длина точная, как в ядре
+        while (st == BIGNUM_MUL_U64_SUCCESS && len > 1 && res->words[(len - 1) * res->stride + i] == 0) --len;
+    }
+    res->len[i] = len;
+    if (status_out) status_out[i] = st;
+    if (st != BIGNUM_MUL_U64_SUCCESS && *first == BIGNUM_MUL_U64_SUCCESS) *first = st;
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_batch_soa(bignum_batch_t *res, const bignum_batch_t *a,
+                                                 const uint64_t *b, bignum_mul_u64_status_t *status_out) {
+    if (res == NULL || a == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    if (res->count != a->count) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    size_t count = a->count;
+    if (count == 0) return BIGNUM_MUL_U64_SUCCESS;
+    if (b == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+
+    // Пакет, нарушающий инвариант (например, после ручной правки len), не обрабатывается
+    size_t rows = a->rows;
+    if (rows > BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    for (size_t i = 0; i < count; ++i) {
+        if (a->len[i] > rows) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    }
+
+    // Слой rows получает перенос, если есть куда
+    size_t out_rows = rows < BIGNUM_CAPACITY ? rows + 1 : BIGNUM_CAPACITY;
+    size_t stride = a->stride;
+    bignum_mul_u64_status_t first = BIGNUM_MUL_U64_SUCCESS;
+
+    // Четыре независимые цепочки переноса идут вниз по слоям в регистрах;
+    // соседние числа делят строку кэша каждого слоя
+    size_t i = 0;
+    for (; i + SOA_GROUP <= count; i += SOA_GROUP) {
+        uint64_t carry[SOA_GROUP];
+        soa_mul_group(res->words + i, a->words + i, stride, rows, b + i, carry);
+        for (size_t j = 0; j < SOA_GROUP; ++j) {
+            soa_finish_lane(res, a, b, i + j, rows, carry[j], status_out, &first);
+        }
+    }
+    for (; i < count; ++i) {
+        uint64_t carry = 0;
+        for (size_t k = 0; k < rows; ++k) {
+            soa_u128_t p = (soa_u128_t)a->words[k * stride + i] * b[i] + carry;
+            res->words[k * stride + i] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        if (rows < BIGNUM_CAPACITY) res->words[rows * stride + i] = carry;
+        soa_finish_lane(res, a, b, i, rows, carry, status_out, &first);
+    }
+
+    // Старые слои res выше результата обнуляются, чтобы сохранить инвариант
+    soa_zero_rows(res, out_rows, res->rows);
+    res->rows = out_rows;
+    return first;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file    bignum_mul_u64_stats.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Счетчики вызовов bignum_mul_u64 (сборка CONFIG=stats).
+ *
+ * @details
+ *   Чтобы решить, какие быстрые пути нужны на реальной нагрузке, сборка со
+ *   счетчиками (BIGNUM_MUL_U64_STATS в C, `-D STATS` у ассемблера) считает
+ *   длины `a`, классы множителя, умножение на месте и возвраты ошибок.
+ *   Публичная bignum_mul_u64 в такой сборке — переход в
+ *   bignum_mul_u64_stats_call, которая обновляет счетчики и вызывает
+ *   диспетчер ядер (он экспортирован как bignum_mul_u64_dispatch). В
+ *   остальных сборках bignum_mul_u64 — сам диспетчер, и от этого файла
+ *   остается только bignum_mul_u64_stats_snapshot, возвращающая
+ *   BIGNUM_MUL_U64_ERROR_DOMAIN.
+ *
+ *   Блок счетчиков у каждого потока свой (указатель в `_Thread_local`),
+ *   регистрируется при первом вызове под мьютексом и при завершении потока
+ *   складывается в общий итог (деструктор ключа pthread). Счетчик
+ *   увеличивается раздельными relaxed-загрузкой и записью: в блок пишет
+ *   только его поток, поэтому RMW с `lock` не нужен, а снимок из другого
+ *   потока читает слова без гонки по стандарту C11.
+ *
+ *   Раскладка блока совпадает с bignum_mul_u64_stats_t (все поля — слова),
+ *   так что снимок складывает блоки пословно.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bignum_mul_u64.h"
+#include <string.h>
+
+#ifdef BIGNUM_MUL_U64_STATS
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STATS_WORDS          (sizeof(bignum_mul_u64_stats_t) / sizeof(uint64_t))
+#define STATS_INDEX(field)   (offsetof(bignum_mul_u64_stats_t, field) / sizeof(uint64_t))
+
+typedef struct stats_block {
+    struct stats_block     *next;
+    struct stats_block    **pprev;
+    atomic_uint_least64_t   c[STATS_WORDS];
+} stats_block_t;
+
+/** Диспетчер ядер из bignum_mul_u64.asm (в этой сборке — не bignum_mul_u64). */
+bignum_mul_u64_status_t bignum_mul_u64_dispatch(bignum_t *res, const bignum_t *a, uint64_t b);
+bignum_mul_u64_status_t bignum_mul_u64_stats_call(bignum_t *res, const bignum_t *a, uint64_t b);
+
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stats_key;
+static stats_block_t *stats_live;              // Блоки живых потоков, под stats_lock
+static uint64_t stats_retired[STATS_WORDS];    // Итог завершившихся потоков, под stats_lock
+static uint64_t stats_threads;                 // Под stats_lock
+// Потоки, которым не хватило памяти на блок: общий, обновления могут теряться
+static stats_block_t stats_shared;
+static _Thread_local stats_block_t *stats_self;
+
+static inline void stats_bump(stats_block_t *s, size_t i) {
+    uint64_t v = atomic_load_explicit(&s->c[i], memory_order_relaxed);
+    atomic_store_explicit(&s->c[i], v + 1, memory_order_relaxed);
+}
+
+static void stats_add(uint64_t *sum, stats_block_t *s) {
+    for (size_t i = 0; i < STATS_WORDS; ++i) sum[i] += atomic_load_explicit(&s->c[i], memory_order_relaxed);
+}
+
+/** Деструктор ключа: счетчики завершившегося потока — в общий итог. */
+static void stats_retire(void *p) {
+    stats_block_t *s = p;
+    pthread_mutex_lock(&stats_lock);
+    stats_add(stats_retired, s);
+    *s->pprev = s->next;
+    if (s->next != NULL) s->next->pprev = s->pprev;
+    pthread_mutex_unlock(&stats_lock);
+    stats_self = NULL;   // Вызов из более позднего деструктора заведет новый блок
+    free(s);
+}
+
+static void stats_dump(void);
+
+static void stats_init(void) {
+    pthread_key_create(&stats_key, stats_retire);
+    atexit(stats_dump);
+}
+
+/** Первый вызов в потоке: блок счетчиков и его регистрация. */
+static stats_block_t *stats_register(void) {
+    pthread_once(&stats_once, stats_init);
+    stats_block_t *s = malloc(sizeof(*s));
+    if (s == NULL) {
+        stats_self = &stats_shared;
+        return stats_self;
+    }
+    for (size_t i = 0; i < STATS_WORDS; ++i) atomic_init(&s->c[i], 0);
+
+    pthread_mutex_lock(&stats_lock);
+    s->next = stats_live;
+    s->pprev = &stats_live;
+    if (stats_live != NULL) stats_live->pprev = &s->next;
+    stats_live = s;
+    ++stats_threads;
+    pthread_mutex_unlock(&stats_lock);
+
+    pthread_setspecific(stats_key, s);
+    stats_self = s;
+    return s;
+}
+
+static size_t stats_class(uint64_t b) {
+    if (b == 0) return BIGNUM_MUL_U64_STATS_B_ZERO;
+    if (b == 1) return BIGNUM_MUL_U64_STATS_B_ONE;
+    if ((b & (b - 1)) == 0) return BIGNUM_MUL_U64_STATS_B_POW2;
+    if (b >> 32 == 0) return BIGNUM_MUL_U64_STATS_B_SMALL;
+    return BIGNUM_MUL_U64_STATS_B_FULL;
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_stats_call(bignum_t *res, const bignum_t *a, uint64_t b) {
+    stats_block_t *s = stats_self;
+    if (s == NULL) s = stats_register();
+    stats_bump(s, STATS_INDEX(calls));
+    if (res != NULL && a != NULL) {
+        // До вызова: при res == a ядро перепишет длину
+        int64_t len = (int32_t)(uint32_t)a->len;
+        if (len < 0 || len > BIGNUM_CAPACITY) {
+            stats_bump(s, STATS_INDEX(len_invalid));
+        } else {
+            stats_bump(s, STATS_INDEX(len) + (size_t)len);
+        }
+        stats_bump(s, STATS_INDEX(multiplier) + stats_class(b));
+        if (res == a) stats_bump(s, STATS_INDEX(aliased));
+    }
+
+    bignum_mul_u64_status_t st = bignum_mul_u64_dispatch(res, a, b);
+    if (st == BIGNUM_MUL_U64_ERROR_NULL_ARG) {
+        stats_bump(s, STATS_INDEX(null_arg));
+    } else if (st == BIGNUM_MUL_U64_ERROR_OVERFLOW) {
+        stats_bump(s, STATS_INDEX(overflow));
+    }
+    return st;
+}
+
+bignum_mul_u64_status_t bignum_mul_u64_stats_snapshot(bignum_mul_u64_stats_t *out) {
+    if (out == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    uint64_t sum[STATS_WORDS];
+    pthread_mutex_lock(&stats_lock);
+    memcpy(sum, stats_retired, sizeof(sum));
+    for (stats_block_t *s = stats_live; s != NULL; s = s->next) stats_add(sum, s);
+    stats_add(sum, &stats_shared);
+    sum[STATS_INDEX(threads)] = stats_threads;
+    pthread_mutex_unlock(&stats_lock);
+    memcpy(out, sum, sizeof(*out));
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+static double stats_percent(uint64_t part, uint64_t total) {
+    return total == 0 ? 0.0 : 100.0 * (double)part / (double)total;
+}
+
+/** Обработчик atexit: итог в файл из BIGNUM_MUL_U64_STATS (дописывается) или в stderr. */
+static void stats_dump(void) {
+    static const char *const class_names[BIGNUM_MUL_U64_STATS_B_CLASSES] = {
+        "0", "1", "2^k", "< 2^32", "full",
+    };
+    bignum_mul_u64_stats_t st;
+    bignum_mul_u64_stats_snapshot(&st);
+
+    const char *path = getenv("BIGNUM_MUL_U64_STATS");
+    FILE *f = path != NULL && path[0] != '\0' ? fopen(path, "a") : NULL;
+    FILE *out = f != NULL ? f : stderr;
+
+    fprintf(out, "bignum_mul_u64 stats: %" PRIu64 " calls from %" PRIu64 " threads\n", st.calls, st.threads);
+    fprintf(out, "  a->len:\n");
+    for (size_t i = 0; i <= BIGNUM_CAPACITY; ++i) {
+        if (st.len[i] == 0) continue;
+        fprintf(out, "    %6zu %14" PRIu64 " %6.2f%%\n", i, st.len[i], stats_percent(st.len[i], st.calls));
+    }
+    if (st.len_invalid != 0) {
+        fprintf(out, "    %6s %14" PRIu64 " %6.2f%%\n", "bad", st.len_invalid, stats_percent(st.len_invalid, st.calls));
+    }
+    fprintf(out, "  b:\n");
+    for (size_t i = 0; i < BIGNUM_MUL_U64_STATS_B_CLASSES; ++i) {
+        fprintf(out, "    %6s %14" PRIu64 " %6.2f%%\n", class_names[i], st.multiplier[i],
+                stats_percent(st.multiplier[i], st.calls));
+    }
+    fprintf(out, "  res == a %12" PRIu64 " %6.2f%%\n", st.aliased, stats_percent(st.aliased, st.calls));
+    fprintf(out, "  null_arg %12" PRIu64 " %6.2f%%\n", st.null_arg, stats_percent(st.null_arg, st.calls));
+    fprintf(out, "  overflow %12" PRIu64 " %6.2f%%\n", st.overflow, stats_percent(st.overflow, st.calls));
+    if (f != NULL) fclose(f);
+}
+
+#else
+
+bignum_mul_u64_status_t bignum_mul_u64_stats_snapshot(bignum_mul_u64_stats_t *out) {
+    if (out == NULL) return BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    memset(out, 0, sizeof(*out));
+    return BIGNUM_MUL_U64_ERROR_DOMAIN;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file    test_bignum_mul_u64_arena.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты пула bignum_pool_t.
+ *
+ * @details
+ *   Выравнивание и шаг слотов с BIGNUM_POOL_PADDED и без, обнуление
+ *   выданного слота, повторная выдача освобожденных, рост на новые блоки
+ *   без пересечения слотов, умножение и копирование между слотами и особые
+ *   аргументы.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+#define SLOTS 50
+
+/**
+ * @brief Тест 1: Выравнивание, шаг, обнуление и рост по блокам.
+ */
+static void test_layout(unsigned flags, size_t count) {
+    printf("Running test: test_layout (flags %u, count %zu)\n", flags, count);
+    bignum_pool_t pool;
+    assert(bignum_pool_init(&pool, count, flags) == BIGNUM_MUL_U64_SUCCESS);
+    assert(pool.stride % (flags & BIGNUM_POOL_PADDED ? 128 : 64) == 0);
+    assert(pool.stride >= sizeof(bignum_t) && pool.stride - sizeof(bignum_t) < (flags & BIGNUM_POOL_PADDED ? 128 : 64));
+
+    bignum_t *x[SLOTS];
+    for (size_t i = 0; i < SLOTS; ++i) {
+        x[i] = bignum_pool_alloc(&pool);
+        assert(x[i] != NULL);
+        assert((uintptr_t)x[i] % (flags & BIGNUM_POOL_PADDED ? 128 : 64) == 0);
+        assert(x[i]->len == 0);
+        for (size_t k = 0; k < BIGNUM_CAPACITY; ++k) assert(x[i]->words[k] == 0);
+        memset(x[i], 0xA5, sizeof(bignum_t));   // Запись на весь слот не задевает соседей
+    }
+    // Слоты не пересекаются (в том числе из разных блоков)
+    for (size_t i = 0; i < SLOTS; ++i) {
+        for (size_t j = i + 1; j < SLOTS; ++j) {
+            uintptr_t p = (uintptr_t)x[i], q = (uintptr_t)x[j];
+            assert(p + pool.stride <= q || q + pool.stride <= p);
+        }
+    }
+
+    // Освобожденные слоты выдаются снова и снова обнулены
+    bignum_pool_free(&pool, x[3]);
+    bignum_pool_free(&pool, x[7]);
+    bignum_t *y = bignum_pool_alloc(&pool), *z = bignum_pool_alloc(&pool);
+    assert((y == x[7] && z == x[3]) || (y == x[3] && z == x[7]));
+    assert(y->len == 0 && y->words[0] == 0 && z->len == 0 && z->words[0] == 0);
+    bignum_pool_destroy(&pool);
+    assert(pool.chunks == NULL && pool.stride == 0);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Умножение и копирование (b == 1) между выровненными слотами.
+ */
+static void test_kernel(void) {
+    printf("Running test: test_kernel\n");
+    bignum_pool_t pool;
+    assert(bignum_pool_init(&pool, 4, 0) == BIGNUM_MUL_U64_SUCCESS);
+    bignum_t *a = bignum_pool_alloc(&pool), *res = bignum_pool_alloc(&pool);
+    bignum_t ref;
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t i = 0; i < len; ++i) a->words[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+        a->len = len;
+        uint64_t bs[3] = {1, 3, UINT64_MAX >> 1};
+        for (size_t j = 0; j < 3; ++j) {
+            bignum_t src = *a;
+            bignum_mul_u64_status_t st_ref = bignum_mul_u64(&ref, &src, bs[j]);
+            assert(bignum_mul_u64(res, a, bs[j]) == st_ref);
+            if (st_ref == BIGNUM_MUL_U64_SUCCESS) {
+                assert(res->len == ref.len);
+                assert(memcmp(res->words, ref.words, ref.len * sizeof(uint64_t)) == 0);
+            }
+        }
+    }
+    bignum_pool_destroy(&pool);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: NULL и повторное разрушение.
+ */
+static void test_special(void) {
+    printf("Running test: test_special\n");
+    bignum_pool_t pool;
+    assert(bignum_pool_init(NULL, 4, 0) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_pool_alloc(NULL) == NULL);
+    bignum_pool_free(NULL, NULL);
+    bignum_pool_destroy(NULL);
+
+    assert(bignum_pool_init(&pool, 1, 0) == BIGNUM_MUL_U64_SUCCESS);
+    bignum_pool_free(&pool, NULL);
+    assert(bignum_pool_alloc(&pool) != NULL);
+    bignum_pool_destroy(&pool);
+    bignum_pool_destroy(&pool);
+    assert(bignum_pool_alloc(&pool) == NULL);   // После разрушения
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting tests for bignum_pool_t ---\n");
+    test_layout(0, 0);
+    test_layout(0, 7);
+    test_layout(BIGNUM_POOL_PADDED, 1);
+    test_layout(BIGNUM_POOL_PADDED, SLOTS);
+    test_kernel();
+    test_special();
+    printf("\n--- All tests for bignum_pool_t passed ---\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file    test_bignum_mul_u64_batch.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты пакетных функций bignum_mul_u64_batch и bignum_mul_u64_batch_scalar.
+ *
+ * @details
+ *   Проверяет совпадение пакетного результата с поэлементными вызовами
+ *   `bignum_mul_u64`, поэлементные статусы и возврат первой ошибки,
+ *   пустой пакет, NULL-аргументы и умножение "на месте".
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+#define BATCH_N 37
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static int bignum_are_equal(const bignum_t* x, const bignum_t* y) {
+    if (x->len != y->len) return 0;
+    return memcmp(x->words, y->words, x->len * sizeof(uint64_t)) == 0;
+}
+
+static bignum_t a[BATCH_N], res[BATCH_N], expected[BATCH_N];
+static uint64_t b[BATCH_N];
+
+static void fill_inputs(void) {
+    memset(a, 0, sizeof(a));
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        size_t len = 1 + (size_t)(next_rand() % BIGNUM_CAPACITY);
+        for (size_t j = 0; j < len; ++j) a[i].words[j] = next_rand();
+        a[i].len = len;
+        b[i] = next_rand();
+    }
+    /* Элементы с гарантированным переполнением */
+    memset(&a[5], 0, sizeof(a[5]));
+    a[5].len = BIGNUM_CAPACITY;
+    a[5].words[BIGNUM_CAPACITY - 1] = UINT64_MAX;
+    b[5] = 2;
+    a[20] = a[5];
+    b[20] = 3;
+}
+
+/**
+ * @brief Тест 1: Пакет с массивом множителей и поэлементными статусами.
+ */
+static void test_batch_matches_single_calls(void) {
+    printf("Running test: test_batch_matches_single_calls\n");
+    fill_inputs();
+    bignum_mul_u64_status_t st[BATCH_N], st_expected[BATCH_N];
+    memset(res, 0, sizeof(res));
+    memset(expected, 0, sizeof(expected));
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        st_expected[i] = bignum_mul_u64(&expected[i], &a[i], b[i]);
+    }
+    bignum_mul_u64_status_t ret = bignum_mul_u64_batch(res, a, b, BATCH_N, st);
+    assert(ret == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        assert(st[i] == st_expected[i]);
+        if (st[i] == BIGNUM_MUL_U64_SUCCESS) {
+            assert(bignum_are_equal(&res[i], &expected[i]));
+        }
+    }
+    assert(st[5] == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(st[20] == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+
+    /* Без status_out возвращается только первая ошибка */
+    memset(res, 0, sizeof(res));
+    ret = bignum_mul_u64_batch(res, a, b, BATCH_N, NULL);
+    assert(ret == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(bignum_are_equal(&res[BATCH_N - 1], &expected[BATCH_N - 1]));
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Пакет с общим множителем, "на месте".
+ */
+static void test_batch_scalar_in_place(void) {
+    printf("Running test: test_batch_scalar_in_place\n");
+    fill_inputs();
+    a[5].len = 1;
+    a[20].len = 1;
+    const uint64_t m = 0xFEDCBA9876543211ULL;
+    memset(expected, 0, sizeof(expected));
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        assert(bignum_mul_u64(&expected[i], &a[i], m) == BIGNUM_MUL_U64_SUCCESS
+               || a[i].len == BIGNUM_CAPACITY);
+    }
+    bignum_mul_u64_status_t st[BATCH_N];
+    bignum_mul_u64_status_t ret = bignum_mul_u64_batch_scalar(a, a, m, BATCH_N, st);
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        if (st[i] == BIGNUM_MUL_U64_SUCCESS) {
+            assert(bignum_are_equal(&a[i], &expected[i]));
+        } else {
+            assert(ret != BIGNUM_MUL_U64_SUCCESS);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Пустой пакет и NULL-аргументы.
+ */
+static void test_batch_edge_cases(void) {
+    printf("Running test: test_batch_edge_cases\n");
+    fill_inputs();
+    assert(bignum_mul_u64_batch(NULL, NULL, NULL, 0, NULL) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64_batch_scalar(NULL, NULL, 7, 0, NULL) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64_batch(NULL, a, b, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch(res, NULL, b, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch(res, a, NULL, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch_scalar(NULL, a, 7, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch_scalar(res, NULL, 7, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+
+    /* Некорректная длина элемента не мешает остальным */
+    bignum_mul_u64_status_t st[3];
+    a[0].len = 1;
+    a[1].len = BIGNUM_CAPACITY + 5;
+    a[2].len = 1;
+    memset(res, 0, sizeof(res));
+    bignum_mul_u64_status_t ret = bignum_mul_u64_batch(res, a, b, 3, st);
+    assert(ret == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(st[0] == BIGNUM_MUL_U64_SUCCESS);
+    assert(st[1] == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(st[2] == BIGNUM_MUL_U64_SUCCESS);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting batch tests for bignum_mul_u64 ---\n");
+    test_batch_edge_cases();
+    test_batch_matches_single_calls();
+    test_batch_scalar_in_place();
+    printf("\n--- All batch tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
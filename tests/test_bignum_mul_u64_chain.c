@@ -0,0 +1,251 @@
+/**
+ * @file    test_bignum_mul_u64_chain.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_u64_chain.
+ *
+ * @details
+ *   Эталон — произведение в широком массиве (емкость плюс слово на
+ *   множитель), так что переполнение эталона невозможно и видна точная
+ *   граница. Проверяются цепочки малых множителей (факториал), случайные
+ *   смеси малых, больших, единичных и нулевых множителей, совпадение
+ *   `res` и `a`, произведения у самой границы емкости (по обе стороны
+ *   промежутка оценки), неизменность `res` при ошибке и особые аргументы.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+#define MAX_FACTORS 64
+#define WIDE (BIGNUM_CAPACITY + MAX_FACTORS)
+
+static uint64_t rng_state = 0x3243F6A8885A308DULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/** Эталон: w[0..WIDE) = a * b[0] * ... * b[k-1]; возвращает значащую длину. */
+static size_t reference(const bignum_t *a, const uint64_t *b, size_t k, uint64_t *w) {
+    memset(w, 0, WIDE * sizeof(uint64_t));
+    memcpy(w, a->words, a->len * sizeof(uint64_t));
+    for (size_t j = 0; j < k; ++j) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < WIDE; ++i) {
+            u128_t p = (u128_t)w[i] * b[j] + carry;
+            w[i] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        assert(carry == 0);
+    }
+    size_t len = WIDE;
+    while (len > 0 && w[len - 1] == 0) --len;
+    return len;
+}
+
+/** Заполняет слова res мусором; ядро пишет только младшие 32 бита длины. */
+static void poison(bignum_t *res) {
+    memset(res, 0, sizeof(*res));
+    memset(res->words, 0x5A, sizeof(res->words));
+}
+
+/** Проверяет bignum_mul_u64_chain против эталона, в том числе на месте. */
+static void check_chain(const bignum_t *a, const uint64_t *b, size_t k) {
+    uint64_t w[WIDE];
+    size_t len = reference(a, b, k, w);
+
+    bignum_t res, saved;
+    poison(&res);
+    saved = res;
+    bignum_mul_u64_status_t st = bignum_mul_u64_chain(&res, a, b, k);
+    if (len > BIGNUM_CAPACITY) {
+        assert(st == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(memcmp(&res, &saved, sizeof(res)) == 0);
+    } else {
+        assert(st == BIGNUM_MUL_U64_SUCCESS);
+        assert(res.len == (len == 0 ? 1 : len));
+        for (size_t i = 0; i < res.len; ++i) assert(res.words[i] == w[i]);
+    }
+
+    bignum_t x;
+    memset(&x, 0, sizeof(x));
+    memcpy(x.words, a->words, sizeof(x.words));
+    x.len = a->len;
+    st = bignum_mul_u64_chain(&x, &x, b, k);
+    if (len > BIGNUM_CAPACITY) {
+        assert(st == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(x.len == a->len && memcmp(x.words, a->words, sizeof(x.words)) == 0);
+    } else {
+        assert(st == BIGNUM_MUL_U64_SUCCESS);
+        assert(x.len == res.len && memcmp(x.words, res.words, res.len * sizeof(uint64_t)) == 0);
+    }
+}
+
+static void random_bignum(bignum_t *a, size_t len) {
+    for (size_t i = 0; i < len; ++i) a->words[i] = next_rand();
+    a->len = len;
+}
+
+/**
+ * @brief Тест 1: Факториал цепочками малых множителей.
+ */
+static void test_factorial(void) {
+    printf("Running test: test_factorial\n");
+    uint64_t b[MAX_FACTORS] = {0};
+    bignum_t one;
+    memset(&one, 0, sizeof(one));
+    one.words[0] = 1;
+    one.len = 1;
+    for (size_t k = 0; k <= MAX_FACTORS; ++k) {
+        if (k > 0) b[k - 1] = k;
+        check_chain(&one, b, k);
+    }
+    // n! по кускам, пока помещается
+    bignum_t f;
+    memset(&f, 0, sizeof(f));
+    f.words[0] = 1;
+    f.len = 1;
+    uint64_t n = 1;
+    for (;;) {
+        for (size_t i = 0; i < MAX_FACTORS; ++i) b[i] = n + i;
+        bignum_t before = f;
+        bignum_mul_u64_status_t st = bignum_mul_u64_chain(&f, &f, b, MAX_FACTORS);
+        check_chain(&before, b, MAX_FACTORS);
+        if (st != BIGNUM_MUL_U64_SUCCESS) break;
+        n += MAX_FACTORS;
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Случайные смеси множителей разной длины, единиц и нулей.
+ */
+static void test_random(void) {
+    printf("Running test: test_random\n");
+    uint64_t b[MAX_FACTORS];
+    for (int rep = 0; rep < 20000; ++rep) {
+        size_t k = next_rand() % (MAX_FACTORS + 1);
+        for (size_t i = 0; i < k; ++i) {
+            switch (next_rand() % 8) {
+            case 0: b[i] = 1; break;
+            case 1: b[i] = next_rand(); break;
+            case 2: b[i] = UINT64_MAX; break;
+            case 3: b[i] = (uint64_t)1 << (next_rand() % 64); break;
+            default: b[i] = next_rand() >> (next_rand() % 64); break;
+            }
+            if (b[i] == 0) b[i] = 3;
+        }
+        if (k > 0 && rep % 50 == 0) b[next_rand() % k] = 0;
+
+        bignum_t a;
+        random_bignum(&a, 1 + next_rand() % BIGNUM_CAPACITY);
+        if (rep % 7 == 0) a.words[a.len - 1] = 0;   // Ненормализованное множимое
+        if (rep % 11 == 0) a.words[a.len - 1] >>= next_rand() % 64;
+        check_chain(&a, b, k);
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Произведения у границы емкости.
+ */
+static void test_capacity_boundary(void) {
+    printf("Running test: test_capacity_boundary\n");
+    uint64_t b[8];
+    bignum_t a;
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) a.words[i] = UINT64_MAX;
+    a.len = BIGNUM_CAPACITY;
+
+    // (2^64C - 1) * 1 * 1 помещается, на 2 — нет
+    b[0] = 1;
+    b[1] = 1;
+    check_chain(&a, b, 2);
+    b[1] = 2;
+    check_chain(&a, b, 2);
+
+    // 2^(64C - s) на множители с суммой битовых длин около s
+    for (unsigned s = 1; s <= 130; ++s) {
+        memset(a.words, 0, sizeof(a.words));
+        size_t top = 64 * BIGNUM_CAPACITY - s;
+        a.words[top / 64] = (uint64_t)1 << (top % 64);
+        a.len = BIGNUM_CAPACITY;
+        for (int rep = 0; rep < 50; ++rep) {
+            size_t k = 1 + next_rand() % 8;
+            for (size_t i = 0; i < k; ++i) {
+                b[i] = (next_rand() >> (next_rand() % 64)) | 1;
+                if (rep % 5 == 0) b[i] = (uint64_t)1 << (next_rand() % 64);
+            }
+            check_chain(&a, b, k);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 4: NULL, k == 0, нулевой множитель, ноль и некорректная длина.
+ */
+static void test_special(void) {
+    printf("Running test: test_special\n");
+    bignum_t a, res;
+    memset(&res, 0, sizeof(res));
+    random_bignum(&a, BIGNUM_CAPACITY);
+    uint64_t b[3] = {5, 0, 7};
+
+    assert(bignum_mul_u64_chain(NULL, &a, b, 3) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_chain(&res, NULL, b, 3) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_chain(&res, &a, NULL, 3) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+
+    // k == 0 — копия a
+    assert(bignum_mul_u64_chain(&res, &a, NULL, 0) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == a.len && memcmp(res.words, a.words, a.len * sizeof(uint64_t)) == 0);
+
+    // Ноль среди множителей дает 0, даже если префикс переполнился бы
+    uint64_t big[MAX_FACTORS];
+    for (size_t i = 0; i < MAX_FACTORS; ++i) big[i] = UINT64_MAX;
+    big[MAX_FACTORS - 1] = 0;
+    assert(bignum_mul_u64_chain(&res, &a, big, MAX_FACTORS) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+    assert(bignum_mul_u64_chain(&res, &a, b, 3) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+
+    // Множимое 0 (len == 0 и нулевые слова)
+    bignum_t zero;
+    memset(&zero, 0, sizeof(zero));
+    assert(bignum_mul_u64_chain(&res, &zero, big, MAX_FACTORS - 1) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+    zero.len = 3;
+    assert(bignum_mul_u64_chain(&res, &zero, big, MAX_FACTORS - 1) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+
+    // Некорректная длина
+    bignum_t bad = a, saved;
+    bad.len = BIGNUM_CAPACITY + 1;
+    poison(&res);
+    saved = res;
+    assert(bignum_mul_u64_chain(&res, &bad, b, 3) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(memcmp(&res, &saved, sizeof(res)) == 0);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting chain tests for bignum_mul_u64_chain ---\n");
+    test_factorial();
+    test_random();
+    test_capacity_boundary();
+    test_special();
+    printf("\n--- All chain tests for bignum_mul_u64_chain passed ---\n");
+    return 0;
+}
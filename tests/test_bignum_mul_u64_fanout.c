@@ -0,0 +1,220 @@
+/**
+ * @file    test_bignum_mul_u64_fanout.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_u64_fanout и ядер bignum_mul_u64_n2.
+ *
+ * @details
+ *   Ядра пары (диспетчер, `_generic` и на BMI2/ADX `_mulx`) сверяются с
+ *   двумя вызовами bignum_mul_u64_n, в том числе с выходом на месте src.
+ *   Эталон fanout — bignum_mul_u64 на каждый множитель. Перебираются все длины
+ *   `a` и число множителей от 0 до 2 групп с остатком, множители 0, 1,
+ *   UINT64_MAX и случайные, ненормализованные операнды, выход на месте `a`
+ *   в любой позиции, переполнение части выходов при полной емкости и
+ *   особые аргументы.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+#define MAX_OUTPUTS 11
+
+static uint64_t rng_state = 0x6A09E667F3BCC908ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/** Заполняет слова res мусором; ядро пишет только младшие 32 бита длины. */
+static void poison(bignum_t *res) {
+    memset(res, 0, sizeof(*res));
+    memset(res->words, 0x5A, sizeof(res->words));
+    res->len = 7;
+}
+
+/**
+ * Проверяет bignum_mul_u64_fanout против bignum_mul_u64 на каждый
+ * множитель; alias >= 0 — выход с этим номером совпадает с a.
+ */
+static void check_fanout(const bignum_t *a, const uint64_t *b, size_t k, int alias) {
+    bignum_t expected[MAX_OUTPUTS], out[MAX_OUTPUTS], src = *a;
+    bignum_mul_u64_status_t st_exp[MAX_OUTPUTS];
+    bignum_t *res[MAX_OUTPUTS];
+    int overflow = 0;
+    for (size_t j = 0; j < k; ++j) {
+        poison(&expected[j]);
+        st_exp[j] = bignum_mul_u64(&expected[j], a, b[j]);
+        if (st_exp[j] != BIGNUM_MUL_U64_SUCCESS) overflow = 1;
+        poison(&out[j]);
+        res[j] = &out[j];
+    }
+    if (alias >= 0) res[alias] = &src;
+
+    bignum_mul_u64_status_t st = bignum_mul_u64_fanout(res, &src, b, k);
+    assert(st == (overflow ? BIGNUM_MUL_U64_ERROR_OVERFLOW : BIGNUM_MUL_U64_SUCCESS));
+    for (size_t j = 0; j < k; ++j) {
+        if (st_exp[j] == BIGNUM_MUL_U64_SUCCESS) {
+            assert(res[j]->len == expected[j].len);
+            assert(memcmp(res[j]->words, expected[j].words, expected[j].len * sizeof(uint64_t)) == 0);
+        } else {
+            assert(st_exp[j] == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+            assert(res[j]->len == ((int)j == alias ? a->len : 7));
+        }
+    }
+}
+
+typedef bignum_mul_u64_carry2_t (*n2_fn_t)(uint64_t *const[2], const uint64_t *, size_t, const uint64_t[2]);
+
+/**
+ * @brief Тест 1: Ядро пары против двух bignum_mul_u64_n, в том числе на месте src.
+ */
+static void test_n2(const char *name, n2_fn_t fn) {
+    printf("Running test: test_n2 (%s)\n", name);
+    uint64_t src[BIGNUM_CAPACITY], exp0[BIGNUM_CAPACITY], exp1[BIGNUM_CAPACITY];
+    uint64_t out0[BIGNUM_CAPACITY], out1[BIGNUM_CAPACITY];
+    for (size_t n = 0; n <= BIGNUM_CAPACITY; ++n) {
+        for (int rep = 0; rep < 50; ++rep) {
+            for (size_t i = 0; i < n; ++i) src[i] = rep % 2 ? next_rand() : (next_rand() % 3 ? UINT64_MAX : 0);
+            uint64_t b[2] = {next_rand(), rep % 7 == 0 ? UINT64_MAX : next_rand() >> (next_rand() % 64)};
+            if (rep % 5 == 0) b[rep % 2] = 0;
+            uint64_t c0 = bignum_mul_u64_n(exp0, src, n, b[0]);
+            uint64_t c1 = bignum_mul_u64_n(exp1, src, n, b[1]);
+
+            uint64_t *dst[2] = {out0, out1};
+            bignum_mul_u64_carry2_t c = fn(dst, src, n, b);
+            assert(c.carry[0] == c0 && c.carry[1] == c1);
+            assert(memcmp(out0, exp0, n * sizeof(uint64_t)) == 0);
+            assert(memcmp(out1, exp1, n * sizeof(uint64_t)) == 0);
+
+            // Второй выход на месте src
+            memcpy(out1, src, n * sizeof(uint64_t));
+            dst[1] = out1;
+            c = fn(dst, out1, n, b);
+            assert(c.carry[0] == c0 && c.carry[1] == c1);
+            assert(memcmp(out0, exp0, n * sizeof(uint64_t)) == 0);
+            assert(memcmp(out1, exp1, n * sizeof(uint64_t)) == 0);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Все длины и числа выходов, случайные и крайние множители.
+ */
+static void test_random(void) {
+    printf("Running test: test_random\n");
+    uint64_t b[MAX_OUTPUTS];
+    bignum_t a;
+    memset(&a, 0, sizeof(a));
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t k = 0; k <= MAX_OUTPUTS; ++k) {
+            for (int rep = 0; rep < 20; ++rep) {
+                for (size_t i = 0; i < len; ++i) a.words[i] = next_rand();
+                if (len > 0 && rep % 4 == 0) a.words[len - 1] = 0;   // Ненормализованное
+                if (len > 0 && rep % 5 == 0) a.words[len - 1] >>= next_rand() % 64;
+                a.len = len;
+                for (size_t j = 0; j < k; ++j) {
+                    switch (next_rand() % 6) {
+                    case 0: b[j] = 0; break;
+                    case 1: b[j] = 1; break;
+                    case 2: b[j] = UINT64_MAX; break;
+                    default: b[j] = next_rand() >> (next_rand() % 64); break;
+                    }
+                }
+                int alias = k > 0 && rep % 3 == 0 ? (int)(next_rand() % k) : -1;
+                check_fanout(&a, b, k, alias);
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Полная емкость — переполняются только выходы с переносом.
+ */
+static void test_overflow(void) {
+    printf("Running test: test_overflow\n");
+    uint64_t b[MAX_OUTPUTS];
+    bignum_t a;
+    memset(&a, 0, sizeof(a));
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) a.words[i] = UINT64_MAX >> 1;
+    a.len = BIGNUM_CAPACITY;
+    for (size_t k = 1; k <= MAX_OUTPUTS; ++k) {
+        // Множители 1 и 2 помещаются, 3 и больше — нет
+        for (size_t j = 0; j < k; ++j) b[j] = 1 + next_rand() % 4;
+        check_fanout(&a, b, k, -1);
+        check_fanout(&a, b, k, (int)(k - 1));
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 4: NULL, k == 0, нулевое множимое, некорректная длина.
+ */
+static void test_special(void) {
+    printf("Running test: test_special\n");
+    bignum_t a, r0, r1;
+    memset(&a, 0, sizeof(a));
+    a.words[0] = 5;
+    a.len = 1;
+    uint64_t b[2] = {3, 4};
+    bignum_t *res[2] = {&r0, &r1};
+
+    assert(bignum_mul_u64_fanout(res, NULL, b, 2) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_fanout(NULL, &a, b, 2) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_fanout(res, &a, NULL, 2) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_fanout(NULL, &a, NULL, 0) == BIGNUM_MUL_U64_SUCCESS);
+
+    // NULL среди выходов: ничего не записано
+    bignum_t *holes[2] = {&r0, NULL};
+    poison(&r0);
+    assert(bignum_mul_u64_fanout(holes, &a, b, 2) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(r0.len == 7);
+
+    // Нулевое множимое
+    a.words[0] = 0;
+    a.len = 1;
+    poison(&r0);
+    poison(&r1);
+    assert(bignum_mul_u64_fanout(res, &a, b, 2) == BIGNUM_MUL_U64_SUCCESS);
+    assert(r0.len == 1 && r0.words[0] == 0 && r1.len == 1 && r1.words[0] == 0);
+
+    // Некорректная длина: ничего не записано
+    a.len = BIGNUM_CAPACITY + 1;
+    poison(&r0);
+    assert(bignum_mul_u64_fanout(res, &a, b, 2) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(r0.len == 7);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting tests for bignum_mul_u64_fanout ---\n");
+    test_n2("bignum_mul_u64_n2", bignum_mul_u64_n2);
+    test_n2("bignum_mul_u64_n2_generic", bignum_mul_u64_n2_generic);
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        test_n2("bignum_mul_u64_n2_mulx", bignum_mul_u64_n2_mulx);
+    } else {
+        printf("Skipping bignum_mul_u64_n2_mulx: BMI2/ADX not supported\n");
+    }
+#else
+    printf("Skipping bignum_mul_u64_n2_mulx: x86-64 only\n");
+#endif
+    test_random();
+    test_overflow();
+    test_special();
+    printf("\n--- All tests for bignum_mul_u64_fanout passed ---\n");
+    return 0;
+}
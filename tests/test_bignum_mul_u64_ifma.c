@@ -0,0 +1,154 @@
+/**
+ * @file    test_bignum_mul_u64_ifma.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты пакетного движка на AVX-512 IFMA.
+ *
+ * @details
+ *   Сравнивает bignum_mul_u64_batch_ifma и bignum_mul_u64_batch_scalar_ifma
+ *   со скалярными bignum_mul_u64_batch*_generic: одинаковые длины всех
+ *   групп (векторный путь) для каждой длины 1..BIGNUM_CAPACITY, разные
+ *   длины, b == 0 и 1, переполнение в отдельных элементах, остаток n mod 8,
+ *   умножение "на месте" и статусы. Слова выше длины результата
+ *   сравниваются тоже (кроме теста со старшими нулевыми словами). Без
+ *   AVX-512 IFMA тест пропускается.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Тест со старшими нулевыми словами.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+#define BATCH_N 45
+
+static uint64_t rng_state = 0x8EBC6AF09C88C6E3ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static bignum_t a[BATCH_N], res_gen[BATCH_N], res_ifma[BATCH_N];
+static uint64_t b[BATCH_N];
+
+/** Заполняет пакет; len == 0 — случайная длина для каждого элемента. */
+static void fill_inputs(size_t len) {
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        size_t l = len ? len : 1 + (size_t)(next_rand() % BIGNUM_CAPACITY);
+        for (size_t j = 0; j < BIGNUM_CAPACITY; ++j) a[i].words[j] = next_rand();
+        a[i].len = l;
+        for (size_t j = 0; j < BIGNUM_CAPACITY; ++j) res_gen[i].words[j] = next_rand();
+        res_gen[i].len = 5;
+        b[i] = next_rand();
+    }
+    memcpy(res_ifma, res_gen, sizeof(res_gen));
+}
+
+static void assert_same_results(void) {
+    for (size_t i = 0; i < BATCH_N; ++i) {
+        assert(res_gen[i].len == res_ifma[i].len);
+        assert(memcmp(res_gen[i].words, res_ifma[i].words, sizeof(res_gen[i].words)) == 0);
+    }
+}
+
+static void run_both(void) {
+    bignum_mul_u64_status_t st_gen[BATCH_N], st_ifma[BATCH_N];
+    bignum_mul_u64_status_t ret_gen = bignum_mul_u64_batch_generic(res_gen, a, b, BATCH_N, st_gen);
+    bignum_mul_u64_status_t ret_ifma = bignum_mul_u64_batch_ifma(res_ifma, a, b, BATCH_N, st_ifma);
+    assert(ret_gen == ret_ifma);
+    assert(memcmp(st_gen, st_ifma, sizeof(st_gen)) == 0);
+    assert_same_results();
+}
+
+/**
+ * @brief Тест 1: Векторный путь на каждой длине, включая переполнение.
+ */
+static void test_uniform_lengths(void) {
+    printf("Running test: test_uniform_lengths\n");
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        fill_inputs(len);
+        b[3] = 1;
+        b[10] = UINT64_MAX;
+        a[11].words[len - 1] = UINT64_MAX; /* перенос в слово len */
+        b[11] = UINT64_MAX;
+        run_both();
+
+        /* Общий множитель и "на месте" */
+        fill_inputs(len);
+        memcpy(res_gen, a, sizeof(a));
+        memcpy(res_ifma, a, sizeof(a));
+        bignum_mul_u64_status_t ret_gen = bignum_mul_u64_batch_scalar_generic(res_gen, res_gen, b[0], BATCH_N, NULL);
+        bignum_mul_u64_status_t ret_ifma = bignum_mul_u64_batch_scalar_ifma(res_ifma, res_ifma, b[0], BATCH_N, NULL);
+        assert(ret_gen == ret_ifma);
+        assert_same_results();
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Разные длины, b == 0, некорректная длина и NULL.
+ */
+static void test_ragged_and_edge_cases(void) {
+    printf("Running test: test_ragged_and_edge_cases\n");
+    fill_inputs(0);
+    run_both();
+
+    fill_inputs(4);
+    b[17] = 0;
+    a[30].len = BIGNUM_CAPACITY + 3;
+    run_both();
+
+    assert(bignum_mul_u64_batch_ifma(NULL, NULL, NULL, 0, NULL) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64_batch_ifma(res_ifma, a, NULL, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch_scalar_ifma(NULL, a, 7, 1, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Старшие нулевые слова в группе одинаковой длины.
+ *
+ * @details Векторный путь умножает нули и пишет их, скалярное ядро их
+ *          пропускает, поэтому слова сравниваются только до длины.
+ */
+static void test_padded_lanes(void) {
+    printf("Running test: test_padded_lanes\n");
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        fill_inputs(len);
+        for (size_t i = 0; i < BATCH_N; ++i) {
+            size_t sig = (size_t)(next_rand() % (len + 1));
+            for (size_t j = sig; j < len; ++j) a[i].words[j] = 0;
+        }
+        bignum_mul_u64_status_t st_gen[BATCH_N], st_ifma[BATCH_N];
+        assert(bignum_mul_u64_batch_generic(res_gen, a, b, BATCH_N, st_gen) ==
+               bignum_mul_u64_batch_ifma(res_ifma, a, b, BATCH_N, st_ifma));
+        assert(memcmp(st_gen, st_ifma, sizeof(st_gen)) == 0);
+        for (size_t i = 0; i < BATCH_N; ++i) {
+            assert(res_gen[i].len == res_ifma[i].len);
+            assert(memcmp(res_gen[i].words, res_ifma[i].words, res_gen[i].len * sizeof(uint64_t)) == 0);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting IFMA batch tests for bignum_mul_u64 ---\n");
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512ifma")) {
+        printf("Skipping: AVX-512 IFMA not supported\n");
+        return 0;
+    }
+    test_uniform_lengths();
+    test_ragged_and_edge_cases();
+    test_padded_lanes();
+    printf("\n--- All IFMA batch tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    test_bignum_mul_u64_inline.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты встраиваемой реализации bignum_mul_u64_inline.
+ *
+ * @details
+ *   Проверяет, что `bignum_mul_u64_inline` совпадает с ассемблерной
+ *   `bignum_mul_u64` по статусу, словам результата (включая слова выше
+ *   длины) и `len` для всех длин от 0 до BIGNUM_CAPACITY, набора множителей,
+ *   умножения "на месте", а также для некорректных длин и NULL-аргументов.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64_inline.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+static uint64_t rng_state = 0xA0761D6478BD642FULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void fill_random(bignum_t *x, size_t len) {
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) x->words[i] = next_rand();
+    x->len = len;
+}
+
+/** Сравнивает две структуры целиком, включая слова выше len. */
+static int bignum_are_identical(const bignum_t* x, const bignum_t* y) {
+    return x->len == y->len && memcmp(x->words, y->words, sizeof(x->words)) == 0;
+}
+
+/**
+ * @brief Тест 1: Все длины, набор множителей, обычный вызов и "на месте".
+ */
+static void test_matches_asm(void) {
+    printf("Running test: test_matches_asm\n");
+    const uint64_t multipliers[] = {
+        0, 1, 2, 10, 0xFFFFFFFFULL, 1ULL << 63, UINT64_MAX, 0x123456789ABCDEF1ULL
+    };
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t m = 0; m < sizeof(multipliers) / sizeof(multipliers[0]); ++m) {
+            bignum_t a, res_asm, res_inl, x_asm, x_inl;
+            fill_random(&a, len);
+            fill_random(&res_asm, 3);
+            res_inl = res_asm;
+
+            bignum_mul_u64_status_t st_asm = bignum_mul_u64(&res_asm, &a, multipliers[m]);
+            bignum_mul_u64_status_t st_inl = bignum_mul_u64_inline(&res_inl, &a, multipliers[m]);
+            assert(st_asm == st_inl);
+            assert(bignum_are_identical(&res_asm, &res_inl));
+
+            x_asm = a;
+            x_inl = a;
+            st_asm = bignum_mul_u64(&x_asm, &x_asm, multipliers[m]);
+            st_inl = bignum_mul_u64_inline(&x_inl, &x_inl, multipliers[m]);
+            assert(st_asm == st_inl);
+            assert(bignum_are_identical(&x_asm, &x_inl));
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Некорректные длины, отрицательная длина в младших 32 битах и NULL.
+ */
+static void test_edge_cases(void) {
+    printf("Running test: test_edge_cases\n");
+    const size_t bad_lens[] = {BIGNUM_CAPACITY + 1, 0xFFFFFFFFu, 0x80000000u};
+    for (size_t i = 0; i < sizeof(bad_lens) / sizeof(bad_lens[0]); ++i) {
+        bignum_t a, res_asm, res_inl;
+        fill_random(&a, bad_lens[i]);
+        fill_random(&res_asm, 2);
+        res_inl = res_asm;
+        assert(bignum_mul_u64(&res_asm, &a, 7) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(bignum_mul_u64_inline(&res_inl, &a, 7) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(bignum_are_identical(&res_asm, &res_inl));
+    }
+
+    bignum_t a;
+    fill_random(&a, 1);
+    assert(bignum_mul_u64_inline(NULL, &a, 7) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_inline(&a, NULL, 7) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+
+    /* Константный множитель после встраивания */
+    a.words[0] = 6;
+    assert(bignum_mul_u64_inline(&a, &a, 7) == BIGNUM_MUL_U64_SUCCESS);
+    assert(a.len == 1 && a.words[0] == 42);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting inline tests for bignum_mul_u64 ---\n");
+    test_matches_asm();
+    test_edge_cases();
+    printf("\n--- All inline tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
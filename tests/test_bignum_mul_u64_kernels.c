@@ -0,0 +1,222 @@
+/**
+ * @file    test_bignum_mul_u64_kernels.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Сравнительные тесты ядер bignum_mul_u64.
+ *
+ * @details
+ *   Проверяет, что `bignum_mul_u64_generic`, `bignum_mul_u64_mulx` и
+ *   диспетчер `bignum_mul_u64` дают одинаковый результат и статус,
+ *   совпадающие с эталонной реализацией на `unsigned __int128`.
+ *   Перебираются все длины от 0 до BIGNUM_CAPACITY и набор множителей,
+ *   включая случаи с переполнением и умножение "на месте".
+ *   Множители включают 0 и 1 (быстрые пути ядер) и степени двойки.
+ *   Ядро `mulx` проверяется только на процессорах с BMI2 и ADX.
+ *   Отдельно проверяется сокращение длины при старших нулевых словах
+ *   и bignum_mul_u64_trim_count.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Тесты ненормализованных операндов.
+ *   - rev. 3 (14.10.2026): Ядра `mulx` проверяются только на x86-64.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+typedef bignum_mul_u64_status_t (*mul_fn_t)(bignum_t *, const bignum_t *, uint64_t);
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/** Эталонная реализация с той же семантикой статусов, что и у ядер. */
+static bignum_mul_u64_status_t ref_mul(bignum_t *res, const bignum_t *a, uint64_t b) {
+    size_t len = a->len;
+    if (len == 0 || b == 0) {
+        res->words[0] = 0;
+        res->len = 1;
+        return BIGNUM_MUL_U64_SUCCESS;
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < len; ++i) {
+        u128_t p = (u128_t)a->words[i] * b + carry;
+        res->words[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    if (carry) {
+        if (len >= BIGNUM_CAPACITY) return BIGNUM_MUL_U64_ERROR_OVERFLOW;
+        res->words[len++] = carry;
+    }
+    res->len = len;
+    return BIGNUM_MUL_U64_SUCCESS;
+}
+
+static int bignum_are_equal(const bignum_t* x, const bignum_t* y) {
+    if (x->len != y->len) return 0;
+    return memcmp(x->words, y->words, x->len * sizeof(uint64_t)) == 0;
+}
+
+static void fill_random(bignum_t *x, size_t len) {
+    memset(x, 0, sizeof(*x));
+    for (size_t i = 0; i < len; ++i) x->words[i] = next_rand();
+    x->len = len;
+}
+
+/**
+ * @brief Прогоняет ядро по всем длинам и набору множителей.
+ */
+static void check_kernel(const char *name, mul_fn_t fn) {
+    printf("Running test: check_kernel(%s)\n", name);
+    const uint64_t multipliers[] = {
+        0, 1, 2, 3, 8, 10, 1ULL << 37, 0xFFFFFFFFULL, 1ULL << 63, UINT64_MAX,
+        0x123456789ABCDEF1ULL
+    };
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t m = 0; m < sizeof(multipliers) / sizeof(multipliers[0]); ++m) {
+            bignum_t a, res, expected, inplace;
+            fill_random(&a, len);
+            memset(&res, 0, sizeof(res));
+            memset(&expected, 0, sizeof(expected));
+
+            bignum_mul_u64_status_t st_ref = ref_mul(&expected, &a, multipliers[m]);
+            bignum_mul_u64_status_t st = fn(&res, &a, multipliers[m]);
+            assert(st == st_ref);
+            if (st == BIGNUM_MUL_U64_SUCCESS) {
+                assert(bignum_are_equal(&res, &expected));
+            }
+
+            /* Умножение "на месте" */
+            inplace = a;
+            st = fn(&inplace, &inplace, multipliers[m]);
+            assert(st == st_ref);
+            if (st == BIGNUM_MUL_U64_SUCCESS) {
+                assert(bignum_are_equal(&inplace, &expected));
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Гарантированное переполнение на полной длине.
+ */
+static void check_overflow(const char *name, mul_fn_t fn) {
+    printf("Running test: check_overflow(%s)\n", name);
+    bignum_t a, res;
+    memset(&a, 0, sizeof(a));
+    a.len = BIGNUM_CAPACITY;
+    a.words[BIGNUM_CAPACITY - 1] = UINT64_MAX;
+    memset(&res, 0, sizeof(res));
+    assert(fn(&res, &a, 2) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Старшие нулевые слова a: длина результата точная.
+ *
+ * @details Эталон считается на a с уже сокращенной длиной. Слова res выше
+ *          длины результата не должны меняться: нули не умножаются.
+ */
+static void check_padded(const char *name, mul_fn_t fn) {
+    printf("Running test: check_padded(%s)\n", name);
+    const uint64_t multipliers[] = {0, 1, 2, UINT64_MAX, 0x123456789ABCDEF1ULL};
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t sig = 0; sig < len; ++sig) {
+            for (size_t m = 0; m < sizeof(multipliers) / sizeof(multipliers[0]); ++m) {
+                bignum_t a, trimmed, res, expected;
+                fill_random(&trimmed, sig);
+                a = trimmed;
+                a.len = len;                          /* слова sig..len-1 нулевые */
+                memset(&expected, 0, sizeof(expected));
+                assert(ref_mul(&expected, &trimmed, multipliers[m]) == BIGNUM_MUL_U64_SUCCESS);
+
+                memset(&res, 0xA5, sizeof(res.words));
+                res.len = 0;
+                assert(fn(&res, &a, multipliers[m]) == BIGNUM_MUL_U64_SUCCESS);
+                assert(bignum_are_equal(&res, &expected));
+                for (size_t k = res.len; k < BIGNUM_CAPACITY; ++k) {
+                    assert(res.words[k] == 0xA5A5A5A5A5A5A5A5ULL);
+                }
+
+                /* "На месте", в том числе b == 1: пишется только длина */
+                bignum_t inplace = a;
+                assert(fn(&inplace, &inplace, multipliers[m]) == BIGNUM_MUL_U64_SUCCESS);
+                assert(bignum_are_equal(&inplace, &expected));
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief bignum_mul_u64_trim_count: счетчик пропущенных слов и результат.
+ */
+static void check_trim_count(void) {
+    printf("Running test: check_trim_count\n");
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t sig = 0; sig <= len; ++sig) {
+            bignum_t a, res, expected;
+            fill_random(&a, sig);
+            a.len = len;
+            memset(&expected, 0, sizeof(expected));
+            bignum_mul_u64_status_t st_ref = bignum_mul_u64(&expected, &a, 3);
+
+            size_t skipped = 12345;
+            memset(&res, 0, sizeof(res));
+            assert(bignum_mul_u64_trim_count(&res, &a, 3, &skipped) == st_ref);
+            assert(skipped == len - sig);
+            assert(bignum_are_equal(&res, &expected));
+            assert(bignum_mul_u64_trim_count(&res, &a, 3, NULL) == st_ref);
+        }
+    }
+
+    bignum_t a;
+    size_t skipped = 7;
+    fill_random(&a, 1);
+    assert(bignum_mul_u64_trim_count(NULL, &a, 3, &skipped) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(skipped == 0);
+    a.len = BIGNUM_CAPACITY + 1;
+    skipped = 7;
+    assert(bignum_mul_u64_trim_count(&a, &a, 3, &skipped) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(skipped == 0);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting kernel tests for bignum_mul_u64 ---\n");
+    check_kernel("bignum_mul_u64", bignum_mul_u64);
+    check_overflow("bignum_mul_u64", bignum_mul_u64);
+    check_padded("bignum_mul_u64", bignum_mul_u64);
+    check_trim_count();
+    check_kernel("bignum_mul_u64_generic", bignum_mul_u64_generic);
+    check_overflow("bignum_mul_u64_generic", bignum_mul_u64_generic);
+    check_padded("bignum_mul_u64_generic", bignum_mul_u64_generic);
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        check_kernel("bignum_mul_u64_mulx", bignum_mul_u64_mulx);
+        check_overflow("bignum_mul_u64_mulx", bignum_mul_u64_mulx);
+        check_padded("bignum_mul_u64_mulx", bignum_mul_u64_mulx);
+    } else {
+        printf("Skipping bignum_mul_u64_mulx: BMI2/ADX not supported\n");
+    }
+#else
+    printf("Skipping bignum_mul_u64_mulx: x86-64 only\n");
+#endif
+    printf("\n--- All kernel tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
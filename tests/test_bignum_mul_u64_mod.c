@@ -0,0 +1,267 @@
+/**
+ * @file    test_bignum_mul_u64_mod.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_u64_mod_init и bignum_mul_u64_mod.
+ *
+ * @details
+ *   Эталон — точное произведение и остаток делением столбиком по битам.
+ *   Проверяются случайные модули всех длин, модули и множимые из слов на
+ *   границах (0, 1, 2^63, 2^64 - 1), на которых оценка частного ошибается
+ *   чаще всего, цепочка x = x * b mod m на месте и ошибки: NULL, модуль 0,
+ *   a >= m и некорректная длина.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/** Слово на границе или случайное. */
+static uint64_t edge_word(void) {
+    switch (next_rand() % 6) {
+    case 0: return 0;
+    case 1: return 1;
+    case 2: return (uint64_t)1 << 63;
+    case 3: return UINT64_MAX;
+    case 4: return UINT64_MAX - (next_rand() % 4);
+    default: return next_rand();
+    }
+}
+
+/** r[0..n) = x[0..xn) mod m[0..n) столбиком по битам (m[n-1] != 0). */
+static void reference_mod(const uint64_t *x, size_t xn, const uint64_t *m, size_t n, uint64_t *r) {
+    uint64_t rem[BIGNUM_CAPACITY + 1];
+    memset(rem, 0, sizeof(rem));
+    for (size_t bit = 64 * xn; bit-- > 0;) {
+        uint64_t in = (x[bit / 64] >> (bit % 64)) & 1;
+        for (size_t i = n + 1; i-- > 1;) rem[i] = (rem[i] << 1) | (rem[i - 1] >> 63);
+        rem[0] = (rem[0] << 1) | in;
+        int geq = rem[n] != 0;
+        for (size_t i = n; !geq && i-- > 0;) {
+            if (rem[i] != m[i]) {
+                geq = rem[i] > m[i];
+                break;
+            }
+            if (i == 0) geq = 1;
+        }
+        if (geq) {
+            uint64_t c = 0;
+            for (size_t i = 0; i <= n; ++i) {
+                uint64_t mi = i < n ? m[i] : 0;
+                u128_t d = (u128_t)rem[i] - mi - c;
+                rem[i] = (uint64_t)d;
+                c = (uint64_t)(d >> 64) & 1;
+            }
+        }
+    }
+    memcpy(r, rem, n * sizeof(uint64_t));
+}
+
+static void make_bignum(bignum_t *x, const uint64_t *w, size_t n) {
+    memset(x, 0, sizeof(*x));
+    memcpy(x->words, w, n * sizeof(uint64_t));
+    x->len = n;
+}
+
+/** Проверяет (a * b) mod m против эталона; a приводится по модулю заранее. */
+static void check_mod(const uint64_t *mw, size_t n, const uint64_t *aw, size_t an, uint64_t b) {
+    bignum_t m, a, res;
+    make_bignum(&m, mw, n);
+    bignum_mul_u64_mod_ctx_t ctx;
+    assert(bignum_mul_u64_mod_init(&ctx, &m) == BIGNUM_MUL_U64_SUCCESS);
+
+    uint64_t ra[BIGNUM_CAPACITY];
+    reference_mod(aw, an, mw, n, ra);
+    make_bignum(&a, ra, n);
+
+    uint64_t x[BIGNUM_CAPACITY + 1];
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128_t p = (u128_t)ra[i] * b + carry;
+        x[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    x[n] = carry;
+    uint64_t expected[BIGNUM_CAPACITY];
+    reference_mod(x, n + 1, mw, n, expected);
+    size_t len = n;
+    while (len > 1 && expected[len - 1] == 0) --len;
+
+    memset(&res, 0, sizeof(res));
+    assert(bignum_mul_u64_mod(&res, &a, b, &ctx) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == len);
+    assert(memcmp(res.words, expected, len * sizeof(uint64_t)) == 0);
+
+    assert(bignum_mul_u64_mod(&a, &a, b, &ctx) == BIGNUM_MUL_U64_SUCCESS);
+    assert(a.len == len && memcmp(a.words, expected, len * sizeof(uint64_t)) == 0);
+}
+
+/**
+ * @brief Тест 1: Случайные модули, множимые и множители всех длин.
+ */
+static void test_random(void) {
+    printf("Running test: test_random\n");
+    uint64_t m[BIGNUM_CAPACITY], a[BIGNUM_CAPACITY];
+    for (size_t n = 1; n <= BIGNUM_CAPACITY; ++n) {
+        for (int rep = 0; rep < 40; ++rep) {
+            for (size_t i = 0; i < n; ++i) {
+                m[i] = next_rand();
+                a[i] = next_rand();
+            }
+            m[n - 1] >>= next_rand() % 64;
+            if (m[n - 1] == 0) m[n - 1] = 1;
+            uint64_t b = rep % 8 == 0 ? UINT64_MAX : next_rand() >> (next_rand() % 64);
+            check_mod(m, n, a, n, b);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Слова на границах у коротких модулей.
+ */
+static void test_edge_words(void) {
+    printf("Running test: test_edge_words\n");
+    uint64_t m[4], a[4];
+    size_t max_n = BIGNUM_CAPACITY < 4 ? BIGNUM_CAPACITY : 4;
+    for (int rep = 0; rep < 200000; ++rep) {
+        size_t n = 1 + (size_t)(next_rand() % max_n);
+        for (size_t i = 0; i < n; ++i) {
+            m[i] = edge_word();
+            a[i] = edge_word();
+        }
+        if (m[n - 1] == 0) m[n - 1] = 1;
+        m[n - 1] >>= next_rand() % 4 == 0 ? next_rand() % 64 : 0;
+        if (m[n - 1] == 0) m[n - 1] = 1;
+        check_mod(m, n, a, n, edge_word());
+    }
+
+    // m = 1: любой результат 0
+    const uint64_t one = 1, zero = 0;
+    check_mod(&one, 1, &zero, 1, UINT64_MAX);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Цепочка x = x * b mod m на месте.
+ */
+static void test_chain(void) {
+    printf("Running test: test_chain\n");
+    uint64_t mw[BIGNUM_CAPACITY];
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) mw[i] = next_rand();
+    mw[BIGNUM_CAPACITY - 1] |= (uint64_t)1 << 63;
+    bignum_t m, x;
+    make_bignum(&m, mw, BIGNUM_CAPACITY);
+    bignum_mul_u64_mod_ctx_t ctx;
+    assert(bignum_mul_u64_mod_init(&ctx, &m) == BIGNUM_MUL_U64_SUCCESS);
+
+    uint64_t ref[BIGNUM_CAPACITY] = {1};
+    memset(&x, 0, sizeof(x));
+    x.words[0] = 1;
+    x.len = 1;
+    for (int step = 0; step < 300; ++step) {
+        uint64_t b = next_rand();
+        uint64_t p[BIGNUM_CAPACITY + 1];
+        uint64_t carry = 0;
+        for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) {
+            u128_t t = (u128_t)ref[i] * b + carry;
+            p[i] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        p[BIGNUM_CAPACITY] = carry;
+        reference_mod(p, BIGNUM_CAPACITY + 1, mw, BIGNUM_CAPACITY, ref);
+
+        assert(bignum_mul_u64_mod(&x, &x, b, &ctx) == BIGNUM_MUL_U64_SUCCESS);
+        size_t len = BIGNUM_CAPACITY;
+        while (len > 1 && ref[len - 1] == 0) --len;
+        assert(x.len == len && memcmp(x.words, ref, len * sizeof(uint64_t)) == 0);
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 4: NULL, модуль 0, a >= m и некорректная длина.
+ */
+static void test_errors(void) {
+    printf("Running test: test_errors\n");
+    bignum_t m, a, res, saved;
+    bignum_mul_u64_mod_ctx_t ctx;
+    memset(&m, 0, sizeof(m));
+    m.len = 2;
+    assert(bignum_mul_u64_mod_init(NULL, &m) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_mod_init(&ctx, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_mod_init(&ctx, &m) == BIGNUM_MUL_U64_ERROR_DOMAIN);
+    m.len = 0;
+    assert(bignum_mul_u64_mod_init(&ctx, &m) == BIGNUM_MUL_U64_ERROR_DOMAIN);
+    m.len = BIGNUM_CAPACITY + 1;
+    assert(bignum_mul_u64_mod_init(&ctx, &m) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+
+    // m = 2^64 + 5, старшие нулевые слова отбрасываются
+    m.words[0] = 5;
+    m.words[1] = 1;
+    m.len = BIGNUM_CAPACITY >= 3 ? 3 : 2;
+    assert(bignum_mul_u64_mod_init(&ctx, &m) == BIGNUM_MUL_U64_SUCCESS);
+    assert(ctx.len == 2);
+
+    memset(&res, 0, sizeof(res));
+    memset(res.words, 0x5A, sizeof(res.words));
+    saved = res;
+    a = m;
+    assert(bignum_mul_u64_mod(NULL, &a, 3, &ctx) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_mod(&res, NULL, 3, &ctx) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_mod(&res, &a, 3, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_mod(&res, &a, 3, &ctx) == BIGNUM_MUL_U64_ERROR_DOMAIN);   // a == m
+    a.words[0] = 6;
+    assert(bignum_mul_u64_mod(&res, &a, 3, &ctx) == BIGNUM_MUL_U64_ERROR_DOMAIN);   // a > m
+    if (BIGNUM_CAPACITY >= 3) {
+        a.words[0] = 1;
+        a.words[1] = 0;
+        a.words[2] = 1;
+        a.len = 3;
+        assert(bignum_mul_u64_mod(&res, &a, 3, &ctx) == BIGNUM_MUL_U64_ERROR_DOMAIN);   // длиннее m
+    }
+    a.len = BIGNUM_CAPACITY + 1;
+    assert(bignum_mul_u64_mod(&res, &a, 3, &ctx) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(memcmp(&res, &saved, sizeof(res)) == 0);
+
+    // a = m - 1 = 2^64 + 4, b = 0 и b = 1; a == 0 с len == 0
+    a.words[0] = 4;
+    a.words[1] = 1;
+    a.len = 2;
+    assert(bignum_mul_u64_mod(&res, &a, 0, &ctx) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+    assert(bignum_mul_u64_mod(&res, &a, 1, &ctx) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 2 && res.words[0] == 4 && res.words[1] == 1);
+    a.len = 0;
+    assert(bignum_mul_u64_mod(&res, &a, 7, &ctx) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting modular tests for bignum_mul_u64_mod ---\n");
+    test_random();
+    test_edge_words();
+    test_chain();
+    test_errors();
+    printf("\n--- All modular tests for bignum_mul_u64_mod passed ---\n");
+    return 0;
+}
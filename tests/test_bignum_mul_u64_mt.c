@@ -13,11 +13,18 @@
  *   данными, переданными через аргументы, вызовы из разных потоков не должны
  *   влиять друг на друга. Успешное прохождение теста доказывает это.
  *
+ *   Вторая часть нагружает пул bignum_mul_u64_submit: несколько потоков
+ *   отправляют пачки случайной длины (от пустых до десятков кусков, с
+ *   переполнениями) в пулы из 1 и 4 рабочих, ждут их через
+ *   bignum_mul_u64_wait, опрос или обратный вызов и сверяют результаты и
+ *   статусы с последовательным bignum_mul_u64.
+ *
  * @note    Для сборки требуется флаг `-pthread`.
  *
  * @history
  *   - rev. 1 (01.08.2025): Некорректная версия с заглушкой.
  *   - rev. 2 (01.08.2025): Реализован полноценный динамический тест с pthreads.
+ *   - rev. 3 (14.10.2026): Нагрузочный тест пула с кражей работы.
  */
 
 #include "bignum_mul_u64.h"
@@ -27,10 +34,18 @@
 #include <assert.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <stdatomic.h>
 
 #define NUM_THREADS 10
 #define NUM_ITERATIONS 100000
 
+#define POOL_SUBMITTERS 4
+#define POOL_ROUNDS     60
+#define POOL_INFLIGHT   3     // Пакетов одного отправителя одновременно
+#define POOL_MAX_BATCH  2048
+
 typedef struct {
     int thread_id;
     bignum_t a;
@@ -72,6 +87,199 @@ void* thread_func(void* arg) {
     return NULL;
 }
 
+typedef struct {
+    bignum_t *a;
+    bignum_t *res;
+    bignum_t *expected;
+    uint64_t *b;
+    bignum_mul_u64_status_t *st;
+    bignum_mul_u64_status_t *expected_st;
+    size_t n;
+    bignum_mul_u64_status_t expected_batch;
+    bignum_mul_u64_job_t *job;
+    atomic_int cb_calls;
+    bignum_mul_u64_status_t cb_status;
+} pool_burst_t;
+
+typedef struct {
+    bignum_mul_u64_pool_t *pool;
+    uint64_t seed;
+    pool_burst_t burst[POOL_INFLIGHT];
+    int ok;
+} pool_submitter_t;
+
+static uint64_t next_rand(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static void pool_done(void *arg, bignum_mul_u64_status_t status) {
+    pool_burst_t *p = arg;
+    p->cb_status = status;
+    atomic_fetch_add_explicit(&p->cb_calls, 1, memory_order_release);
+}
+
+/** Длина пачки: пустые, одиночные, меньше куска и на много кусков. */
+static size_t burst_size(uint64_t *s) {
+    switch (next_rand(s) % 6) {
+    case 0: return 0;
+    case 1: return 1;
+    case 2: return 1 + next_rand(s) % 64;
+    default: return next_rand(s) % (POOL_MAX_BATCH + 1);
+    }
+}
+
+/** Заполняет пачку и считает ожидаемый результат последовательно. */
+static void burst_fill(pool_burst_t *p, size_t n, uint64_t *s) {
+    p->n = n;
+    p->expected_batch = BIGNUM_MUL_U64_SUCCESS;
+    for (size_t i = 0; i < n; ++i) {
+        bignum_t *x = &p->a[i];
+        memset(x, 0, sizeof(*x));
+        x->len = 1 + next_rand(s) % BIGNUM_CAPACITY;
+        for (size_t k = 0; k < x->len; ++k) x->words[k] = next_rand(s);
+        if (next_rand(s) % 16 == 0) x->len = BIGNUM_CAPACITY;  // Возможное переполнение
+        if (x->words[x->len - 1] == 0) x->words[x->len - 1] = 1;
+        p->b[i] = next_rand(s) % 8 == 0 ? next_rand(s) % 3 : next_rand(s);
+        memset(&p->res[i], 0xA5, sizeof(p->res[i]));
+        p->st[i] = (bignum_mul_u64_status_t)0x5A;
+        memset(&p->expected[i], 0xA5, sizeof(p->expected[i]));
+        p->expected_st[i] = bignum_mul_u64(&p->expected[i], x, p->b[i]);
+        if (p->expected_batch == BIGNUM_MUL_U64_SUCCESS) p->expected_batch = p->expected_st[i];
+    }
+    atomic_store(&p->cb_calls, 0);
+}
+
+static int burst_check(const pool_burst_t *p, bignum_mul_u64_status_t got) {
+    if (got != p->expected_batch) return 0;
+    for (size_t i = 0; i < p->n; ++i) {
+        if (p->st[i] != p->expected_st[i]) return 0;
+        if (memcmp(&p->res[i], &p->expected[i], sizeof(bignum_t)) != 0) return 0;
+    }
+    return 1;
+}
+
+static void *pool_submitter(void *arg) {
+    pool_submitter_t *t = arg;
+    uint64_t s = t->seed;
+    for (int round = 0; round < POOL_ROUNDS && t->ok; ++round) {
+        // Способ ожидания: 0 — wait, 1 — опрос, 2 — только обратный вызов
+        int mode[POOL_INFLIGHT];
+        for (int j = 0; j < POOL_INFLIGHT; ++j) {
+            pool_burst_t *p = &t->burst[j];
+            burst_fill(p, burst_size(&s), &s);
+            mode[j] = (int)(next_rand(&s) % 3);
+            bignum_mul_u64_status_t st = bignum_mul_u64_submit(t->pool, p->res, p->a, p->b, p->n, p->st, pool_done,
+                                                               p, mode[j] == 2 ? NULL : &p->job);
+            if (st != BIGNUM_MUL_U64_SUCCESS) {
+                t->ok = 0;
+                return NULL;
+            }
+        }
+        for (int j = POOL_INFLIGHT; j-- > 0;) {
+            pool_burst_t *p = &t->burst[j];
+            bignum_mul_u64_status_t got;
+            if (mode[j] == 2) {
+                while (atomic_load_explicit(&p->cb_calls, memory_order_acquire) == 0) sched_yield();
+                got = p->cb_status;
+            } else {
+                if (mode[j] == 1) {
+                    while (!bignum_mul_u64_poll(p->job)) sched_yield();
+                    if (atomic_load(&p->cb_calls) != 1) t->ok = 0;
+                }
+                got = bignum_mul_u64_wait(t->pool, p->job);
+            }
+            if (atomic_load(&p->cb_calls) != 1 || p->cb_status != got || !burst_check(p, got)) t->ok = 0;
+        }
+    }
+    return NULL;
+}
+
+static int test_pool_api(void) {
+    bignum_mul_u64_pool_t *pool = bignum_mul_u64_pool_create(2);
+    if (pool == NULL) return 0;
+    bignum_t x;
+    uint64_t b = 3;
+    bignum_mul_u64_job_t *job = (bignum_mul_u64_job_t *)&x;
+    int ok = bignum_mul_u64_submit(NULL, &x, &x, &b, 1, NULL, NULL, NULL, &job) == BIGNUM_MUL_U64_ERROR_NULL_ARG &&
+             job == NULL;
+    ok = ok && bignum_mul_u64_submit(pool, NULL, &x, &b, 1, NULL, NULL, NULL, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG;
+    ok = ok && bignum_mul_u64_wait(pool, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG;
+
+    // Пустой пакет завершается сразу, обратный вызов — в этом потоке
+    pool_burst_t p;
+    atomic_init(&p.cb_calls, 0);
+    p.cb_status = BIGNUM_MUL_U64_ERROR_OVERFLOW;
+    ok = ok && bignum_mul_u64_submit(pool, NULL, NULL, NULL, 0, NULL, pool_done, &p, &job) == BIGNUM_MUL_U64_SUCCESS;
+    ok = ok && bignum_mul_u64_poll(job) && atomic_load(&p.cb_calls) == 1 && p.cb_status == BIGNUM_MUL_U64_SUCCESS;
+    ok = ok && bignum_mul_u64_wait(pool, job) == BIGNUM_MUL_U64_SUCCESS;
+
+    // Отложенные пакеты без дескриптора дожидается pool_destroy
+    memset(&x, 0, sizeof(x));
+    x.len = 1;
+    x.words[0] = 7;
+    ok = ok && bignum_mul_u64_submit(pool, &x, &x, &b, 1, NULL, NULL, NULL, NULL) == BIGNUM_MUL_U64_SUCCESS;
+    bignum_mul_u64_pool_destroy(pool);
+    bignum_mul_u64_pool_destroy(NULL);
+    return ok && x.len == 1 && x.words[0] == 21;
+}
+
+static int test_pool_stress(unsigned workers) {
+    bignum_mul_u64_pool_t *pool = bignum_mul_u64_pool_create(workers);
+    if (pool == NULL) {
+        fprintf(stderr, "bignum_mul_u64_pool_create(%u) failed\n", workers);
+        return 0;
+    }
+    static pool_submitter_t sub[POOL_SUBMITTERS];
+    pthread_t tid[POOL_SUBMITTERS];
+    int ok = 1;
+    for (int i = 0; i < POOL_SUBMITTERS; ++i) {
+        sub[i].pool = pool;
+        sub[i].seed = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1) + workers;
+        sub[i].ok = 1;
+        for (int j = 0; j < POOL_INFLIGHT; ++j) {
+            pool_burst_t *p = &sub[i].burst[j];
+            p->a = malloc(POOL_MAX_BATCH * sizeof(bignum_t));
+            p->res = malloc(POOL_MAX_BATCH * sizeof(bignum_t));
+            p->expected = malloc(POOL_MAX_BATCH * sizeof(bignum_t));
+            p->b = malloc(POOL_MAX_BATCH * sizeof(uint64_t));
+            p->st = malloc(POOL_MAX_BATCH * sizeof(bignum_mul_u64_status_t));
+            p->expected_st = malloc(POOL_MAX_BATCH * sizeof(bignum_mul_u64_status_t));
+            atomic_init(&p->cb_calls, 0);
+            if (!p->a || !p->res || !p->expected || !p->b || !p->st || !p->expected_st) {
+                perror("malloc");
+                return 0;
+            }
+        }
+    }
+    for (int i = 0; i < POOL_SUBMITTERS; ++i) {
+        if (pthread_create(&tid[i], NULL, pool_submitter, &sub[i]) != 0) {
+            perror("pthread_create");
+            return 0;
+        }
+    }
+    for (int i = 0; i < POOL_SUBMITTERS; ++i) {
+        pthread_join(tid[i], NULL);
+        if (!sub[i].ok) {
+            printf("Pool submitter %d failed (%u workers)!\n", i, workers);
+            ok = 0;
+        }
+        for (int j = 0; j < POOL_INFLIGHT; ++j) {
+            pool_burst_t *p = &sub[i].burst[j];
+            free(p->a);
+            free(p->res);
+            free(p->expected);
+            free(p->b);
+            free(p->st);
+            free(p->expected_st);
+        }
+    }
+    bignum_mul_u64_pool_destroy(pool);
+    return ok;
+}
+
 int main(void) {
     printf("\n--- Starting MT test for bignum_mul_u64 ---\n");
     pthread_t threads[NUM_THREADS];
@@ -109,6 +317,12 @@ int main(void) {
         }
     }
 
+    if (!test_pool_api()) {
+        printf("Pool API checks failed!\n");
+        all_ok = 0;
+    }
+    if (!test_pool_stress(1) || !test_pool_stress(4)) all_ok = 0;
+
     if (!all_ok) {
         fprintf(stderr, "--- MT test for bignum_mul_u64 FAILED ---\n");
         return 1;
@@ -0,0 +1,189 @@
+/**
+ * @file    test_bignum_mul_u64_mul_add.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_add_u64 и bignum_mul_sub_u64.
+ *
+ * @details
+ *   Сравнивает результат с эталоном на `unsigned __int128` для всех пар
+ *   длин `res->len`/`a->len`, проверяет умножение "на месте", переполнение,
+ *   отрицательный результат вычитания, нормализацию длины и NULL-аргументы.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+static uint64_t rng_state = 0xD1B54A32D192ED03ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static int bignum_are_equal(const bignum_t* x, const bignum_t* y) {
+    if (x->len != y->len) return 0;
+    return memcmp(x->words, y->words, x->len * sizeof(uint64_t)) == 0;
+}
+
+/** Нормализованное случайное число длины len (старшее слово != 0). */
+static void fill_random(bignum_t *x, size_t len) {
+    memset(x, 0xA5, sizeof(*x)); /* мусор выше len */
+    for (size_t i = 0; i < len; ++i) x->words[i] = next_rand();
+    if (len) x->words[len - 1] |= 1;
+    x->len = len;
+}
+
+/** Эталон: res +/-= a * b. Возвращает 0 (успех), -2 или -3. */
+static int ref_mul_acc(bignum_t *res, const bignum_t *a, uint64_t b, int sub) {
+    uint64_t t[BIGNUM_CAPACITY + 2] = {0};
+    uint64_t r[BIGNUM_CAPACITY + 2] = {0};
+    size_t al = a->len, rl = res->len;
+    memcpy(r, res->words, rl * sizeof(uint64_t));
+    uint64_t carry = 0;
+    for (size_t i = 0; i < al; ++i) {
+        u128_t p = (u128_t)a->words[i] * b + carry;
+        t[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    t[al] = carry;
+    size_t n = BIGNUM_CAPACITY + 1;
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (sub) {
+            u128_t d = (u128_t)r[i] - t[i] - c;
+            r[i] = (uint64_t)d;
+            c = (uint64_t)(d >> 64) ? 1 : 0;
+        } else {
+            u128_t s = (u128_t)r[i] + t[i] + c;
+            r[i] = (uint64_t)s;
+            c = (uint64_t)(s >> 64);
+        }
+    }
+    if (sub && c) return -3;
+    size_t len = n;
+    while (len > 1 && r[len - 1] == 0) --len;
+    if (len > BIGNUM_CAPACITY) return -2;
+    memcpy(res->words, r, len * sizeof(uint64_t));
+    res->len = len;
+    return 0;
+}
+
+/**
+ * @brief Тест 1: Все пары длин, набор множителей.
+ */
+static void test_against_reference(int sub) {
+    printf("Running test: test_against_reference(%s)\n", sub ? "sub" : "add");
+    const uint64_t multipliers[] = {0, 1, 3, 0xFFFFFFFFULL, UINT64_MAX, 0x9E3779B97F4A7C15ULL};
+    for (size_t al = 0; al <= BIGNUM_CAPACITY; ++al) {
+        for (size_t rl = 1; rl <= BIGNUM_CAPACITY; ++rl) {
+            for (size_t m = 0; m < sizeof(multipliers) / sizeof(multipliers[0]); ++m) {
+                bignum_t a, res, expected;
+                fill_random(&a, al);
+                fill_random(&res, rl);
+                expected = res;
+                int st_ref = ref_mul_acc(&expected, &a, multipliers[m], sub);
+                bignum_mul_u64_status_t st = sub ? bignum_mul_sub_u64(&res, &a, multipliers[m])
+                                                 : bignum_mul_add_u64(&res, &a, multipliers[m]);
+                assert((int)st == st_ref);
+                if (st == BIGNUM_MUL_U64_SUCCESS) {
+                    assert(bignum_are_equal(&res, &expected));
+                }
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Умножение "на месте": x += x * b и x -= x * 1.
+ */
+static void test_in_place(void) {
+    printf("Running test: test_in_place\n");
+    bignum_t x, expected;
+    fill_random(&x, 7);
+    expected = x;
+    assert(bignum_mul_u64(&expected, &x, 11) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_add_u64(&x, &x, 10) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_are_equal(&x, &expected));
+
+    assert(bignum_mul_sub_u64(&x, &x, 1) == BIGNUM_MUL_U64_SUCCESS);
+    assert(x.len == 1 && x.words[0] == 0);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Переполнение, отрицательный результат, нулевые длины, NULL.
+ */
+static void test_edge_cases(void) {
+    printf("Running test: test_edge_cases\n");
+    bignum_t a, res;
+
+    /* Переполнение: (2^64-1) * 2^(64*31) * 2 + 0 */
+    memset(&a, 0, sizeof(a));
+    a.len = BIGNUM_CAPACITY;
+    a.words[BIGNUM_CAPACITY - 1] = UINT64_MAX;
+    memset(&res, 0, sizeof(res));
+    res.len = 1;
+    assert(bignum_mul_add_u64(&res, &a, 2) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+
+    /* Перенос распространяется по всему res */
+    memset(&a, 0, sizeof(a));
+    a.len = 1;
+    a.words[0] = 1;
+    memset(&res, 0, sizeof(res));
+    res.len = 3;
+    res.words[0] = res.words[1] = res.words[2] = UINT64_MAX;
+    assert(bignum_mul_add_u64(&res, &a, 1) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 4 && res.words[0] == 0 && res.words[2] == 0 && res.words[3] == 1);
+    /* ...и заем — обратно */
+    assert(bignum_mul_sub_u64(&res, &a, 1) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 3 && res.words[0] == UINT64_MAX && res.words[2] == UINT64_MAX);
+
+    /* Отрицательный результат */
+    res.len = 1;
+    res.words[0] = 5;
+    a.words[0] = 3;
+    assert(bignum_mul_sub_u64(&res, &a, 2) == BIGNUM_MUL_U64_ERROR_UNDERFLOW);
+
+    /* res->len == 0 трактуется как 0 */
+    memset(&res, 0xFF, sizeof(res));
+    res.len = 0;
+    a.words[0] = 6;
+    assert(bignum_mul_add_u64(&res, &a, 7) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 42);
+    res.len = 0;
+    assert(bignum_mul_add_u64(&res, &a, 0) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+
+    /* Некорректная длина и NULL */
+    a.len = BIGNUM_CAPACITY + 1;
+    assert(bignum_mul_add_u64(&res, &a, 7) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(bignum_mul_sub_u64(&res, &a, 7) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(bignum_mul_add_u64(NULL, &a, 7) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_add_u64(&res, NULL, 7) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_sub_u64(NULL, &a, 7) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_sub_u64(&res, NULL, 7) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting mul-add tests for bignum_mul_u64 ---\n");
+    test_against_reference(0);
+    test_against_reference(1);
+    test_in_place();
+    test_edge_cases();
+    printf("\n--- All mul-add tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
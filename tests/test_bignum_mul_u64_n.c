@@ -0,0 +1,221 @@
+/**
+ * @file    test_bignum_mul_u64_n.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты умножения массивов слов bignum_mul_u64_n.
+ *
+ * @details
+ *   Сравнивает bignum_mul_u64_n, bignum_mul_u64_n_nt и ядра
+ *   bignum_mul_u64_n_generic / _mulx с эталоном на `unsigned __int128`:
+ *   все длины 0..200 (все остатки развертки), длины больше
+ *   BIGNUM_CAPACITY вплоть до 100 000 слов, умножение "на месте", а также
+ *   совпадение с bignum_mul_u64 при n <= BIGNUM_CAPACITY. Проверяется, что
+ *   слова за пределами dst[0..n-1] не трогаются.
+ *   bignum_mul_u64_n_parallel сравнивается с bignum_mul_u64_n при разном
+ *   числе потоков, в том числе на данных, где перенос проходит через
+ *   границы кусков на сотни слов. Так же проверяется
+ *   bignum_mul_u64_n_parallel_pool на пулах из 1, 2, 4 и 7 рабочих и без
+ *   пула.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Тесты bignum_mul_u64_n_parallel.
+ *   - rev. 3 (14.10.2026): Ядра `mulx` проверяются только на x86-64.
+ *   - rev. 4 (14.10.2026): Тесты bignum_mul_u64_n_parallel_pool.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+typedef uint64_t (*mul_n_fn_t)(uint64_t *, const uint64_t *, size_t, uint64_t);
+
+#define GUARD 0xA5A5A5A5A5A5A5A5ULL
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static uint64_t ref_mul_n(uint64_t *dst, const uint64_t *src, size_t n, uint64_t b) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128_t p = (u128_t)src[i] * b + carry;
+        dst[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    return carry;
+}
+
+/**
+ * @brief Прогоняет функцию на длине n: отдельный dst (с охранными словами) и "на месте".
+ */
+static void check_length(mul_n_fn_t fn, size_t n, uint64_t b) {
+    uint64_t *src = malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *expected = malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *dst = malloc((n + 2) * sizeof(uint64_t));
+    assert(src && expected && dst);
+    for (size_t i = 0; i < n; ++i) src[i] = next_rand();
+    uint64_t carry_ref = ref_mul_n(expected, src, n, b);
+
+    dst[0] = GUARD;
+    dst[n + 1] = GUARD;
+    assert(fn(dst + 1, src, n, b) == carry_ref);
+    assert(dst[0] == GUARD && dst[n + 1] == GUARD);
+    assert(memcmp(dst + 1, expected, n * sizeof(uint64_t)) == 0);
+
+    assert(fn(src, src, n, b) == carry_ref);
+    assert(memcmp(src, expected, n * sizeof(uint64_t)) == 0);
+
+    free(src);
+    free(expected);
+    free(dst);
+}
+
+static void check_fn(const char *name, mul_n_fn_t fn) {
+    printf("Running test: check_fn(%s)\n", name);
+    const uint64_t multipliers[] = {0, 1, 2, 10, 1ULL << 63, UINT64_MAX, 0x123456789ABCDEF1ULL};
+    for (size_t m = 0; m < sizeof(multipliers) / sizeof(multipliers[0]); ++m) {
+        for (size_t n = 0; n <= 200; ++n) check_length(fn, n, multipliers[m]);
+    }
+    check_length(fn, 100000, 0xFEDCBA9876543211ULL);
+    check_length(fn, 100003, UINT64_MAX);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест: bignum_mul_u64 и bignum_mul_u64_n совпадают по словам и переносу.
+ */
+static void test_matches_bignum(void) {
+    printf("Running test: test_matches_bignum\n");
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        bignum_t a, res;
+        uint64_t words[BIGNUM_CAPACITY];
+        memset(&a, 0, sizeof(a));
+        memset(&res, 0, sizeof(res));           /* ядро пишет len двойным словом */
+        for (size_t i = 0; i < len; ++i) a.words[i] = next_rand() | 1;
+        a.words[len - 1] |= 1ULL << 63;
+        a.len = len;
+        uint64_t b = next_rand() | 2;
+        uint64_t carry = bignum_mul_u64_n(words, a.words, len, b);
+
+        bignum_mul_u64_status_t st = bignum_mul_u64(&res, &a, b);
+        if (len == BIGNUM_CAPACITY && carry != 0) {
+            assert(st == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+            continue;
+        }
+        assert(st == BIGNUM_MUL_U64_SUCCESS);
+        assert(res.len == len + (carry != 0));
+        assert(memcmp(res.words, words, len * sizeof(uint64_t)) == 0);
+        if (carry) assert(res.words[len] == carry);
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Сравнивает bignum_mul_u64_n_parallel (при pool != NULL —
+ *        bignum_mul_u64_n_parallel_pool) с bignum_mul_u64_n на n словах.
+ * @param ripple Данные 0x5555... * 3 с редкими словами UINT64_MAX: перенос
+ *               идет волной от каждого такого слова до следующего.
+ */
+static void check_parallel(size_t n, unsigned threads, bignum_mul_u64_pool_t *pool, int ripple) {
+    uint64_t *src = malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *expected = malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *dst = malloc((n + 2) * sizeof(uint64_t));
+    assert(src && expected && dst);
+    uint64_t b = ripple ? 3 : next_rand();
+    for (size_t i = 0; i < n; ++i) {
+        src[i] = ripple ? (i % 1000 == 7 ? UINT64_MAX : 0x5555555555555555ULL) : next_rand();
+    }
+    uint64_t carry_ref = bignum_mul_u64_n(expected, src, n, b);
+
+    dst[0] = GUARD;
+    dst[n + 1] = GUARD;
+    uint64_t carry = pool != NULL ? bignum_mul_u64_n_parallel_pool(pool, dst + 1, src, n, b)
+                                  : bignum_mul_u64_n_parallel(dst + 1, src, n, b, threads);
+    assert(carry == carry_ref);
+    assert(dst[0] == GUARD && dst[n + 1] == GUARD);
+    assert(memcmp(dst + 1, expected, n * sizeof(uint64_t)) == 0);
+
+    carry = pool != NULL ? bignum_mul_u64_n_parallel_pool(pool, src, src, n, b)
+                         : bignum_mul_u64_n_parallel(src, src, n, b, threads);
+    assert(carry == carry_ref);
+    assert(memcmp(src, expected, n * sizeof(uint64_t)) == 0);
+
+    free(src);
+    free(expected);
+    free(dst);
+}
+
+/**
+ * @brief Тест: bignum_mul_u64_n_parallel совпадает с последовательной версией.
+ */
+static void test_parallel(void) {
+    printf("Running test: test_parallel\n");
+    const size_t lengths[] = {0, 1, 1000, 65536 * 2 - 1, 65536 * 5 + 3, 1 << 20};
+    const unsigned threads[] = {0, 1, 2, 3, 4, 7, 8, 300};
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l) {
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+            check_parallel(lengths[l], threads[t], NULL, 0);
+            check_parallel(lengths[l], threads[t], NULL, 1);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест: bignum_mul_u64_n_parallel_pool совпадает с последовательной
+ *        версией, в том числе без пула.
+ */
+static void test_parallel_pool(void) {
+    printf("Running test: test_parallel_pool\n");
+    const size_t lengths[] = {0, 1, 1000, 16384 * 2 - 1, 16384 * 7 + 5, 1 << 20};
+    const unsigned workers[] = {1, 2, 4, 7};
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); ++w) {
+        bignum_mul_u64_pool_t *pool = bignum_mul_u64_pool_create(workers[w]);
+        assert(pool != NULL);
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l) {
+            check_parallel(lengths[l], 0, pool, 0);
+            check_parallel(lengths[l], 0, pool, 1);
+        }
+        bignum_mul_u64_pool_destroy(pool);
+    }
+    uint64_t src[3] = {1, 2, UINT64_MAX}, dst[3];
+    assert(bignum_mul_u64_n_parallel_pool(NULL, dst, src, 3, 2) == 1);
+    assert(dst[0] == 2 && dst[1] == 4 && dst[2] == UINT64_MAX - 1);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting span tests for bignum_mul_u64_n ---\n");
+    check_fn("bignum_mul_u64_n", bignum_mul_u64_n);
+    check_fn("bignum_mul_u64_n_nt", bignum_mul_u64_n_nt);
+    check_fn("bignum_mul_u64_n_generic", bignum_mul_u64_n_generic);
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        check_fn("bignum_mul_u64_n_mulx", bignum_mul_u64_n_mulx);
+    } else {
+        printf("Skipping bignum_mul_u64_n_mulx: BMI2/ADX not supported\n");
+    }
+#else
+    printf("Skipping bignum_mul_u64_n_mulx: x86-64 only\n");
+#endif
+    test_matches_bignum();
+    test_parallel();
+    test_parallel_pool();
+    printf("\n--- All span tests for bignum_mul_u64_n passed ---\n");
+    return 0;
+}
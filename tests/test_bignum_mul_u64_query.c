@@ -0,0 +1,157 @@
+/**
+ * @file    test_bignum_mul_u64_query.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_u64_carry и bignum_mul_u64_fits.
+ *
+ * @details
+ *   Сравнивает ответы с фактическим результатом bignum_mul_u64 на всех
+ *   длинах, на множителях и старших словах у границ степеней двойки
+ *   (сумма битовых длин 64, 65, 66) и на данных, где ответ решает перенос
+ *   из младших слов: 0x5555... * 3 ровно помещается, а при +1 в младшем
+ *   слове уже нет.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+static uint64_t rng_state = 0x9FB21C651E98DF25ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static size_t significant_len(const bignum_t *a) {
+    size_t len = a->len;
+    while (len > 0 && a->words[len - 1] == 0) --len;
+    return len;
+}
+
+static uint64_t ref_carry(const bignum_t *a, uint64_t b) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < significant_len(a); ++i) {
+        u128_t p = (u128_t)a->words[i] * b + carry;
+        carry = (uint64_t)(p >> 64);
+    }
+    return carry;
+}
+
+/**
+ * @brief Сверяет оба запроса с bignum_mul_u64 и эталонным переносом.
+ */
+static void check_case(const bignum_t *a, uint64_t b) {
+    bignum_t res;
+    memset(&res, 0, sizeof(res));
+    bignum_mul_u64_status_t st = bignum_mul_u64(&res, a, b);
+    uint64_t carry = ref_carry(a, b);
+
+    assert(bignum_mul_u64_carry(a, b) == carry);
+    assert(!bignum_mul_u64_fits(a, b) == (st != BIGNUM_MUL_U64_SUCCESS));
+    if (st == BIGNUM_MUL_U64_SUCCESS && carry != 0) {
+        size_t len = significant_len(a);
+        assert(res.len == len + 1 && res.words[len] == carry);
+    }
+}
+
+static void make_number(bignum_t *a, size_t len, uint64_t top) {
+    memset(a, 0, sizeof(*a));
+    for (size_t i = 0; i + 1 < len; ++i) a->words[i] = next_rand();
+    if (len > 0) a->words[len - 1] = top;
+    a->len = len;
+}
+
+/**
+ * @brief Тест 1: Все длины, случайные и граничные множители и старшие слова.
+ */
+static void test_matches_product(void) {
+    printf("Running test: test_matches_product\n");
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (int k = 0; k < 64; ++k) {
+            uint64_t p2 = 1ULL << k;
+            const uint64_t tops[] = {p2, p2 - 1, p2 | 1, next_rand() >> (63 - k), UINT64_MAX};
+            const uint64_t bs[] = {0, 1, 2, 1ULL << (63 - k), (1ULL << (63 - k)) + 1,
+                                   UINT64_MAX >> k, next_rand(), UINT64_MAX};
+            for (size_t t = 0; t < sizeof(tops) / sizeof(tops[0]); ++t) {
+                for (size_t m = 0; m < sizeof(bs) / sizeof(bs[0]); ++m) {
+                    bignum_t a;
+                    make_number(&a, len, tops[t]);
+                    check_case(&a, bs[m]);
+                }
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Ответ решает перенос из младших слов.
+ */
+static void test_carry_from_below(void) {
+    printf("Running test: test_carry_from_below\n");
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        bignum_t a;
+        memset(&a, 0, sizeof(a));
+        for (size_t i = 0; i < len; ++i) a.words[i] = 0x5555555555555555ULL;
+        a.len = len;
+        assert(bignum_mul_u64_carry(&a, 3) == 0);
+        assert(bignum_mul_u64_fits(&a, 3));
+        check_case(&a, 3);
+
+        a.words[0] += 1;
+        assert(bignum_mul_u64_carry(&a, 3) == 1);
+        assert(bignum_mul_u64_fits(&a, 3) == (len < BIGNUM_CAPACITY));
+        check_case(&a, 3);
+
+        for (size_t i = 0; i < len; ++i) a.words[i] = UINT64_MAX;
+        check_case(&a, UINT64_MAX);
+        check_case(&a, 2);
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: NULL, некорректная длина и старшие нулевые слова.
+ */
+static void test_edge_cases(void) {
+    printf("Running test: test_edge_cases\n");
+    assert(bignum_mul_u64_carry(NULL, 5) == 0);
+    assert(!bignum_mul_u64_fits(NULL, 5));
+
+    bignum_t a;
+    make_number(&a, 1, 7);
+    a.len = BIGNUM_CAPACITY + 1;
+    assert(bignum_mul_u64_carry(&a, 5) == 0);
+    assert(!bignum_mul_u64_fits(&a, 5));
+    a.len = (size_t)-1;
+    assert(!bignum_mul_u64_fits(&a, 5));
+
+    // Длина CAPACITY с нулевым старшим словом: bignum_mul_u64 сокращает ее
+    make_number(&a, BIGNUM_CAPACITY, 0);
+    a.words[BIGNUM_CAPACITY - 2] = UINT64_MAX;
+    assert(bignum_mul_u64_fits(&a, UINT64_MAX));
+    assert(bignum_mul_u64_carry(&a, UINT64_MAX) == UINT64_MAX - 1);
+    check_case(&a, UINT64_MAX);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting query tests for bignum_mul_u64 ---\n");
+    test_matches_product();
+    test_carry_from_below();
+    test_edge_cases();
+    printf("\n--- All query tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
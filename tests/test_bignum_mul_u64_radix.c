@@ -0,0 +1,239 @@
+/**
+ * @file    test_bignum_mul_u64_radix.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_from_decimal и bignum_from_radix.
+ *
+ * @details
+ *   Эталон — обратное преобразование: случайное число печатается делением
+ *   на основание по одной цифре и разбирается обратно, на всех длинах и
+ *   основаниях 2..36, в разном регистре и с ведущими нулями. Отдельно —
+ *   известные значения у границ слова, недопустимый символ в каждой
+ *   позиции строки (неполная первая группа, параллельная часть группы и ее
+ *   хвост), переполнение ровно на границе емкости и неизменность `res`
+ *   при ошибке.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+// Самая длинная строка: двоичная запись числа на всю емкость плюс нули
+#define MAX_DIGITS (64 * BIGNUM_CAPACITY + 64)
+
+static uint64_t rng_state = 0x2B7E151628AED2A6ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/** Запись words[0..len) в основании radix без ведущих нулей; возвращает длину. */
+static size_t to_radix(const uint64_t *words, size_t len, unsigned radix, int upper, char *out) {
+    static const char lower_digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    static const char upper_digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    uint64_t w[BIGNUM_CAPACITY];
+    char rev[MAX_DIGITS];
+    size_t n = 0;
+    memcpy(w, words, len * sizeof(uint64_t));
+    while (len > 0 && w[len - 1] == 0) --len;
+    do {
+        uint64_t rem = 0;
+        for (size_t i = len; i-- > 0;) {
+            u128_t cur = ((u128_t)rem << 64) | w[i];
+            w[i] = (uint64_t)(cur / radix);
+            rem = (uint64_t)(cur % radix);
+        }
+        while (len > 0 && w[len - 1] == 0) --len;
+        rev[n++] = (upper ? upper_digits : lower_digits)[rem];
+    } while (len > 0);
+    for (size_t i = 0; i < n; ++i) out[i] = rev[n - 1 - i];
+    return n;
+}
+
+static void check_equal(const bignum_t *res, const uint64_t *words, size_t len) {
+    while (len > 1 && words[len - 1] == 0) --len;
+    assert(res->len == (len == 0 ? 1 : len));
+    for (size_t i = 0; i < res->len; ++i) assert(res->words[i] == (len == 0 ? 0 : words[i]));
+}
+
+static bignum_mul_u64_status_t parse(bignum_t *res, const char *s, size_t n, unsigned radix) {
+    bignum_mul_u64_status_t st = bignum_from_radix(res, s, n, radix);
+    if (radix == 10) {
+        bignum_t dec;
+        memset(&dec, 0xA5, sizeof(dec));
+        bignum_mul_u64_status_t st_dec = bignum_from_decimal(&dec, s, n);
+        assert(st_dec == st);
+        if (st == BIGNUM_MUL_U64_SUCCESS) {
+            assert(dec.len == res->len);
+            assert(memcmp(dec.words, res->words, res->len * sizeof(uint64_t)) == 0);
+        }
+    }
+    return st;
+}
+
+/**
+ * @brief Тест 1: Печать и разбор случайных чисел всех длин во всех основаниях.
+ */
+static void test_round_trip(void) {
+    printf("Running test: test_round_trip\n");
+    static char buf[MAX_DIGITS + 64];
+    for (unsigned radix = 2; radix <= 36; ++radix) {
+        for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+            for (int rep = 0; rep < 4; ++rep) {
+                uint64_t w[BIGNUM_CAPACITY];
+                for (size_t i = 0; i < len; ++i) {
+                    w[i] = rep == 3 ? UINT64_MAX : next_rand() >> (rep == 2 ? next_rand() % 64 : 0);
+                }
+                size_t zeros = rep == 1 ? next_rand() % 40 : 0;
+                memset(buf, '0', zeros);
+                size_t n = zeros + to_radix(w, len, radix, rep & 1, buf + zeros);
+
+                bignum_t res;
+                memset(&res, 0xA5, sizeof(res));
+                assert(parse(&res, buf, n, radix) == BIGNUM_MUL_U64_SUCCESS);
+                check_equal(&res, w, len);
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Известные значения у границ слова и нули.
+ */
+static void test_known_values(void) {
+    printf("Running test: test_known_values\n");
+    bignum_t res;
+    const uint64_t zero[1] = {0};
+    const uint64_t max64[1] = {UINT64_MAX};
+    const uint64_t two64[2] = {0, 1};
+    const uint64_t pow19[1] = {10000000000000000000ULL};
+
+    assert(parse(&res, "0", 1, 10) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, zero, 1);
+    assert(parse(&res, "0000000000000000000000000", 25, 10) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, zero, 1);
+    assert(parse(&res, "18446744073709551615", 20, 10) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, max64, 1);
+    assert(parse(&res, "18446744073709551616", 20, 10) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, two64, 2);
+    assert(parse(&res, "10000000000000000000", 20, 10) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, pow19, 1);
+    assert(parse(&res, "9999999999999999999", 19, 10) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 9999999999999999999ULL);
+    assert(parse(&res, "1234567890123456789", 19, 10) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 1234567890123456789ULL);
+    assert(parse(&res, "FfFfFfFfFfFfFfFf", 16, 16) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, max64, 1);
+    assert(parse(&res, "10000000000000000", 17, 16) == BIGNUM_MUL_U64_SUCCESS);
+    check_equal(&res, two64, 2);
+    assert(parse(&res, "zZ", 2, 36) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 1295);
+
+    // Ведущие нули длиннее любой емкости
+    static char buf[MAX_DIGITS + 64];
+    size_t n = sizeof(buf) - 2;
+    memset(buf, '0', n);
+    memcpy(buf + n, "42", 2);
+    assert(parse(&res, buf, n + 2, 10) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 42);
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: NULL, пустая строка, основание и недопустимый символ в каждой позиции.
+ */
+static void test_invalid_input(void) {
+    printf("Running test: test_invalid_input\n");
+    bignum_t res, saved;
+    memset(&res, 0x5A, sizeof(res));
+    saved = res;
+
+    assert(bignum_from_decimal(NULL, "1", 1) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_from_decimal(&res, NULL, 1) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_from_radix(NULL, "1", 1, 16) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_from_decimal(&res, NULL, 0) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    assert(bignum_from_decimal(&res, "", 0) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    const unsigned bad_radix[] = {0, 1, 37, 1000};
+    for (size_t i = 0; i < sizeof(bad_radix) / sizeof(bad_radix[0]); ++i) {
+        assert(bignum_from_radix(&res, "1", 1, bad_radix[i]) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    }
+    assert(bignum_from_radix(&res, "102", 3, 2) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    assert(bignum_from_radix(&res, "fg", 2, 16) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    assert(bignum_from_radix(&res, "z", 1, 35) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    assert(bignum_from_decimal(&res, "a", 1) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+    assert(memcmp(&res, &saved, sizeof(res)) == 0);
+
+    // 45 цифр: первая группа из 7, затем две по 19 (16 параллельно + 3)
+    const char bad_chars[] = {'/', ':', ' ', '-', '+', 'a', '\0', (char)0x80, (char)0xB0, (char)0xFF};
+    char buf[45];
+    for (size_t pos = 0; pos < sizeof(buf); ++pos) {
+        for (size_t c = 0; c < sizeof(bad_chars); ++c) {
+            for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = (char)('0' + (i * 7 + 3) % 10);
+            buf[pos] = bad_chars[c];
+            assert(bignum_from_decimal(&res, buf, sizeof(buf)) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+            assert(bignum_from_radix(&res, buf, sizeof(buf), 10) == BIGNUM_MUL_U64_ERROR_INVALID_DIGIT);
+            assert(memcmp(&res, &saved, sizeof(res)) == 0);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 4: Переполнение ровно на границе емкости.
+ */
+static void test_overflow(void) {
+    printf("Running test: test_overflow\n");
+    static char buf[MAX_DIGITS + 64];
+    uint64_t max[BIGNUM_CAPACITY];
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) max[i] = UINT64_MAX;
+    bignum_t res, saved;
+    memset(&res, 0x5A, sizeof(res));
+    saved = res;
+
+    for (unsigned radix = 2; radix <= 36; ++radix) {
+        // 2^(64 * CAPACITY) - 1 помещается, на единицу больше — нет
+        size_t n = to_radix(max, BIGNUM_CAPACITY, radix, 0, buf);
+        assert(parse(&res, buf, n, radix) == BIGNUM_MUL_U64_SUCCESS);
+        check_equal(&res, max, BIGNUM_CAPACITY);
+
+        memset(&res, 0x5A, sizeof(res));
+        int carry = 1;
+        for (size_t i = n; carry && i-- > 0;) {
+            unsigned d = (unsigned)(buf[i] <= '9' ? buf[i] - '0' : buf[i] - 'a' + 10) + 1;
+            carry = d == radix;
+            if (carry) d = 0;
+            buf[i] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        }
+        if (carry) {
+            // Все цифры были старшими (основание — степень двойки): 1 и n нулей
+            memmove(buf + 1, buf, n++);
+            buf[0] = '1';
+        }
+        assert(parse(&res, buf, n, radix) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(memcmp(&res, &saved, sizeof(res)) == 0);
+    }
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting radix parsing tests for bignum_mul_u64 ---\n");
+    test_round_trip();
+    test_known_values();
+    test_invalid_input();
+    test_overflow();
+    printf("\n--- All radix parsing tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
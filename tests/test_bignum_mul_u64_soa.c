@@ -0,0 +1,272 @@
+/**
+ * @file    test_bignum_mul_u64_soa.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты пакета bignum_batch_t и bignum_mul_u64_batch_soa.
+ *
+ * @details
+ *   Проверяет упаковку и распаковку, совпадение bignum_mul_u64_batch_soa с
+ *   поэлементным bignum_mul_u64 (в том числе цепочкой умножений без
+ *   распаковки и "на месте"), сохранение инварианта пакета (нулевые слова
+ *   выше len и слои выше rows), а также обработку ошибок.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ *   - rev. 2 (14.10.2026): Числа со старшими нулевыми словами.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+static uint64_t rng_state = 0xD1B54A32D192ED03ULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void fill_random(bignum_t *x, size_t len) {
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) x->words[i] = next_rand();
+    x->len = len;
+}
+
+static int bignum_are_equal(const bignum_t* x, const bignum_t* y) {
+    if (x->len != y->len) return 0;
+    return memcmp(x->words, y->words, x->len * sizeof(uint64_t)) == 0;
+}
+
+/** Проверяет инвариант пакета: нули выше len[i] и выше rows. */
+static void check_invariant(const bignum_batch_t *batch) {
+    assert(((uintptr_t)batch->words & 63) == 0);
+    assert(batch->stride % 8 == 0 && batch->stride >= batch->count);
+    assert(batch->rows <= BIGNUM_CAPACITY);
+    for (size_t i = 0; i < batch->count; ++i) {
+        assert(batch->len[i] <= batch->rows);
+        for (size_t k = batch->len[i]; k < BIGNUM_CAPACITY; ++k) {
+            assert(batch->words[k * batch->stride + i] == 0);
+        }
+    }
+}
+
+static size_t random_len(void) {
+    uint64_t r = next_rand() % 8;
+    if (r == 0) return 0;
+    if (r == 1) return BIGNUM_CAPACITY;
+    return (size_t)(next_rand() % (BIGNUM_CAPACITY + 1));
+}
+
+static uint64_t random_multiplier(void) {
+    switch (next_rand() % 6) {
+    case 0: return 0;
+    case 1: return 1;
+    case 2: return UINT64_MAX;
+    default: return next_rand();
+    }
+}
+
+/**
+ * @brief Тест 1: pack/unpack сохраняют числа, лишние числа пакета — нули.
+ */
+static void test_pack_unpack(void) {
+    printf("Running test: test_pack_unpack\n");
+    const size_t counts[] = {1, 7, 8, 9, 100};
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        size_t count = counts[c];
+        bignum_batch_t batch;
+        assert(bignum_batch_init(&batch, count) == BIGNUM_MUL_U64_SUCCESS);
+        check_invariant(&batch);
+
+        bignum_t *src = malloc(count * sizeof(bignum_t));
+        bignum_t *dst = malloc(count * sizeof(bignum_t));
+        assert(src && dst);
+        for (size_t i = 0; i < count; ++i) fill_random(&src[i], random_len());
+
+        assert(bignum_batch_pack(&batch, src, count) == BIGNUM_MUL_U64_SUCCESS);
+        check_invariant(&batch);
+        assert(bignum_batch_unpack(&batch, dst, count) == BIGNUM_MUL_U64_SUCCESS);
+        for (size_t i = 0; i < count; ++i) assert(bignum_are_equal(&src[i], &dst[i]));
+
+        /* Повторная упаковка меньшего набора: остаток пакета обнуляется */
+        size_t half = count / 2;
+        for (size_t i = 0; i < half; ++i) fill_random(&src[i], next_rand() % 3);
+        assert(bignum_batch_pack(&batch, src, half) == BIGNUM_MUL_U64_SUCCESS);
+        check_invariant(&batch);
+        assert(batch.rows <= 2);
+        for (size_t i = half; i < count; ++i) assert(batch.len[i] == 0);
+
+        free(src);
+        free(dst);
+        bignum_batch_free(&batch);
+        assert(batch.words == NULL && batch.count == 0);
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Совпадение с bignum_mul_u64 на цепочке умножений.
+ *
+ * @details Три умножения подряд без распаковки: поочередно в отдельный
+ *          пакет и "на месте". Размеры 1, 5 и 17 оставляют неполную группу ядра.
+ */
+static void test_matches_scalar(void) {
+    printf("Running test: test_matches_scalar\n");
+    const size_t counts[] = {1, 5, 8, 17, 300};
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        size_t count = counts[c];
+        bignum_batch_t x, y;
+        assert(bignum_batch_init(&x, count) == BIGNUM_MUL_U64_SUCCESS);
+        assert(bignum_batch_init(&y, count) == BIGNUM_MUL_U64_SUCCESS);
+
+        bignum_t *expected = malloc(count * sizeof(bignum_t));
+        bignum_t *got = malloc(count * sizeof(bignum_t));
+        uint64_t *b = malloc(count * sizeof(uint64_t));
+        bignum_mul_u64_status_t *status = malloc(count * sizeof(bignum_mul_u64_status_t));
+        assert(expected && got && b && status);
+        for (size_t i = 0; i < count; ++i) {
+            fill_random(&expected[i], random_len());
+            /* Иногда старшие слова нулевые: обе реализации сокращают длину */
+            if (next_rand() % 4 == 0) {
+                for (size_t k = expected[i].len / 2; k < expected[i].len; ++k) expected[i].words[k] = 0;
+            }
+        }
+        assert(bignum_batch_pack(&x, expected, count) == BIGNUM_MUL_U64_SUCCESS);
+
+        for (int round = 0; round < 3; ++round) {
+            bignum_mul_u64_status_t first = BIGNUM_MUL_U64_SUCCESS;
+            int overflowed[300] = {0};
+            for (size_t i = 0; i < count; ++i) {
+                b[i] = random_multiplier();
+                bignum_mul_u64_status_t st = bignum_mul_u64(&expected[i], &expected[i], b[i]);
+                if (st != BIGNUM_MUL_U64_SUCCESS) {
+                    overflowed[i] = 1;
+                    if (first == BIGNUM_MUL_U64_SUCCESS) first = st;
+                }
+            }
+
+            bignum_batch_t *dst = (round % 2 == 0) ? &y : &x;
+            assert(bignum_mul_u64_batch_soa(dst, &x, b, status) == first);
+            check_invariant(dst);
+            assert(bignum_batch_unpack(dst, got, count) == BIGNUM_MUL_U64_SUCCESS);
+            for (size_t i = 0; i < count; ++i) {
+                if (overflowed[i]) {
+                    /* Слова записаны, как в ядре; длина — вся емкость */
+                    assert(status[i] == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+                    assert(got[i].len == BIGNUM_CAPACITY);
+                    assert(memcmp(got[i].words, expected[i].words, sizeof(got[i].words)) == 0);
+                    expected[i].len = BIGNUM_CAPACITY;
+                } else {
+                    assert(status[i] == BIGNUM_MUL_U64_SUCCESS);
+                    assert(bignum_are_equal(&got[i], &expected[i]));
+                }
+            }
+            if (dst == &y) {
+                /* Следующий раунд снова читает x */
+                assert(bignum_batch_pack(&x, got, count) == BIGNUM_MUL_U64_SUCCESS);
+            }
+        }
+
+        free(expected);
+        free(got);
+        free(b);
+        free(status);
+        bignum_batch_free(&x);
+        bignum_batch_free(&y);
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: Короткий результат в пакет, где были длинные числа.
+ */
+static void test_shrinking_rows(void) {
+    printf("Running test: test_shrinking_rows\n");
+    const size_t count = 9;
+    bignum_batch_t a, res;
+    assert(bignum_batch_init(&a, count) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_batch_init(&res, count) == BIGNUM_MUL_U64_SUCCESS);
+
+    bignum_t src[9];
+    uint64_t b[9];
+    for (size_t i = 0; i < count; ++i) {
+        fill_random(&src[i], BIGNUM_CAPACITY);
+        b[i] = 1;
+    }
+    assert(bignum_batch_pack(&res, src, count) == BIGNUM_MUL_U64_SUCCESS);
+    for (size_t i = 0; i < count; ++i) fill_random(&src[i], 1);
+    assert(bignum_batch_pack(&a, src, count) == BIGNUM_MUL_U64_SUCCESS);
+
+    for (size_t i = 0; i < count; ++i) b[i] = UINT64_MAX;
+    assert(bignum_mul_u64_batch_soa(&res, &a, b, NULL) == BIGNUM_MUL_U64_SUCCESS);
+    check_invariant(&res);
+    assert(res.rows <= 2);
+    printf("...PASSED\n");
+    bignum_batch_free(&a);
+    bignum_batch_free(&res);
+}
+
+/**
+ * @brief Тест 4: NULL, несовпадающий count, некорректные длины.
+ */
+static void test_errors(void) {
+    printf("Running test: test_errors\n");
+    bignum_batch_t a, res, other, empty;
+    assert(bignum_batch_init(NULL, 4) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_batch_init(&empty, 0) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64_batch_soa(&empty, &empty, NULL, NULL) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_batch_init(&a, 4) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_batch_init(&res, 4) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_batch_init(&other, 5) == BIGNUM_MUL_U64_SUCCESS);
+
+    uint64_t b[5] = {2, 3, 4, 5, 6};
+    bignum_t src[5];
+    for (size_t i = 0; i < 5; ++i) fill_random(&src[i], 2);
+
+    assert(bignum_batch_pack(NULL, src, 4) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_batch_pack(&a, NULL, 4) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_batch_pack(&a, src, 5) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(bignum_batch_unpack(&a, src, 5) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(bignum_batch_unpack(&a, NULL, 1) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+
+    /* Некорректная длина: пакет не меняется */
+    assert(bignum_batch_pack(&a, src, 4) == BIGNUM_MUL_U64_SUCCESS);
+    src[3].len = BIGNUM_CAPACITY + 1;
+    assert(bignum_batch_pack(&a, src, 4) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    src[3].len = 0xFFFFFFFFu;
+    assert(bignum_batch_pack(&a, src, 4) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(a.len[3] == 2 && a.rows == 2);
+
+    assert(bignum_mul_u64_batch_soa(NULL, &a, b, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch_soa(&res, NULL, b, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch_soa(&res, &a, NULL, NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(bignum_mul_u64_batch_soa(&other, &a, b, NULL) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+
+    /* Нарушенный инвариант: res не меняется */
+    a.len[1] = a.rows + 1;
+    assert(bignum_mul_u64_batch_soa(&res, &a, b, NULL) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(res.rows == 0);
+
+    bignum_batch_free(&a);
+    bignum_batch_free(&res);
+    bignum_batch_free(&other);
+    bignum_batch_free(&empty);
+    bignum_batch_free(NULL);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting SoA batch tests for bignum_mul_u64 ---\n");
+    test_pack_unpack();
+    test_matches_scalar();
+    test_shrinking_rows();
+    test_errors();
+    printf("\n--- All SoA batch tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}
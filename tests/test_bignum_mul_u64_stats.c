@@ -0,0 +1,142 @@
+/**
+ * @file    test_bignum_mul_u64_stats.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты счетчиков bignum_mul_u64 (bignum_mul_u64_stats_snapshot).
+ *
+ * @details
+ *   В сборке CONFIG=stats сверяются приращения счетчиков между снимками:
+ *   длины, классы множителя, умножение на месте, NULL, переполнение и
+ *   некорректная длина, затем вызовы из нескольких потоков, которые к
+ *   моменту снимка уже завершились. В остальных сборках проверяется, что
+ *   снимок пустой и возвращает BIGNUM_MUL_U64_ERROR_DOMAIN.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#ifdef BIGNUM_MUL_U64_STATS
+#include <pthread.h>
+#endif
+
+#ifdef BIGNUM_MUL_U64_STATS
+
+#define THREADS          4
+#define CALLS_PER_THREAD 1000
+
+/** Число длиной len со всеми словами 3. */
+static void make(bignum_t *x, size_t len) {
+    memset(x, 0, sizeof(*x));
+    for (size_t i = 0; i < len; ++i) x->words[i] = 3;
+    x->len = len;
+}
+
+/**
+ * @brief Тест 1: Приращения счетчиков по вызовам одного потока.
+ */
+static void test_counters(void) {
+    printf("Running test: test_counters\n");
+    bignum_mul_u64_stats_t before, after;
+    assert(bignum_mul_u64_stats_snapshot(&before) == BIGNUM_MUL_U64_SUCCESS);
+
+    bignum_t a, res;
+    make(&a, 3);
+    assert(bignum_mul_u64(&res, &a, 0) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64(&res, &a, 1) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64(&res, &a, 1ULL << 40) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64(&res, &a, 10) == BIGNUM_MUL_U64_SUCCESS);
+    assert(bignum_mul_u64(&a, &a, UINT64_MAX) == BIGNUM_MUL_U64_SUCCESS);   // На месте; длина 3 до вызова
+
+    // Полная емкость со старшим словом UINT64_MAX: переполнение
+    make(&a, BIGNUM_CAPACITY);
+    a.words[BIGNUM_CAPACITY - 1] = UINT64_MAX;
+    assert(bignum_mul_u64(&res, &a, 3) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+
+    // Некорректная длина (тоже переполнение) и NULL
+    make(&a, 1);
+    a.len = BIGNUM_CAPACITY + 1;
+    assert(bignum_mul_u64(&res, &a, 3) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(bignum_mul_u64(NULL, &a, 3) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+
+    assert(bignum_mul_u64_stats_snapshot(&after) == BIGNUM_MUL_U64_SUCCESS);
+    assert(after.calls - before.calls == 8);
+    assert(after.len[3] - before.len[3] == (BIGNUM_CAPACITY == 3 ? 6 : 5));
+    assert(after.len[BIGNUM_CAPACITY] - before.len[BIGNUM_CAPACITY] == (BIGNUM_CAPACITY == 3 ? 6 : 1));
+    assert(after.len_invalid - before.len_invalid == 1);
+    assert(after.multiplier[BIGNUM_MUL_U64_STATS_B_ZERO] - before.multiplier[BIGNUM_MUL_U64_STATS_B_ZERO] == 1);
+    assert(after.multiplier[BIGNUM_MUL_U64_STATS_B_ONE] - before.multiplier[BIGNUM_MUL_U64_STATS_B_ONE] == 1);
+    assert(after.multiplier[BIGNUM_MUL_U64_STATS_B_POW2] - before.multiplier[BIGNUM_MUL_U64_STATS_B_POW2] == 1);
+    // 10, 3 и 3; вызов с NULL не классифицируется
+    assert(after.multiplier[BIGNUM_MUL_U64_STATS_B_SMALL] - before.multiplier[BIGNUM_MUL_U64_STATS_B_SMALL] == 3);
+    assert(after.multiplier[BIGNUM_MUL_U64_STATS_B_FULL] - before.multiplier[BIGNUM_MUL_U64_STATS_B_FULL] == 1);
+    assert(after.aliased - before.aliased == 1);
+    assert(after.overflow - before.overflow == 2);
+    assert(after.null_arg - before.null_arg == 1);
+    assert(after.threads >= 1);
+    printf("...PASSED\n");
+}
+
+static void *worker(void *arg) {
+    (void)arg;
+    bignum_t a, res;
+    make(&a, 2);
+    for (int i = 0; i < CALLS_PER_THREAD; ++i) assert(bignum_mul_u64(&res, &a, 7) == BIGNUM_MUL_U64_SUCCESS);
+    return NULL;
+}
+
+/**
+ * @brief Тест 2: Счетчики завершившихся потоков остаются в итоге.
+ */
+static void test_threads(void) {
+    printf("Running test: test_threads\n");
+    bignum_mul_u64_stats_t before, after;
+    assert(bignum_mul_u64_stats_snapshot(&before) == BIGNUM_MUL_U64_SUCCESS);
+
+    pthread_t t[THREADS];
+    for (int i = 0; i < THREADS; ++i) assert(pthread_create(&t[i], NULL, worker, NULL) == 0);
+    for (int i = 0; i < THREADS; ++i) assert(pthread_join(t[i], NULL) == 0);
+
+    assert(bignum_mul_u64_stats_snapshot(&after) == BIGNUM_MUL_U64_SUCCESS);
+    assert(after.calls - before.calls == THREADS * CALLS_PER_THREAD);
+    assert(after.len[2] - before.len[2] == THREADS * CALLS_PER_THREAD);
+    assert(after.threads - before.threads == THREADS);
+    assert(bignum_mul_u64_stats_snapshot(NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    printf("...PASSED\n");
+}
+
+#else
+
+/**
+ * @brief Тест 1: Без счетчиков в сборке снимок пустой.
+ */
+static void test_disabled(void) {
+    printf("Running test: test_disabled\n");
+    bignum_mul_u64_stats_t st;
+    memset(&st, 0x5A, sizeof(st));
+    assert(bignum_mul_u64_stats_snapshot(&st) == BIGNUM_MUL_U64_ERROR_DOMAIN);
+    const unsigned char *p = (const unsigned char *)&st;
+    for (size_t i = 0; i < sizeof(st); ++i) assert(p[i] == 0);
+    assert(bignum_mul_u64_stats_snapshot(NULL) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    printf("...PASSED\n");
+}
+
+#endif
+
+int main(void) {
+    printf("\n--- Starting tests for bignum_mul_u64_stats ---\n");
+#ifdef BIGNUM_MUL_U64_STATS
+    test_counters();
+    test_threads();
+#else
+    test_disabled();
+#endif
+    printf("\n--- All tests for bignum_mul_u64_stats passed ---\n");
+    return 0;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file    test_bignum_mul_u64_u128.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_u128 и ее ядер.
+ *
+ * @details
+ *   Эталон — произведение на `unsigned __int128` в массиве на два слова
+ *   шире емкости, так что видна точная граница переполнения. Для
+ *   диспетчера `bignum_mul_u128`, ядра `_generic` и (на процессорах с BMI2
+ *   и ADX) ядра `_mulx` перебираются все длины, четные и нечетные, случайные
+ *   и крайние слова (0, 1, UINT64_MAX), b_hi == 0, b_lo == 0, умножение "на
+ *   месте", ненормализованные операнды и произведения у границы емкости.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+__extension__ typedef unsigned __int128 u128_t;
+
+typedef bignum_mul_u64_status_t (*mul128_fn_t)(bignum_t *, const bignum_t *, uint64_t, uint64_t);
+
+#define WIDE (BIGNUM_CAPACITY + 2)
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/** Случайное слово со смещением к крайним значениям. */
+static uint64_t edge_word(void) {
+    switch (next_rand() % 6) {
+    case 0: return 0;
+    case 1: return 1;
+    case 2: return UINT64_MAX;
+    case 3: return UINT64_MAX - 1;
+    default: return next_rand();
+    }
+}
+
+/** Эталон: w[0..WIDE) = a * (b_hi:b_lo); возвращает значащую длину. */
+static size_t reference(const bignum_t *a, uint64_t b_lo, uint64_t b_hi, uint64_t *w) {
+    memset(w, 0, WIDE * sizeof(uint64_t));
+    const uint64_t b[2] = {b_lo, b_hi};
+    for (size_t j = 0; j < 2; ++j) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < a->len; ++i) {
+            u128_t p = (u128_t)a->words[i] * b[j] + w[i + j] + carry;
+            w[i + j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        for (size_t i = a->len + j; carry != 0; ++i) {
+            u128_t s = (u128_t)w[i] + carry;
+            w[i] = (uint64_t)s;
+            carry = (uint64_t)(s >> 64);
+        }
+    }
+    size_t len = WIDE;
+    while (len > 0 && w[len - 1] == 0) --len;
+    return len;
+}
+
+/** Заполняет слова res мусором; ядро пишет только младшие 32 бита длины. */
+static void poison(bignum_t *res) {
+    memset(res, 0, sizeof(*res));
+    memset(res->words, 0x5A, sizeof(res->words));
+    res->len = 7;
+}
+
+/** Проверяет fn против эталона, в том числе на месте. */
+static void check_one(mul128_fn_t fn, const bignum_t *a, uint64_t b_lo, uint64_t b_hi) {
+    uint64_t w[WIDE];
+    size_t len = reference(a, b_lo, b_hi, w);
+
+    bignum_t res;
+    poison(&res);
+    bignum_mul_u64_status_t st = fn(&res, a, b_lo, b_hi);
+    if (len > BIGNUM_CAPACITY) {
+        assert(st == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(res.len == 7);
+    } else {
+        assert(st == BIGNUM_MUL_U64_SUCCESS);
+        assert(res.len == (len == 0 ? 1 : len));
+        for (size_t i = 0; i < res.len; ++i) assert(res.words[i] == w[i]);
+    }
+
+    bignum_t x;
+    memset(&x, 0, sizeof(x));
+    memcpy(x.words, a->words, sizeof(x.words));
+    x.len = a->len;
+    st = fn(&x, &x, b_lo, b_hi);
+    if (len > BIGNUM_CAPACITY) {
+        assert(st == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+        assert(x.len == a->len);
+    } else {
+        assert(st == BIGNUM_MUL_U64_SUCCESS);
+        assert(x.len == res.len && memcmp(x.words, res.words, res.len * sizeof(uint64_t)) == 0);
+    }
+}
+
+/**
+ * @brief Тест 1: Все длины, случайные и крайние слова и множители.
+ */
+static void test_random(const char *name, mul128_fn_t fn) {
+    printf("Running test: test_random (%s)\n", name);
+    bignum_t a;
+    memset(&a, 0, sizeof(a));
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (int rep = 0; rep < 400; ++rep) {
+            for (size_t i = 0; i < len; ++i) a.words[i] = rep % 2 ? edge_word() : next_rand();
+            a.len = len;
+            uint64_t b_lo = rep % 3 ? next_rand() : edge_word();
+            uint64_t b_hi = rep % 5 == 0 ? 0 : (rep % 3 ? next_rand() : edge_word());
+            if (rep % 13 == 0) b_hi >>= next_rand() % 64;
+            check_one(fn, &a, b_lo, b_hi);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: Произведения у границы емкости и ненормализованные операнды.
+ */
+static void test_boundary(const char *name, mul128_fn_t fn) {
+    printf("Running test: test_boundary (%s)\n", name);
+    bignum_t a;
+    memset(&a, 0, sizeof(a));
+    // Все единицы на all-ones множитель: ровно len + 2 слова
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t i = 0; i < len; ++i) a.words[i] = UINT64_MAX;
+        a.len = len;
+        check_one(fn, &a, UINT64_MAX, UINT64_MAX);
+        check_one(fn, &a, UINT64_MAX, 0);
+        check_one(fn, &a, 0, UINT64_MAX);
+        check_one(fn, &a, 1, 0);
+        check_one(fn, &a, 0, 1);
+        check_one(fn, &a, 2, 0);
+    }
+    // 2^t на 128-битный множитель: граница по обе стороны от 64 * CAPACITY бит
+    const size_t bits = 64 * (size_t)BIGNUM_CAPACITY;
+    for (size_t t = bits > 140 ? bits - 140 : 0; t < bits; ++t) {
+        memset(a.words, 0, sizeof(a.words));
+        a.words[t / 64] = (uint64_t)1 << (t % 64);
+        a.len = t / 64 + 1 + next_rand() % (BIGNUM_CAPACITY - t / 64);   // С нулями сверху
+        for (int rep = 0; rep < 8; ++rep) {
+            uint64_t b_lo = next_rand(), b_hi = next_rand() >> (next_rand() % 64);
+            if (rep == 0) b_hi = 0;
+            check_one(fn, &a, b_lo, b_hi);
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 3: NULL, нули, некорректная длина.
+ */
+static void test_special(const char *name, mul128_fn_t fn) {
+    printf("Running test: test_special (%s)\n", name);
+    bignum_t a, res;
+    memset(&a, 0, sizeof(a));
+    memset(&res, 0, sizeof(res));
+    a.words[0] = 5;
+    a.len = 1;
+    assert(fn(NULL, &a, 1, 1) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+    assert(fn(&res, NULL, 1, 1) == BIGNUM_MUL_U64_ERROR_NULL_ARG);
+
+    // b == 0 и a == 0 (len == 0 и нулевые слова) дают 0 с len = 1
+    poison(&res);
+    assert(fn(&res, &a, 0, 0) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+    bignum_t zero;
+    memset(&zero, 0, sizeof(zero));
+    poison(&res);
+    assert(fn(&res, &zero, 3, 4) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+    zero.len = BIGNUM_CAPACITY;
+    poison(&res);
+    assert(fn(&res, &zero, 3, 4) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 1 && res.words[0] == 0);
+
+    // Некорректная длина
+    bignum_t bad = a;
+    poison(&res);
+    bad.len = BIGNUM_CAPACITY + 1;
+    assert(fn(&res, &bad, 1, 1) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(res.len == 7);
+    memset(&bad.len, 0xFF, sizeof(bad.len));   // len < 0
+    assert(fn(&res, &bad, 1, 1) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(res.len == 7);
+    printf("...PASSED\n");
+}
+
+static void check_all(const char *name, mul128_fn_t fn) {
+    test_random(name, fn);
+    test_boundary(name, fn);
+    test_special(name, fn);
+}
+
+int main(void) {
+    printf("\n--- Starting tests for bignum_mul_u128 ---\n");
+    check_all("bignum_mul_u128", bignum_mul_u128);
+    check_all("bignum_mul_u128_generic", bignum_mul_u128_generic);
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        check_all("bignum_mul_u128_mulx", bignum_mul_u128_mulx);
+    } else {
+        printf("Skipping bignum_mul_u128_mulx: BMI2/ADX not supported\n");
+    }
+#else
+    printf("Skipping bignum_mul_u128_mulx: x86-64 only\n");
+#endif
+    printf("\n--- All tests for bignum_mul_u128 passed ---\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file    test_bignum_mul_u64_unchecked.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тесты bignum_mul_u64_unchecked.
+ *
+ * @details
+ *   Для всех допустимых длин (1..BIGNUM_CAPACITY) и набора множителей
+ *   проверяет совпадение с bignum_mul_u64 (кроме b == 0, где длина не
+ *   нормализуется), умножение "на месте" и переполнение с неизменной
+ *   длиной результата.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальное создание.
+ */
+
+#include "bignum_mul_u64.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+
+static uint64_t rng_state = 0xE7037ED1A0B428DBULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static int bignum_are_equal(const bignum_t* x, const bignum_t* y) {
+    if (x->len != y->len) return 0;
+    return memcmp(x->words, y->words, x->len * sizeof(uint64_t)) == 0;
+}
+
+static void fill_random(bignum_t *x, size_t len) {
+    memset(x, 0, sizeof(*x));
+    for (size_t i = 0; i < len; ++i) x->words[i] = next_rand();
+    x->len = len;
+}
+
+/**
+ * @brief Тест 1: Совпадение с bignum_mul_u64 на всех допустимых длинах.
+ */
+static void test_matches_checked(void) {
+    printf("Running test: test_matches_checked\n");
+    const uint64_t multipliers[] = {1, 2, 10, 0xFFFFFFFFULL, 1ULL << 63, UINT64_MAX, 0x123456789ABCDEF1ULL};
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t m = 0; m < sizeof(multipliers) / sizeof(multipliers[0]); ++m) {
+            bignum_t a, res, expected, inplace;
+            fill_random(&a, len);
+            memset(&res, 0, sizeof(res));
+            memset(&expected, 0, sizeof(expected));
+            bignum_mul_u64_status_t st_ref = bignum_mul_u64(&expected, &a, multipliers[m]);
+            bignum_mul_u64_status_t st = bignum_mul_u64_unchecked(&res, &a, multipliers[m]);
+            assert(st == st_ref);
+            if (st == BIGNUM_MUL_U64_SUCCESS) {
+                assert(bignum_are_equal(&res, &expected));
+            }
+
+            inplace = a;
+            st = bignum_mul_u64_unchecked(&inplace, &inplace, multipliers[m]);
+            assert(st == st_ref);
+            if (st == BIGNUM_MUL_U64_SUCCESS) {
+                assert(bignum_are_equal(&inplace, &expected));
+            }
+        }
+    }
+    printf("...PASSED\n");
+}
+
+/**
+ * @brief Тест 2: b == 0 без нормализации и переполнение.
+ */
+static void test_zero_and_overflow(void) {
+    printf("Running test: test_zero_and_overflow\n");
+    bignum_t a, res;
+    fill_random(&a, 3);
+    memset(res.words, 0xFF, sizeof(res.words));
+    res.len = 0;
+    assert(bignum_mul_u64_unchecked(&res, &a, 0) == BIGNUM_MUL_U64_SUCCESS);
+    assert(res.len == 3 && res.words[0] == 0 && res.words[1] == 0 && res.words[2] == 0);
+
+    memset(&a, 0, sizeof(a));
+    a.len = BIGNUM_CAPACITY;
+    a.words[BIGNUM_CAPACITY - 1] = UINT64_MAX;
+    memset(&res, 0, sizeof(res));
+    res.len = 7;
+    assert(bignum_mul_u64_unchecked(&res, &a, 2) == BIGNUM_MUL_U64_ERROR_OVERFLOW);
+    assert(res.len == 7);
+    printf("...PASSED\n");
+}
+
+int main(void) {
+    printf("\n--- Starting unchecked tests for bignum_mul_u64 ---\n");
+    test_matches_checked();
+    test_zero_and_overflow();
+    printf("\n--- All unchecked tests for bignum_mul_u64 passed ---\n");
+    return 0;
+}